@@ -24,4 +24,11 @@ tm_result_t tm_history_init(TmAppState *s);
  */
 tm_result_t tm_history_tick(TmAppState *s);
 
+/**
+ * Return the entry at list position @p index in O(1), or NULL.
+ * @param s      Application state. Must not be NULL.
+ * @param index  Row index, 0 .. history_count - 1.
+ */
+TmAppHistory *tm_history_at(const TmAppState *s, int index);
+
 #endif /* TM_APP_HISTORY_H */
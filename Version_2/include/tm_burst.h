@@ -0,0 +1,69 @@
+/**
+ * @file tm_burst.h
+ * @brief Public API for threshold-triggered burst sampling.
+ *
+ * While no trigger has fired the collector samples at its normal 1 s
+ * cadence. When one fires, the affected metrics are sampled every
+ * TmBurst.interval_s for TmBurst.window_s into a separate ring so short
+ * spikes are captured in detail.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_BURST_H
+#define TM_BURST_H
+
+#include "tm_types.h"
+
+/**
+ * Reset burst state and install the default triggers
+ * (system CPU above TM_BURST_CPU_PERCENT, RSS growth above
+ * TM_BURST_RSS_GROWTH_B within TM_BURST_RSS_WINDOW_S).
+ * @param b  Burst state. Must not be NULL.
+ */
+void tm_burst_init(TmBurst *b);
+
+/** Remove all triggers; bursts can then only be started manually. */
+void tm_burst_clear_triggers(TmBurst *b);
+
+/**
+ * Register an additional trigger.
+ * @param b  Burst state. Must not be NULL.
+ * @param t  Trigger definition.
+ * @return   TM_OK or TM_ERR_INVALID_ARG (table full or bad threshold).
+ */
+tm_result_t tm_burst_add_trigger(TmBurst *b, TmBurstTrigger t);
+
+/**
+ * Evaluate system-wide triggers against the latest perf sample.
+ * @param s  Application state. Must not be NULL.
+ */
+void tm_burst_check_system(TmAppState *s);
+
+/**
+ * Evaluate per-process triggers against the freshly refreshed list.
+ * @param s  Application state. Must not be NULL.
+ */
+void tm_burst_check_processes(TmAppState *s);
+
+/**
+ * Start (or extend) a capture window.
+ * @param s    Application state. Must not be NULL.
+ * @param pid  Process whose RSS is captured too, or 0 for system only.
+ */
+void tm_burst_start(TmAppState *s, uint32_t pid);
+
+/**
+ * Take a high-resolution sample if a burst is active and its interval
+ * has elapsed; ends the burst once its window is over. Call every frame.
+ * @param s  Application state. Must not be NULL.
+ * @return   TM_OK or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_burst_update(TmAppState *s);
+
+/**
+ * Return true while a burst is running or ended less than
+ * TM_BURST_HOLD_S ago, i.e. while its capture should be shown.
+ */
+bool tm_burst_has_capture(const TmBurst *b);
+
+#endif /* TM_BURST_H */
@@ -0,0 +1,84 @@
+/**
+ * @file tm_collector.h
+ * @brief Public API for the data collector -- decides what to sample and when.
+ *
+ * Each tab declares the data sets it consumes (TmTabDescriptor.data_needs);
+ * the collector gathers only those plus the always-on TM_DATA_BASELINE.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_COLLECTOR_H
+#define TM_COLLECTOR_H
+
+#include "tm_types.h"
+
+/**
+ * Reset the collection schedule. Timestamps start at "now" so the first
+ * periodic pass happens one interval after init.
+ * @param c  Collector state. Must not be NULL.
+ */
+void tm_collector_init(TmCollector *c);
+
+/**
+ * Declare the data sets the active view consumes. Sets that were not
+ * needed before are queued and gathered on the next tm_collector_update(),
+ * so the frame that switched tabs still renders the cached data.
+ * @param s      Application state. Must not be NULL.
+ * @param needs  TmDataSet mask; TM_DATA_BASELINE and pinned sets are
+ *               always added.
+ */
+void tm_collector_set_needs(TmAppState *s, uint32_t needs);
+
+/**
+ * Keep @p sets gathered on every tab from now on, as the baseline is.
+ * Exporters call this so their data never goes stale behind the UI.
+ * @param s     Application state. Must not be NULL.
+ * @param sets  TmDataSet mask.
+ */
+void tm_collector_pin(TmAppState *s, uint32_t sets);
+
+/**
+ * Publish the process rows currently on screen. Detail columns are
+ * fetched for this range plus TM_DETAIL_PREFETCH_ROWS on either side;
+ * rows that scroll into view without cached detail are filled next update.
+ * @param s      Application state. Must not be NULL.
+ * @param first  Index of the first visible row.
+ * @param count  Number of visible rows.
+ */
+void tm_collector_set_viewport(TmAppState *s, int first, int count);
+
+/**
+ * Gather the given data sets immediately and reset their timers.
+ * @param s     Application state. Must not be NULL.
+ * @param sets  TmDataSet mask.
+ * @return      TM_OK or the first failing subsystem's error code.
+ */
+tm_result_t tm_collector_collect(TmAppState *s, uint32_t sets);
+
+/**
+ * Start the first process gather on a worker thread and return at once,
+ * so the first frame does not wait for the OS process table. Until
+ * tm_collector_update() adopts the result, the collector samples nothing
+ * and tm_collector_collect() only queues its sets. Without threads this
+ * falls back to a synchronous tm_collector_collect().
+ * @param s  Application state. Must not be NULL.
+ * @return   TM_OK or the fallback collection's error code.
+ */
+tm_result_t tm_collector_prime(TmAppState *s);
+
+/**
+ * Wait for a first gather that is still running and discard it.
+ * @param s  Application state. Must not be NULL.
+ */
+void tm_collector_shutdown(TmAppState *s);
+
+/**
+ * Gather every needed data set whose interval has elapsed, plus any
+ * sets queued by tm_collector_set_needs(). Call once per frame. Adopts
+ * the first gather started by tm_collector_prime() once it is done.
+ * @param s  Application state. Must not be NULL.
+ * @return   TM_OK or the first failing subsystem's error code.
+ */
+tm_result_t tm_collector_update(TmAppState *s);
+
+#endif /* TM_COLLECTOR_H */
@@ -0,0 +1,61 @@
+/**
+ * @file tm_event.h
+ * @brief Public API for the typed, coalescing event bus.
+ *
+ * Publishers OR event bits into each interested subscriber's pending
+ * mask; a burst of publications between two deliveries collapses into a
+ * single TmEvent. UI subscribers are delivered from tm_event_dispatch()
+ * once per frame; thread subscribers get their own worker so a slow
+ * consumer never blocks the publisher.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_EVENT_H
+#define TM_EVENT_H
+
+#include "tm_types.h"
+
+/**
+ * Create the bus lock. Call once before any other tm_event_* function.
+ * @return TM_OK or TM_ERR_ALLOC.
+ */
+tm_result_t tm_event_init(void);
+
+/**
+ * Register a subscriber. There is no fixed limit on the number of
+ * subscribers. Call from the UI thread, outside any callback.
+ * @param types   TmEventType mask the subscriber is interested in.
+ * @param mode    TM_DISPATCH_UI or TM_DISPATCH_THREAD.
+ * @param fn      Callback; must not be NULL.
+ * @param user    Opaque pointer passed to @p fn.
+ * @param out_id  Optional out: id for tm_event_unsubscribe().
+ * @return        TM_OK, TM_ERR_INVALID_ARG, TM_ERR_ALLOC or TM_ERR_PLATFORM.
+ */
+tm_result_t tm_event_subscribe(uint32_t types, TmDispatchMode mode,
+                               TmEventFn fn, void *user, int *out_id);
+
+/**
+ * Remove a subscriber. A thread subscriber's worker finishes its current
+ * callback and is joined before this returns. Undelivered events are dropped.
+ * @return TM_OK or TM_ERR_INVALID_ARG if @p id is unknown.
+ */
+tm_result_t tm_event_unsubscribe(int id);
+
+/**
+ * Publish @p types to every matching subscriber. Never blocks on a
+ * subscriber; safe to call from any thread.
+ * @param types  TmEventType bits.
+ */
+void tm_event_publish(uint32_t types);
+
+/**
+ * Deliver pending events to UI subscribers. Call once per frame on the
+ * UI thread.
+ * @param s  Application state handed to the callbacks. Must not be NULL.
+ */
+void tm_event_dispatch(const TmAppState *s);
+
+/** Stop all worker threads and release every subscriber. */
+void tm_event_shutdown(void);
+
+#endif /* TM_EVENT_H */
@@ -0,0 +1,102 @@
+/**
+ * @file tm_export.h
+ * @brief Snapshot serialisation for headless mode (JSON Lines / CSV).
+ *
+ * Records are formatted straight into the TmWriter's fixed buffer -- no
+ * heap, no printf -- and handed to stdio in TM_EXPORT_BUF_BYTES blocks.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_EXPORT_H
+#define TM_EXPORT_H
+
+#include "tm_types.h"
+
+/* -------------------------------------------------------------------------
+ * Writer
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Bind @p w to an open stream with an empty buffer.
+ * @param w   Writer. Must not be NULL.
+ * @param fp  Destination stream; stays owned by the caller.
+ */
+void tm_writer_init(TmWriter *w, FILE *fp);
+
+/**
+ * Bind @p w to a memory sink and empty it. @p out keeps its capacity, so
+ * refilling it with a body no larger than before does not allocate.
+ * @param w    Writer. Must not be NULL.
+ * @param out  Destination buffer; stays owned by the caller.
+ */
+void tm_writer_init_mem(TmWriter *w, TmByteBuf *out);
+
+/**
+ * Hand the buffered bytes to the stream (fflush()ing it) or memory sink.
+ * @param w  Writer. Must not be NULL.
+ * @return   TM_OK, or TM_ERR_IO once any write came up short.
+ */
+tm_result_t tm_writer_flush(TmWriter *w);
+
+/** Append @p n raw bytes. */
+void tm_writer_bytes(TmWriter *w, const char *p, size_t n);
+
+/** Append a NUL-terminated string verbatim. */
+void tm_writer_str(TmWriter *w, const char *str);
+
+/** Append an unsigned decimal integer. */
+void tm_writer_u64(TmWriter *w, uint64_t v);
+
+/**
+ * Append @p v in fixed-point notation, rounded half away from zero.
+ * @param decimals  Digits after the point, 0-6.
+ */
+void tm_writer_fixed(TmWriter *w, double v, int decimals);
+
+/** Append @p str as a quoted JSON string, escaping as RFC 8259 requires. */
+void tm_writer_json_str(TmWriter *w, const char *str);
+
+/** Append @p str as a CSV cell, quoted only when RFC 4180 requires it. */
+void tm_writer_csv_str(TmWriter *w, const char *str);
+
+/* -------------------------------------------------------------------------
+ * Snapshots
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Parse a comma-separated field list such as "pid,name,cpu".
+ * @param list  Field names (see tm_export_field_name()); "all" selects all.
+ * @param out   Receives the TmExportConfig.fields mask.
+ * @return      TM_OK, or TM_ERR_INVALID_ARG naming the bad field in the log.
+ */
+tm_result_t tm_export_parse_fields(const char *list, uint32_t *out);
+
+/** Column name of @p f as written in headers and JSON keys. */
+const char *tm_export_field_name(TmExportField f);
+
+/**
+ * Data sets the collector must gather to fill @p fields.
+ * @return TmDataSet mask.
+ */
+uint32_t tm_export_data_sets(uint32_t fields);
+
+/**
+ * Write the CSV header row; no-op for JSON Lines.
+ * @param w    Writer. Must not be NULL.
+ * @param cfg  Output format and fields.
+ */
+void tm_export_header(TmWriter *w, const TmExportConfig *cfg);
+
+/**
+ * Write one snapshot: a "system" record if any system field is selected,
+ * then a "process" record per process if any process field is.
+ * @param w      Writer. Must not be NULL.
+ * @param cfg    Output format and fields.
+ * @param s      Application state after a collection pass.
+ * @param ts_ms  Snapshot time, Unix epoch milliseconds.
+ * @return       Number of records written.
+ */
+int tm_export_snapshot(TmWriter *w, const TmExportConfig *cfg,
+                       const TmAppState *s, uint64_t ts_ms);
+
+#endif /* TM_EXPORT_H */
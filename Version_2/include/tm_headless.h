@@ -0,0 +1,36 @@
+/**
+ * @file tm_headless.h
+ * @brief Headless collector: sampler loop streaming snapshots, no window.
+ *
+ * Built into both executables: task_manager runs it for --headless, and
+ * task_manager_headless (no Raylib) runs nothing else.
+ */
+
+#ifndef TM_HEADLESS_H
+#define TM_HEADLESS_H
+
+#include "tm_types.h"
+
+/**
+ * True if the command line asks for headless mode (--headless).
+ * @param argc  As passed to main().
+ * @param argv  As passed to main().
+ */
+bool tm_headless_requested(int argc, char **argv);
+
+/**
+ * Parse options, then sample and stream snapshots until the requested
+ * count is reached or SIGINT / SIGTERM arrives. g_platform must be set.
+ *
+ * Options: --format jsonl|csv|tmrec, --interval SECONDS, --fields LIST,
+ * --output PATH, --count N. Logging goes to stderr so stdout carries
+ * only records.
+ *
+ * @param argc  As passed to main().
+ * @param argv  As passed to main().
+ * @return      Process exit status: 0 on success, 1 on I/O failure,
+ *              2 on a usage error.
+ */
+int tm_headless_run(int argc, char **argv);
+
+#endif /* TM_HEADLESS_H */
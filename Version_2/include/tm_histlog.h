@@ -0,0 +1,79 @@
+/**
+ * @file tm_histlog.h
+ * @brief Persistent history: a segmented on-disk log of samples and the
+ *        `task_manager query` command that reads it back.
+ *
+ * Each segment is a tmrec recording (see tm_record.h) named after its
+ * first sample, so the directory listing is a sparse index over time and
+ * every segment carries its own frame index. The sampler only encodes a
+ * frame into memory; a writer thread appends the queued frames and
+ * fsyncs once per batch.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_HISTLOG_H
+#define TM_HISTLOG_H
+
+#include "tm_types.h"
+
+/* -------------------------------------------------------------------------
+ * Writer
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Read `--history-dir DIR` and `--history-max-mb MB` from the command line.
+ * @param dir     Receives DIR, or NULL if --history-dir is absent.
+ * @param max_mb  Receives MB, or TM_HISTLOG_DEFAULT_MAX_MB.
+ * @return        false if --history-max-mb is not a positive number.
+ */
+bool tm_histlog_parse_args(int argc, char **argv, const char **dir, int *max_mb);
+
+/**
+ * Create @p dir if needed and start the writer thread. Segments from
+ * earlier runs are kept; the oldest are deleted once all of them together
+ * exceed @p max_mb.
+ * @return TM_OK, TM_ERR_INVALID_ARG, TM_ERR_IO or TM_ERR_PLATFORM.
+ */
+tm_result_t tm_histlog_open(const char *dir, int max_mb);
+
+/**
+ * Queue the process table and system totals of @p s as one sample. Never
+ * waits for the disk: if the writer is more than TM_HISTLOG_QUEUE_MAX
+ * bytes behind, the sample is skipped. No-op if the log is not open.
+ * @param s      Application state after a pass that gathered TM_DATA_EXPORTED.
+ * @param ts_ms  Sample time, Unix epoch milliseconds (non-decreasing).
+ */
+void tm_histlog_append(const TmAppState *s, uint64_t ts_ms);
+
+/** Finish the open segment, write everything queued and stop the writer. */
+void tm_histlog_close(void);
+
+/* -------------------------------------------------------------------------
+ * Segments
+ * ---------------------------------------------------------------------- */
+
+/**
+ * List the segments in @p dir, oldest first.
+ * @param out  Receives a malloc'd array (NULL if empty); caller frees.
+ * @return     Segment count, or -1 if @p dir cannot be read.
+ */
+int tm_histlog_segments(const char *dir, TmHistSegment **out);
+
+/** Path of the segment starting at @p start_ms. */
+void tm_histlog_segment_path(const char *dir, uint64_t start_ms, char *out, size_t cap);
+
+/* -------------------------------------------------------------------------
+ * Query command
+ * ---------------------------------------------------------------------- */
+
+/** True if argv[1] is the `query` subcommand. */
+bool tm_histquery_requested(int argc, char **argv);
+
+/**
+ * Run `task_manager query`: aggregate the samples between --from and --to
+ * per process and print the top rows.
+ * @return Process exit status (0 ok, 1 no data / unreadable, 2 usage).
+ */
+int tm_histquery_run(int argc, char **argv);
+
+#endif /* TM_HISTLOG_H */
@@ -21,6 +21,11 @@ typedef enum {
  */
 void tm_log(TmLogLevel level, const char *fmt, ...);
 
+/**
+ * Send every level to stderr, e.g. when stdout carries data records.
+ */
+void tm_log_use_stderr(void);
+
 /* Convenience macros */
 #define tm_log_debug(...)  tm_log(TM_LOG_DEBUG, __VA_ARGS__)
 #define tm_log_info(...)   tm_log(TM_LOG_INFO,  __VA_ARGS__)
@@ -0,0 +1,42 @@
+/**
+ * @file tm_metrics.h
+ * @brief OpenMetrics endpoint: serves the latest snapshot on localhost.
+ *
+ * The sampler renders each snapshot into one of two reusable buffers and
+ * flips it to the front; a server thread answers `GET /metrics` from the
+ * front buffer. Scrapes never allocate, format or take the sampler's
+ * time, and a slow client only delays the flip it is holding up.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_METRICS_H
+#define TM_METRICS_H
+
+#include "tm_types.h"
+
+/**
+ * Value of `--metrics-port PORT` on the command line.
+ * @return The port; 0 if the option is absent; -1 if it is not 1-65535.
+ */
+int tm_metrics_port_arg(int argc, char **argv);
+
+/**
+ * Listen on 127.0.0.1:@p port and start the server thread. Until the first
+ * tm_metrics_publish() scrapes get 503.
+ * @param port  TCP port, 1-65535.
+ * @return      TM_OK, TM_ERR_INVALID_ARG, TM_ERR_PLATFORM or TM_ERR_ALLOC.
+ */
+tm_result_t tm_metrics_start(int port);
+
+/**
+ * Render system and per-process metrics from @p s into the back buffer
+ * and make it the one scrapes see. Call after each collection pass that
+ * gathered TM_DATA_EXPORTED. No-op if the endpoint is not running.
+ * @param s  Application state. Must not be NULL.
+ */
+void tm_metrics_publish(const TmAppState *s);
+
+/** Stop the server thread, close the socket and free both buffers. */
+void tm_metrics_stop(void);
+
+#endif /* TM_METRICS_H */
@@ -12,21 +12,23 @@
 
 /**
  * Zero-initialise performance data and set fixed totals.
- * Must be called once before the first tm_perf_update().
+ * Must be called once before the first tm_perf_sample().
  * @param d  Performance data struct. Must not be NULL.
  */
 void tm_perf_data_init(TmPerfData *d);
 
 /**
- * Sample all metrics (CPU, memory, disk, GPU) if the update interval
- * has elapsed. Internally throttled to TM_PERF_UPDATE_INTERVAL_S.
- * @param s  Application state. Must not be NULL.
- * @return   TM_OK or TM_ERR_INVALID_ARG.
+ * Sample the requested metric groups immediately. Not throttled --
+ * scheduling is owned by the collector (see tm_collector.h).
+ * @param s     Application state. Must not be NULL.
+ * @param sets  TmDataSet mask; TM_DATA_SYSTEM samples CPU + memory,
+ *              TM_DATA_PERF_DETAIL samples disk, GPU and threads.
+ * @return      TM_OK or TM_ERR_INVALID_ARG.
  */
-tm_result_t tm_perf_update(TmAppState *s);
+tm_result_t tm_perf_sample(TmAppState *s, uint32_t sets);
 
 /**
- * Return elapsed seconds since the last performance update.
+ * Return elapsed seconds since the last system sample.
  * @param d  Performance data struct. Must not be NULL.
  */
 float tm_perf_delta_seconds(const TmPerfData *d);
@@ -13,35 +13,315 @@
 #include <stdio.h>
 #include "tm_types.h"
 
+/** Opaque handles owned by the platform adapter. */
+typedef struct TmProcessList TmProcessList;
+typedef struct TmPoller TmPoller;
+typedef struct TmThread TmThread;
+typedef struct TmMutex  TmMutex;
+typedef struct TmCond   TmCond;
+
+/** Entry point of a thread started with TmPlatform.thread_start(). */
+typedef void (*TmThreadFn)(void *arg);
+
+/** Called by TmPlatform.list_dir() for each regular file. */
+typedef void (*TmDirEntryFn)(const char *name, uint64_t bytes, void *user);
+
+/** Readiness bits for TmPoller. */
+#define TM_POLL_IN   1u     /**< Readable, or a connection to accept */
+#define TM_POLL_OUT  2u     /**< Writable again after a short send */
+#define TM_POLL_HUP  4u     /**< Peer closed or socket error */
+
+/** One ready socket from TmPlatform.poller_wait(). */
+typedef struct {
+    void     *user;         /**< As passed to poller_watch() */
+    uint32_t  events;       /**< TM_POLL_* bits */
+} TmPollEvent;
+
 /**
  * OS-abstraction vtable.  One instance is selected at startup in main.c
- * and exposed via g_platform.
+ * and exposed via g_platform. Every entry may be called from any thread
+ * (the first process gather runs on a worker while the UI thread carries
+ * on); an adapter with shared state serialises its own calls.
  */
 typedef struct {
-    /** Open the OS process list and return a FILE* for line-by-line reading. */
-    FILE *(*open_process_list)(void);
+    /** Open the OS process list for entry-by-entry reading; NULL on failure. */
+    TmProcessList *(*open_process_list)(void);
 
     /**
-     * Parse the next line from @p fp into @p out.
-     * @return true if a valid entry was read; false at EOF or on error.
+     * Parse the next entry from @p list into @p out.
+     * @return true if a valid entry was read; false at the end or on error.
      */
-    bool (*parse_process_line)(FILE *fp, TmProcess *out);
+    bool (*parse_process_line)(TmProcessList *list, TmProcess *out);
+
+    /**
+     * Release a handle from open_process_list(). Adapters may hold a lock
+     * from open to close, so nothing else may call into the adapter from
+     * the same thread while a list is open.
+     */
+    void (*close_process_list)(TmProcessList *list);
 
     /** Terminate process @p pid. Returns TM_OK or TM_ERR_PLATFORM. */
     tm_result_t (*kill_process)(uint32_t pid);
 
-    /** Sample current overall CPU usage, 0–100. */
-    float (*sample_cpu)(void);
+    /**
+     * Sample overall CPU usage (0–100) since the caller's previous call;
+     * a first call reports the average since boot where the OS keeps one.
+     * @param prev  The caller's own baseline, updated in place; callers
+     *              with different cadences keep separate ones.
+     */
+    float (*sample_cpu)(TmCpuTicks *prev);
+
+    /** Number of online logical CPUs, at least 1. */
+    int (*cpu_count)(void);
+
+    /**
+     * Sample per-core CPU usage (0–100) since the caller's previous call.
+     * @param prev  The caller's baselines, one per core (@p max entries).
+     * @param out   Receives one value per core.
+     * @param max   Capacity of @p prev and @p out.
+     * @return Number of cores written; 0 if unsupported.
+     */
+    int (*sample_cpu_cores)(TmCpuTicks *prev, float *out, int max);
 
-    /** Fill @p used_kb and @p total_kb with current physical memory figures. */
+    /**
+     * Fill @p used_kb and @p total_kb with current physical memory figures;
+     * both 0 when the adapter cannot read them.
+     */
     void (*query_memory)(uint64_t *used_kb, uint64_t *total_kb);
+
+    /**
+     * Fill @p out with the costly per-process columns (PSS, fds, I/O, cmdline).
+     * @return true on success; false if the process is gone or unsupported.
+     */
+    bool (*query_process_detail)(uint32_t pid, TmProcessDetail *out);
+
+    /** Read the resident set size of @p pid in bytes. false if gone. */
+    bool (*query_process_rss)(uint32_t pid, uint64_t *rss_bytes);
+
+    /** Monotonic wall-clock time in seconds (arbitrary epoch). */
+    double (*now_s)(void);
+
+    /**
+     * Wall-clock time of the data source in Unix epoch milliseconds: the
+     * host's clock, or the recording's time under replay. Pair one reading
+     * with now_s() to stamp records without following clock steps.
+     */
+    uint64_t (*epoch_ms)(void);
+
+    /**
+     * Block the calling thread for @p seconds (no-op if <= 0). May return
+     * early when a signal is delivered.
+     */
+    void (*sleep_s)(double seconds);
+
+    /**
+     * Open a cheap sampling handle for @p pid that keeps its OS files
+     * open between reads. @return handle >= 0, or -1 on failure.
+     */
+    int (*open_process_sampler)(uint32_t pid);
+
+    /** Read one sample through @p handle. false once the process is gone. */
+    bool (*read_process_sample)(int handle, TmProcSample *out);
+
+    /** Release a handle from open_process_sampler(). */
+    void (*close_process_sampler)(int handle);
+
+    /**
+     * Map @p path read-only into memory.
+     * @param size  Receives the file length in bytes.
+     * @return Base address, or NULL if missing, empty or unmappable.
+     */
+    const void *(*map_file)(const char *path, size_t *size);
+
+    /** Release a mapping from map_file(), shm_create() or shm_map(). */
+    void (*unmap_file)(const void *base, size_t size);
+
+    /** Create directory @p path (owner-only). @return true if it exists now. */
+    bool (*make_dir)(const char *path);
+
+    /**
+     * Call @p fn for every regular file in directory @p path, in no
+     * particular order.
+     * @return Files visited, or -1 if the directory cannot be read.
+     */
+    int (*list_dir)(const char *path, TmDirEntryFn fn, void *user);
+
+    /** Flush @p fp and wait until its data is on stable storage. */
+    bool (*sync_file)(FILE *fp);
+
+    /**
+     * Create the named shared-memory segment @p name ("/tm_x") with
+     * @p size zeroed bytes and map it read-write. A segment left under
+     * that name is replaced, never truncated: readers still mapping it
+     * keep a valid (stale) view and must reopen to see the new one.
+     * @return Base address, or NULL on failure.
+     */
+    void *(*shm_create)(const char *name, size_t size);
+
+    /**
+     * Map an existing shared-memory segment read-only.
+     * @param size  Receives the segment length in bytes.
+     * @return Base address, or NULL if it does not exist.
+     */
+    const void *(*shm_map)(const char *name, size_t *size);
+
+    /** Remove @p name; existing mappings stay valid until unmapped. */
+    void (*shm_unlink)(const char *name);
+
+    /**
+     * Listen for TCP connections on 127.0.0.1:@p port (loopback only).
+     * @return Listening socket handle >= 0, or -1 on failure.
+     */
+    int (*tcp_listen)(int port);
+
+    /**
+     * Wait up to @p timeout_s for a connection on @p listener.
+     * @return Connected socket handle >= 0, or -1 on timeout or error.
+     */
+    int (*sock_accept)(int listener, double timeout_s);
+
+    /**
+     * Receive up to @p n bytes, waiting at most @p timeout_s for data.
+     * @return Bytes read; 0 on orderly close; -1 on timeout or error.
+     */
+    long (*sock_recv)(int sock, void *buf, size_t n, double timeout_s);
+
+    /**
+     * Send all @p n bytes, giving up after @p timeout_s in total so a
+     * peer that stops reading cannot hold the caller.
+     * @return false if the peer went away or the time ran out.
+     */
+    bool (*sock_send)(int sock, const void *buf, size_t n, double timeout_s);
+
+    /** Close a handle from tcp_listen(), uds_listen() or sock_accept(). */
+    void (*sock_close)(int sock);
+
+    /**
+     * Listen on a Unix domain socket at @p path, replacing a stale socket;
+     * any other file already at @p path is left alone and is a failure.
+     * The socket is non-blocking and only its owner may connect.
+     * @return Listening socket handle >= 0, or -1 on failure / unsupported.
+     */
+    int (*uds_listen)(const char *path);
+
+    /**
+     * Send as much of @p buf as fits without blocking.
+     * @return Bytes sent (0 if the socket buffer is full), or -1 on error.
+     */
+    long (*sock_send_some)(int sock, const void *buf, size_t n);
+
+    /** Delete the file (or socket) at @p path. */
+    bool (*remove_file)(const char *path);
+
+    /** Create a readiness poller (epoll where available). NULL if unsupported. */
+    TmPoller *(*poller_create)(void);
+
+    /** Release a poller; its sockets stay open. */
+    void (*poller_destroy)(TmPoller *p);
+
+    /**
+     * Watch @p sock for @p events (TM_POLL_IN / TM_POLL_OUT), replacing any
+     * previous interest. Errors and hang-ups are always reported.
+     * @return false on failure.
+     */
+    bool (*poller_watch)(TmPoller *p, int sock, uint32_t events, void *user);
+
+    /** Stop watching @p sock. Call before closing it. */
+    void (*poller_forget)(TmPoller *p, int sock);
+
+    /**
+     * Wait up to @p timeout_s for ready sockets or poller_wake().
+     * @return Number of events written to @p out (0 on timeout or wake).
+     */
+    int (*poller_wait)(TmPoller *p, TmPollEvent *out, int max, double timeout_s);
+
+    /** Make a concurrent poller_wait() return now; callable from any thread. */
+    void (*poller_wake)(TmPoller *p);
+
+    /**
+     * True once a finite data source (a replayed recording) has served
+     * its last sample. Live adapters always return false.
+     */
+    bool (*is_exhausted)(void);
+
+    /** Start a thread running fn(arg). @return handle, or NULL on failure. */
+    TmThread *(*thread_start)(TmThreadFn fn, void *arg);
+
+    /** Wait for @p t to return and release its handle. */
+    void (*thread_join)(TmThread *t);
+
+    /** Create / destroy / lock / unlock a non-recursive mutex. */
+    TmMutex *(*mutex_create)(void);
+    void     (*mutex_destroy)(TmMutex *m);
+    void     (*mutex_lock)(TmMutex *m);
+    void     (*mutex_unlock)(TmMutex *m);
+
+    /** Create / destroy a condition variable. */
+    TmCond *(*cond_create)(void);
+    void    (*cond_destroy)(TmCond *c);
+
+    /** Atomically release @p m and wait on @p c; @p m is held on return. */
+    void (*cond_wait)(TmCond *c, TmMutex *m);
+
+    /** Wake every thread waiting on @p c. */
+    void (*cond_broadcast)(TmCond *c);
+
+    /**
+     * Read the aligned 64-bit word at @p p in one access, with acquire
+     * ordering. Never writes, so @p p may lie in a read-only mapping.
+     */
+    uint64_t (*atomic_load_u64)(const uint64_t *p);
+
+    /** Write @p v to the aligned 64-bit word at @p p in one access, with release ordering. */
+    void (*atomic_store_u64)(uint64_t *p, uint64_t v);
+
+    /** Full memory barrier. */
+    void (*memory_fence)(void);
 } TmPlatform;
 
 /** Pointer set once in main() before any other call. Never NULL at runtime. */
 extern const TmPlatform *g_platform;
 
-/* Declarations for the two concrete adapters */
+/* Declarations for the concrete adapters */
 extern const TmPlatform k_platform_posix;
 extern const TmPlatform k_platform_win32;
 
+/**
+ * Load a recording and build the replay adapter: a copy of @p host whose
+ * data-source entries serve the recording on a virtual clock.
+ * @param host   Live adapter for threads, locks, sockets and mapping.
+ * @param path   Recording written with --format tmrec.
+ * @param speed  Real-time multiple (1 = as recorded); 0 = as fast as
+ *               possible (sleep_s() advances the clock and only yields).
+ *               Once the last frame is served sleep_s() blocks for real.
+ * @param out    Receives the adapter to install in g_platform.
+ * @return       TM_OK, TM_ERR_INVALID_ARG, TM_ERR_IO or TM_ERR_PLATFORM.
+ */
+tm_result_t tm_platform_replay_open(const TmPlatform *host, const char *path,
+                                    double speed, const TmPlatform **out);
+
+/**
+ * Generate a population and build the synthetic adapter: a copy of
+ * @p host whose process lists and system figures come from the model.
+ * @param host  Live adapter for the clock, threads, locks, sockets and
+ *              mapping.
+ * @param cfg   Population model; copied.
+ * @param out   Receives the adapter to install in g_platform.
+ * @return      TM_OK, TM_ERR_INVALID_ARG, TM_ERR_ALLOC or TM_ERR_PLATFORM.
+ */
+tm_result_t tm_platform_synthetic_open(const TmPlatform *host, const TmSynthConfig *cfg,
+                                       const TmPlatform **out);
+
+/**
+ * Pick the adapter requested on the command line: `--replay PATH`
+ * (with optional `--speed N|max`) selects the replay adapter,
+ * `--synthetic N` (with the model options) the synthetic one;
+ * otherwise @p host is returned.
+ * @return The adapter to install in g_platform, or NULL on a bad option.
+ */
+const TmPlatform *tm_platform_from_args(const TmPlatform *host, int argc, char **argv);
+
+/** True if @p opt is one of the adapter options (each takes one value). */
+bool tm_platform_is_adapter_option(const char *opt);
+
 #endif /* TM_PLATFORM_H */
@@ -17,12 +17,68 @@
 void tm_process_list_free(TmAppState *s);
 
 /**
- * Refresh the process list from the OS and notify observers.
+ * Refresh the process list from the OS and publish
+ * TM_EVENT_PROCESSES_CHANGED.
+ * The selected process stays selected if its PID still exists.
  * @param s  Application state. Must not be NULL.
  * @return   TM_OK, TM_ERR_IO, TM_ERR_ALLOC, or TM_ERR_INVALID_ARG.
  */
 tm_result_t tm_process_list_refresh(TmAppState *s);
 
+/**
+ * Read the OS process table into a new list without touching any app
+ * state, so it may run on a worker thread while the UI shows older rows.
+ * @param list   Receives the nodes (newest-first); pass to
+ *               tm_process_list_adopt() or tm_process_nodes_free().
+ * @param count  Receives the node count.
+ * @return       TM_OK, TM_ERR_IO, TM_ERR_ALLOC, or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_process_list_gather(TmProcess **list, int *count);
+
+/**
+ * Replace the process list with a gathered one as tm_process_list_refresh()
+ * does: cached details and history carry over by PID, one history sample
+ * is pushed and TM_EVENT_PROCESSES_CHANGED is published.
+ * @param s      Application state. Must not be NULL.
+ * @param list   Nodes from tm_process_list_gather(); ownership passes here.
+ * @param count  Number of nodes in @p list.
+ * @return       TM_OK, TM_ERR_ALLOC, or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_process_list_adopt(TmAppState *s, TmProcess *list, int count);
+
+/**
+ * Install previously saved rows as they are: nothing carries over, no
+ * history sample is pushed and no event is published.
+ * @param s      Application state. Must not be NULL.
+ * @param list   Malloc'd nodes; ownership passes here.
+ * @param count  Number of nodes in @p list.
+ * @param seq    Refresh number the rows' history rings were written at.
+ * @return       TM_OK, TM_ERR_ALLOC, or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_process_list_restore(TmAppState *s, TmProcess *list, int count,
+                                    uint32_t seq);
+
+/** Free a node list that was never adopted. */
+void tm_process_nodes_free(TmProcess *list);
+
+/**
+ * Copy the rows of @p src into @p v, in list order, so another thread can
+ * read them while @p src moves on. The buffers are kept between calls and
+ * only grow, so a table no larger than before costs one memcpy.
+ * @return TM_OK, TM_ERR_ALLOC (@p v keeps its old rows) or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_process_view_copy(TmProcessView *v, const TmAppState *src);
+
+/**
+ * Point the list, index, count and sequence of @p s at the rows of @p v.
+ * @p s then reads like a live state but owns nothing; never pass it to
+ * tm_process_list_free().
+ */
+void tm_process_view_attach(const TmProcessView *v, TmAppState *s);
+
+/** Release the buffers of @p v. */
+void tm_process_view_free(TmProcessView *v);
+
 /**
  * Terminate the process with the given PID.
  * @param pid  Process ID to kill.
@@ -31,17 +87,37 @@ tm_result_t tm_process_list_refresh(TmAppState *s);
 tm_result_t tm_process_kill(uint32_t pid);
 
 /**
- * Return a pointer to the currently selected process, or NULL.
- * @param s  Application state. Must not be NULL.
+ * Fetch the costly detail columns for rows [first, first + count) and the
+ * selected row. Rows outside that range keep whatever was cached.
+ * @param s             Application state. Must not be NULL.
+ * @param first         First row index; clamped to 0.
+ * @param count         Number of rows.
+ * @param only_missing  Skip rows that already hold valid detail.
+ * @return              TM_OK or TM_ERR_INVALID_ARG.
  */
-TmProcess *tm_process_get_selected(const TmAppState *s);
+tm_result_t tm_process_fetch_details(TmAppState *s, int first, int count,
+                                     bool only_missing);
+
+/**
+ * Return the process at list position @p index in O(1), or NULL if out
+ * of range.
+ * @param s      Application state. Must not be NULL.
+ * @param index  Row index, 0 .. process_count - 1.
+ */
+TmProcess *tm_process_at(const TmAppState *s, int index);
 
 /**
- * Register an observer callback fired after each list refresh.
- * @param fn    Callback; must not be NULL.
- * @param user  Opaque user data passed to the callback.
- * @return      TM_OK or TM_ERR_INVALID_ARG (too many observers or NULL fn).
+ * CPU usage of @p p at refresh number @p seq (see TmAppState.process_seq).
+ * @param out  Receives the value.
+ * @return false when @p seq is older than the ring or than the process.
  */
-tm_result_t tm_process_observer_add(TmProcessChangedFn fn, void *user);
+bool tm_process_history_cpu(const TmAppState *s, const TmProcess *p,
+                            uint32_t seq, float *out);
+
+/**
+ * Return a pointer to the currently selected process, or NULL.
+ * @param s  Application state. Must not be NULL.
+ */
+TmProcess *tm_process_get_selected(const TmAppState *s);
 
 #endif /* TM_PROCESS_H */
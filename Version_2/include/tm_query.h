@@ -0,0 +1,67 @@
+/**
+ * @file tm_query.h
+ * @brief Query socket: request/response and delta subscriptions over a
+ *        Unix domain socket.
+ *
+ * The sampler hands each refresh to the server as a PID-sorted row copy;
+ * one poller thread serves every client from those copies and never
+ * touches TmAppState. Requests are text lines, replies are JSON lines:
+ *
+ *     top N [cpu|mem]   {"type":"top","seq":S,"by":"mem","rows":[ROW,...]}
+ *     pid PID           {"type":"pid","seq":S,"row":ROW + pss_kb, io_bytes,
+ *                        fd_count, cmdline}
+ *     system            {"type":"system","seq":S,"cpu":..,"mem_used_kb":..,
+ *                        "mem_total_kb":..,"processes":N}
+ *     subscribe         {"type":"snapshot","seq":S,"rows":[ROW,...]}, then
+ *                       after every refresh
+ *                       {"type":"delta","seq":S,"added":[ROW,...],
+ *                        "removed":[PID,...],"changed":[{"pid":P,...},...]}
+ *     unsubscribe       {"type":"ok"}
+ *
+ * ROW is {"pid":P,"name":"..","cpu":1.5,"mem_kb":K}; a changed entry holds
+ * only the fields that differ from the previous refresh. A `pid` reply
+ * waits for the next refresh, which fetches its extra columns, so it may
+ * follow replies to later requests. Problems answer
+ * {"type":"error","error":".."}.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_QUERY_H
+#define TM_QUERY_H
+
+#include "tm_types.h"
+
+/**
+ * Value of `--query-socket PATH` on the command line.
+ * @return PATH, or NULL if the option is absent.
+ */
+const char *tm_query_socket_arg(int argc, char **argv);
+
+/**
+ * Listen on @p path and start the server thread. Until the first
+ * tm_query_publish() queries answer with an error and subscribers wait.
+ * @param path  Socket path; a stale socket there is replaced.
+ * @return      TM_OK, TM_ERR_INVALID_ARG, TM_ERR_PLATFORM or TM_ERR_ALLOC.
+ */
+tm_result_t tm_query_start(const char *path);
+
+/**
+ * Copy the process table and system totals of @p s for the server and
+ * wake it to answer subscribers. Call after each collection pass that
+ * gathered TM_DATA_EXPORTED; any thread will do, one at a time. No-op if
+ * the server is not running.
+ * @param s  Application state. Must not be NULL.
+ */
+void tm_query_publish(const TmAppState *s);
+
+/**
+ * Fetch the extra columns of queued `pid` requests from the platform
+ * adapter and wake the server to reply. Call on the sampling thread after
+ * each collection pass. No-op if the server is not running.
+ */
+void tm_query_fetch_details(void);
+
+/** Stop the server thread, disconnect clients and remove the socket. */
+void tm_query_stop(void);
+
+#endif /* TM_QUERY_H */
@@ -0,0 +1,97 @@
+/**
+ * @file tm_record.h
+ * @brief Binary snapshot recordings: columnar frames plus a seek index.
+ *
+ * The recorder appends one frame per sampler pass and writes the frame
+ * index as a footer on close. The reader maps the file and finds the
+ * frame for any timestamp by binary search over that index, decoding
+ * nothing but the frame it lands on.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_RECORD_H
+#define TM_RECORD_H
+
+#include "tm_types.h"
+
+/* -------------------------------------------------------------------------
+ * Recorder
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Start a recording on @p out by writing the file header.
+ * @param r        Recorder. Must not be NULL.
+ * @param out      Writer positioned at the start of the file; must
+ *                 outlive the recorder.
+ * @param epoch_ms Recording start, Unix epoch milliseconds.
+ * @return         TM_OK or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_rec_writer_open(TmRecWriter *r, TmWriter *out, uint64_t epoch_ms);
+
+/**
+ * Append a frame holding the process table, system CPU / memory and the
+ * per-core CPU of @p s.
+ * @param r      Recorder. Must not be NULL.
+ * @param s      Application state after a collection pass.
+ * @param ts_ms  Snapshot time, Unix epoch milliseconds (non-decreasing).
+ * @return       TM_OK or TM_ERR_ALLOC.
+ */
+tm_result_t tm_rec_write_frame(TmRecWriter *r, const TmAppState *s, uint64_t ts_ms);
+
+/**
+ * Write the index footer and release scratch buffers. Does not flush or
+ * close the underlying writer.
+ * @param r  Recorder. Must not be NULL.
+ */
+void tm_rec_writer_close(TmRecWriter *r);
+
+/* -------------------------------------------------------------------------
+ * Reader
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Map a recording. A file without its footer (recorder killed) is still
+ * readable: its frames are scanned once to rebuild the index.
+ * @param r     Reader. Must not be NULL.
+ * @param path  Recording path.
+ * @return      TM_OK, TM_ERR_IO (unreadable or not a recording) or
+ *              TM_ERR_ALLOC.
+ */
+tm_result_t tm_rec_open(TmRecReader *r, const char *path);
+
+/** Unmap the recording and free any rebuilt index. */
+void tm_rec_close(TmRecReader *r);
+
+/** Timestamp of frame @p i (Unix epoch ms); 0 if out of range. */
+uint64_t tm_rec_frame_ts(const TmRecReader *r, uint32_t i);
+
+/**
+ * Binary-search the index for the last frame at or before @p ts_ms.
+ * @return Frame number; 0 if @p ts_ms precedes the first frame.
+ */
+uint32_t tm_rec_seek(const TmRecReader *r, uint64_t ts_ms);
+
+/**
+ * Decode the header of frame @p i and set up its column cursors.
+ * @param r    Reader. Must not be NULL.
+ * @param i    Frame number, 0 .. frame_count - 1.
+ * @param out  Receives the frame.
+ * @return     TM_OK, TM_ERR_INVALID_ARG (range) or TM_ERR_IO (corrupt).
+ */
+tm_result_t tm_rec_frame(const TmRecReader *r, uint32_t i, TmRecFrame *out);
+
+/**
+ * Read the next row of @p f, in ascending pid order.
+ * @return false after the last row or on a corrupt column.
+ */
+bool tm_rec_next_row(TmRecFrame *f, TmRecRow *out);
+
+/**
+ * Read the per-core CPU column of @p f.
+ * @param out  Receives one percentage per core.
+ * @param max  Capacity of @p out.
+ * @return     Number of cores written.
+ */
+int tm_rec_cores(const TmRecFrame *f, float *out, int max);
+
+#endif /* TM_RECORD_H */
@@ -0,0 +1,114 @@
+/**
+ * @file tm_shm.h
+ * @brief Latest snapshot in shared memory, guarded by a seqlock.
+ *
+ * One collector publishes; any number of local readers map the segment
+ * read-only and take consistent views without a syscall or a lock: they
+ * never block the publisher, and a read that overlapped a publish is
+ * simply retried. Reading in place:
+ *
+ *     uint64_t seq;
+ *     do {
+ *         seq = tm_shm_read_begin(&r);
+ *         tm_shm_read_scalars(&r, &totals);
+ *         ... read r.pid[i], r.cpu[i], ... for i < totals.row_count ...
+ *     } while (tm_shm_read_retry(&r, seq));
+ *
+ * or take a private copy with tm_shm_read().
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_SHM_H
+#define TM_SHM_H
+
+#include "tm_types.h"
+
+/* -------------------------------------------------------------------------
+ * Publisher
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Read `--shm NAME` and `--shm-rows N` from the command line.
+ * @param name  Receives NAME, or NULL if --shm is absent.
+ * @param rows  Receives N, or TM_SHM_DEFAULT_ROWS.
+ * @return      false if --shm-rows is not a positive number.
+ */
+bool tm_shm_parse_args(int argc, char **argv, const char **name, int *rows);
+
+/**
+ * Create (or replace) segment @p name sized for @p rows processes.
+ * @param w      Publisher. Must not be NULL.
+ * @param name   Segment name, e.g. "/tm_snapshot".
+ * @param rows   Process rows the segment holds; larger tables are cut.
+ * @return       TM_OK, TM_ERR_INVALID_ARG or TM_ERR_PLATFORM.
+ */
+tm_result_t tm_shm_writer_open(TmShmWriter *w, const char *name, int rows);
+
+/**
+ * Publish the process table, system CPU / memory and per-core CPU of @p s
+ * as the segment's current snapshot.
+ * @param w      Publisher. Must not be NULL.
+ * @param s      Application state after a collection pass.
+ * @param ts_ms  Snapshot time, Unix epoch milliseconds.
+ */
+void tm_shm_publish(TmShmWriter *w, const TmAppState *s, uint64_t ts_ms);
+
+/** Unmap and remove the segment; readers keep their mappings. */
+void tm_shm_writer_close(TmShmWriter *w);
+
+/* -------------------------------------------------------------------------
+ * Reader
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Map segment @p name read-only and validate its header.
+ * @return TM_OK, TM_ERR_IO (missing or not a snapshot segment).
+ */
+tm_result_t tm_shm_reader_open(TmShmReader *r, const char *name);
+
+/** Unmap the segment. */
+void tm_shm_reader_close(TmShmReader *r);
+
+/**
+ * Start an in-place read. Changes whenever a new snapshot is published,
+ * so it also serves as a cheap "anything new?" poll.
+ * @return Sequence number to hand to tm_shm_read_retry().
+ */
+uint64_t tm_shm_read_begin(const TmShmReader *r);
+
+/**
+ * Finish an in-place read started with tm_shm_read_begin().
+ * @return true if a publish overlapped the read: discard what was read
+ *         and start again.
+ */
+bool tm_shm_read_retry(const TmShmReader *r, uint64_t seq);
+
+/**
+ * Copy the header scalars (time, memory, CPU total, counts) into @p out
+ * during an in-place read; the column pointers of @p out are untouched.
+ * Counts are clamped to the segment caps, but like everything read in
+ * place they are only valid if tm_shm_read_retry() then returns false.
+ */
+void tm_shm_read_scalars(const TmShmReader *r, TmShmSnapshot *out);
+
+/**
+ * Allocate a snapshot copy with columns sized to @p r's segment.
+ * @return TM_OK or TM_ERR_ALLOC.
+ */
+tm_result_t tm_shm_snapshot_alloc(const TmShmReader *r, TmShmSnapshot *out);
+
+/** Free columns allocated by tm_shm_snapshot_alloc(). */
+void tm_shm_snapshot_free(TmShmSnapshot *snap);
+
+/**
+ * Copy the current snapshot into @p out (from tm_shm_snapshot_alloc()).
+ * @return TM_OK; TM_ERR_BUSY if nothing has been published yet, if
+ *         TM_SHM_READ_RETRIES copies were all torn, or if a publish stayed
+ *         open for TM_SHM_SPIN_LIMIT polls (publisher died mid-write).
+ */
+tm_result_t tm_shm_read(const TmShmReader *r, TmShmSnapshot *out);
+
+/** Name of row @p i of a snapshot copy. */
+const char *tm_shm_snapshot_name(const TmShmSnapshot *snap, int i);
+
+#endif /* TM_SHM_H */
@@ -11,8 +11,17 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <time.h>
+
+/* The headless target builds without Raylib; UI state only needs these two
+ * plain structs from it, declared here with Raylib's layout. */
+#ifdef TM_HEADLESS
+typedef struct Rectangle { float x, y, width, height; } Rectangle;
+typedef struct Color { unsigned char r, g, b, a; } Color;
+#else
 #include "raylib.h"
+#endif
 
 /* -------------------------------------------------------------------------
  * Constants
@@ -25,8 +34,11 @@
 #define TM_MSG_MAX            256
 #define TM_HIST_LEN           100
 #define TM_HIST_SHORT         30
-#define TM_CORE_COUNT         8
-#define TM_MAX_OBSERVERS      8
+#define TM_MAX_CORES          512
+#define TM_CORE_HIST_LEN      60
+#define TM_PROC_HIST_LEN      60
+#define TM_HEATMAP_ROWS       20
+#define TM_HEATMAP_RANK_SAMPLES 5
 #define TM_MAX_STARTUP_APPS   8
 #define TM_MAX_HISTORY_APPS   8
 
@@ -43,6 +55,75 @@
 
 #define TM_PERF_UPDATE_INTERVAL_S 1.0f
 #define TM_HISTORY_UPDATE_INTERVAL_S 2.0f
+#define TM_PROCESS_REFRESH_INTERVAL_S 2.0f
+#define TM_DETAIL_REFRESH_INTERVAL_S 1.0f
+#define TM_DETAIL_PREFETCH_ROWS 5
+
+#define TM_MAX_TRIGGERS        8
+#define TM_BURST_RING_LEN      600      /* 60 s at the fastest burst rate */
+#define TM_BURST_INTERVAL_S    0.1f
+#define TM_BURST_WINDOW_S      10.0f
+#define TM_BURST_HOLD_S        30.0f    /* keep showing a capture after it ends */
+#define TM_BURST_CPU_PERCENT   90.0f
+#define TM_BURST_RSS_GROWTH_B  ((uint64_t)500 * 1024 * 1024)
+#define TM_BURST_RSS_WINDOW_S  60.0f
+
+#define TM_MAX_WATCH           5
+#define TM_WATCH_HIST_LEN      300      /* 30 s at the fastest rate */
+#define TM_WATCH_INTERVAL_S    0.1f     /* default and minimum: 10 Hz */
+#define TM_WATCH_PANEL_PX      110
+
+#define TM_TEXT_CACHE_BITS     10       /* 1024 direct-mapped cells */
+#define TM_TEXT_CELL_MAX       48
+#define TM_TEXT_WIDTH_BITS     8        /* 256 cached label widths */
+#define TM_TEXT_FIT_BITS       9        /* 512 cached ellipsized names */
+#define TM_GRAPH_CACHE_MAX     32
+#define TM_VLIST_OVERSCAN      2        /* rows drawn beyond each viewport edge */
+#define TM_CORE_GRAPH_MIN_W    64       /* smaller core cells switch to a heatmap */
+#define TM_CORE_GRAPH_MIN_H    32
+
+#define TM_FRAME_IDLE_WAIT_S   (1.0 / 60.0)  /* input poll period while idle */
+#define TM_FRAME_SETTLE        2        /* frames drawn after each trigger */
+#define TM_TAB_PRELOAD_IDLE_S  2.0      /* undrawn time before a tab preloads */
+#define TM_TAB_RELEASE_S       300.0    /* unseen time before a tab's data is freed */
+
+#define TM_EXPORT_BUF_BYTES    65536    /* headless writer flushes at this size */
+#define TM_HEADLESS_INTERVAL_S 1.0      /* default snapshot period */
+#define TM_HEADLESS_MIN_INTERVAL_S 0.05
+
+#define TM_REC_VERSION         1        /* snapshot recording format */
+#define TM_REPLAY_YIELD_S      0.001    /* longest real sleep per step at --speed max */
+
+#define TM_METRICS_ACCEPT_WAIT_S 0.25  /* exporter checks for shutdown this often */
+#define TM_METRICS_RECV_TIMEOUT_S 2.0  /* whole request head, then whole reply */
+#define TM_METRICS_REQUEST_MAX 4096     /* longest request head read */
+
+#define TM_SHM_VERSION         1        /* shared snapshot segment layout */
+#define TM_SHM_DEFAULT_ROWS    32768
+#define TM_SHM_NAME_LEN        32       /* bytes per process name cell */
+#define TM_SHM_READ_RETRIES    64       /* torn copies before giving up */
+#define TM_SHM_SPIN_LIMIT      (1 << 24) /* seq polls while a publish is open */
+
+#define TM_QUERY_WAIT_S        0.25     /* query loop checks for shutdown this often */
+#define TM_QUERY_LINE_MAX      256      /* longest request line */
+#define TM_QUERY_TOP_MAX       1000     /* largest N for `top N` */
+#define TM_QUERY_NAME_LEN      64       /* process name bytes kept per row */
+#define TM_QUERY_BACKLOG_MAX   (16u << 20) /* unsent bytes before a client is dropped */
+#define TM_QUERY_DETAIL_MAX    16       /* `pid` requests waiting for the sampler */
+
+#define TM_HISTLOG_SEGMENT_BYTES (64u << 20) /* history segment rolls at this size */
+#define TM_HISTLOG_SEGMENT_MS  (3600u * 1000u) /* ... or after this long */
+#define TM_HISTLOG_SYNC_S      1.0      /* writer batches and fsyncs this often */
+#define TM_HISTLOG_QUEUE_MAX   (64u << 20) /* unwritten bytes before samples are skipped */
+#define TM_HISTLOG_DEFAULT_MAX_MB 1024  /* oldest segments go past this total */
+#define TM_HISTLOG_NAME_LEN    64       /* process name bytes kept per query row */
+
+#define TM_WARM_VERSION        2        /* warm-start snapshot file layout */
+
+#define TM_SYNTH_MAX_PROCS     (1 << 20)  /* synthetic adapter population cap */
+#define TM_SYNTH_MAX_NAMES     65536
+#define TM_SYNTH_NAME_LEN      32
+
 #define TM_MSG_DISPLAY_FRAMES 120
 #define TM_MSG_SHORT_FRAMES   60
 
@@ -57,6 +138,7 @@ typedef enum {
     TM_ERR_IO          = -2,  /**< popen / file failure */
     TM_ERR_PLATFORM    = -3,  /**< OS call failed */
     TM_ERR_INVALID_ARG = -4,  /**< NULL or out-of-range param */
+    TM_ERR_BUSY        = -5,  /**< Data kept changing under a reader */
 } tm_result_t;
 
 /**
@@ -81,23 +163,81 @@ typedef enum {
     TM_TAB_PERFORMANCE = 1,
     TM_TAB_APP_HISTORY = 2,
     TM_TAB_STARTUP     = 3,
-    TM_TAB_COUNT       = 4,
+    TM_TAB_WATCH       = 4,
+    TM_TAB_HEATMAP     = 5,
+    TM_TAB_COUNT       = 6,
 } TmTabId;
 
+/* -------------------------------------------------------------------------
+ * Data sets (collector bit mask)
+ * ---------------------------------------------------------------------- */
+
+/** Groups of metrics the collector can gather independently. */
+typedef enum {
+    TM_DATA_NONE        = 0,
+    TM_DATA_SYSTEM      = 1u << 0,  /**< Aggregate CPU + memory */
+    TM_DATA_PERF_DETAIL = 1u << 1,  /**< Disk, GPU, thread count */
+    TM_DATA_PROCESSES   = 1u << 2,  /**< Per-process table */
+    TM_DATA_APP_HISTORY = 1u << 3,  /**< Per-application history rings */
+    TM_DATA_PROC_DETAIL = 1u << 4,  /**< Expensive per-process columns (viewport) */
+} TmDataSet;
+
+/** Sets gathered regardless of the active tab so history rings never gap. */
+#define TM_DATA_BASELINE (TM_DATA_SYSTEM | TM_DATA_APP_HISTORY)
+
+/** Sets the live exporters (metrics endpoint, shared memory) publish. */
+#define TM_DATA_EXPORTED (TM_DATA_SYSTEM | TM_DATA_PERF_DETAIL | TM_DATA_PROCESSES)
+
 /* -------------------------------------------------------------------------
  * Core Data Structures
  * ---------------------------------------------------------------------- */
 
+/** Costly per-process columns; only filled for rows near the viewport. */
+typedef struct {
+    uint64_t pss_kb;
+    uint64_t io_bytes;          /**< Read + written since process start */
+    int      fd_count;
+    char     cmdline[TM_CMD_MAX];
+    bool     is_valid;          /**< false until the collector fetched it */
+} TmProcessDetail;
+
+/** RSS reference point for growth triggers; carried across refreshes. */
+typedef struct {
+    uint64_t rss_base_bytes;
+    double   rss_base_t;        /**< Monotonic seconds; 0 = not yet seen */
+} TmProcessTrend;
+
+/** Per-interval CPU ring indexed by refresh number (process_seq % TM_PROC_HIST_LEN). */
+typedef struct {
+    float    cpu[TM_PROC_HIST_LEN];
+    uint32_t samples;           /**< Refreshes this PID was present for */
+} TmProcessHistory;
+
 /** A single process entry (intrusive singly-linked list). */
 typedef struct TmProcess {
     char             name[TM_NAME_MAX];
     uint32_t         pid;
     uint64_t         memory_bytes;
-    float            cpu_percent;
+    float            cpu_percent;   /**< As the adapter reports it (ps: lifetime average) */
+    float            cpu_interval;  /**< Percent of one core since the previous refresh */
+    double           cpu_time_s;    /**< User + system CPU so far; valid if start_ticks != 0 */
+    uint64_t         start_ticks;   /**< Start time in adapter units; 0 = no CPU counters */
     bool             is_selected;
+    TmProcessDetail  detail;
+    TmProcessTrend   trend;
+    TmProcessHistory history;
     struct TmProcess *next;
 } TmProcess;
 
+/** Flat, reusable copy of a process table (see tm_process_view_copy()). */
+typedef struct {
+    TmProcess  *rows;           /**< count rows, each linked to the next */
+    TmProcess **index;          /**< &rows[i], as TmAppState.process_index */
+    int         count;
+    int         cap;            /**< Rows allocated; only ever grows */
+    uint32_t    seq;            /**< process_seq of the copied table */
+} TmProcessView;
+
 /** A single startup application entry. */
 typedef struct TmStartupApp {
     char                name[TM_NAME_MAX];
@@ -118,15 +258,24 @@ typedef struct TmAppHistory {
     uint64_t             network_kb;
     uint64_t             network_history[TM_HIST_SHORT];
     int                  history_idx;
-    clock_t              last_update;
+    uint32_t             sample_seq;      /**< Samples pushed so far */
+    double               last_update;     /**< Monotonic seconds */
     struct TmAppHistory *next;
 } TmAppHistory;
 
+/** One caller's previous CPU counters for sample_cpu*(); zero before first use. */
+typedef struct {
+    uint64_t busy;
+    uint64_t total;           /**< 0 = no reading yet */
+    float    percent;         /**< Last result; repeated if the counters did not move */
+} TmCpuTicks;
+
 /** System-wide performance metrics with 100-sample history rings. */
 typedef struct {
     float    cpu_percent;
     float    cpu_history[TM_HIST_LEN];
     int      cpu_idx;
+    uint32_t cpu_seq;         /**< Samples pushed so far; never wraps the ring */
 
     uint64_t mem_used_kb;
     uint64_t mem_total_kb;
@@ -142,14 +291,121 @@ typedef struct {
     float    gpu_percent;
     float    gpu_history[TM_HIST_LEN];
     int      gpu_idx;
+    uint32_t gpu_seq;
+
+    int      core_count;      /**< Detected logical CPUs, <= TM_MAX_CORES */
+    float    core_percent[TM_MAX_CORES];
+    float    core_history[TM_MAX_CORES][TM_CORE_HIST_LEN];
+    int      core_idx;
+    uint32_t core_seq;
+
+    TmCpuTicks cpu_ticks;                 /**< Baselines of this run only */
+    TmCpuTicks core_ticks[TM_MAX_CORES];
 
     int      process_count;
     int      thread_count;
-    uint32_t uptime_s;
+    double   uptime_s;        /**< Sampled seconds; whole seconds only when shown */
 
-    clock_t  last_update;
+    double   last_update;     /**< Monotonic seconds */
 } TmPerfData;
 
+/** Collection schedule: which data sets are wanted and when each was gathered. */
+typedef struct {
+    uint32_t needs;           /**< TmDataSet mask (active tab + baseline + pinned) */
+    uint32_t pinned;          /**< Sets an exporter keeps fresh on every tab */
+    uint32_t pending;         /**< Newly needed sets, gathered on next update */
+    double   last_system;     /**< Monotonic seconds of each last gather */
+    double   last_processes;
+    double   last_detail;
+    int      view_first;      /**< First process row visible on screen */
+    int      view_count;      /**< Number of process rows visible */
+    bool     view_dirty;      /**< Rows in view may lack detail columns */
+    bool     is_priming;      /**< First process gather still on its worker thread */
+} TmCollector;
+
+/** Frame scheduler: redraw only when something visible may have changed. */
+typedef struct {
+    int      redraw_frames;   /**< Frames still to draw for the last trigger */
+    bool     is_dirty;        /**< An event was published since the last draw */
+    double   polled_at;       /**< Monotonic seconds of the latest input poll */
+    double   input_at;        /**< Poll that delivered pending input, 0 if none */
+    double   drawn_at;        /**< Monotonic seconds of the latest frame drawn */
+    double   latency_sum_ms;  /**< Input poll to frame presented */
+    float    latency_max_ms;
+    uint32_t latency_count;
+    uint32_t frames_drawn;
+    uint32_t frames_idle;
+    double   launched_at;     /**< Monotonic seconds at process start */
+    float    first_frame_ms;  /**< Launch to first frame presented */
+    float    first_live_ms;   /**< Launch to first frame showing live process rows */
+} TmFrameSched;
+
+/** Conditions that switch the collector into high-resolution sampling. */
+typedef enum {
+    TM_TRIGGER_SYSTEM_CPU = 0,    /**< threshold: percent */
+    TM_TRIGGER_RSS_GROWTH = 1,    /**< threshold: bytes grown within window_s */
+} TmTriggerKind;
+
+typedef struct {
+    TmTriggerKind kind;
+    double        threshold;
+    float         window_s;
+} TmBurstTrigger;
+
+/** High-resolution samples captured while a burst is active. */
+typedef struct {
+    float    cpu[TM_BURST_RING_LEN];
+    uint64_t mem_kb[TM_BURST_RING_LEN];    /**< System memory in use (query_memory) */
+    uint64_t proc_rss[TM_BURST_RING_LEN];  /**< Bytes; tripping PID only */
+    int      idx;
+    int      count;
+    uint32_t seq;             /**< Samples pushed so far */
+} TmBurstRing;
+
+/** Burst sampler state: triggers, capture window and its ring. */
+typedef struct {
+    TmBurstTrigger triggers[TM_MAX_TRIGGERS];
+    int            trigger_count;
+    float          interval_s;     /**< 0.05 - 0.1 s */
+    float          window_s;
+    TmBurstRing    ring;
+    bool           is_active;
+    double         started_at;
+    double         ends_at;
+    double         last_sample;
+    uint32_t       pid;            /**< Process that tripped, 0 for system */
+    TmCpuTicks     cpu_ticks;      /**< Own baseline, apart from the 1 s sampler's */
+} TmBurst;
+
+/** One reading from a per-PID sampler handle. */
+typedef struct {
+    double   cpu_time_s;        /**< user + system time consumed so far */
+    uint64_t rss_bytes;
+    uint64_t io_bytes;          /**< Read + written so far */
+} TmProcSample;
+
+/** A pinned process sampled at its own rate with private history rings. */
+typedef struct {
+    uint32_t pid;
+    char     name[TM_NAME_MAX];
+    char     cmdline[TM_CMD_MAX];   /**< With name, re-identifies a restarted process */
+    int      handle;                /**< Platform sampler handle, -1 when closed */
+    bool     is_alive;
+    float    interval_s;
+    double   last_sample;
+    TmProcSample prev;
+    float    cpu[TM_WATCH_HIST_LEN];     /**< percent of one core */
+    float    rss_mb[TM_WATCH_HIST_LEN];
+    float    io_kbps[TM_WATCH_HIST_LEN];
+    int      idx;
+    int      count;
+} TmWatchEntry;
+
+typedef struct {
+    TmWatchEntry entries[TM_MAX_WATCH];
+    int          count;
+} TmWatchList;
+
 /* -------------------------------------------------------------------------
  * UI Structures
  * ---------------------------------------------------------------------- */
@@ -168,6 +424,8 @@ typedef struct {
     char      text[50];
     bool      is_active;
     bool      is_hovered;
+    bool      is_loaded;    /**< Descriptor load hook has run */
+    double    last_seen;    /**< Monotonic s last on screen or loaded; 0 = never */
 } TmTab;
 
 typedef struct {
@@ -181,6 +439,45 @@ typedef struct {
     int       max_scroll;
 } TmScrollBar;
 
+/** Retained layout nodes; see the spec table in ui/ui_layout.c. */
+typedef enum {
+    TM_NODE_ROOT = 0,
+    TM_NODE_TITLE_BAR,
+    TM_NODE_STATUS_BAR,
+    TM_NODE_RESIZE_GRIP,
+    TM_NODE_BTN_REFRESH,
+    TM_NODE_BTN_END_TASK,
+    TM_NODE_BTN_PIN,
+    TM_NODE_BTN_ENABLE,
+    TM_NODE_BTN_DISABLE,
+    TM_NODE_PROC_HEADER,
+    TM_NODE_PROC_LIST,
+    TM_NODE_PROC_SCROLL,
+    TM_NODE_PERF_PANEL,
+    TM_NODE_PERF_CORES,
+    TM_NODE_HISTORY_PANEL,
+    TM_NODE_HISTORY_HEADER,
+    TM_NODE_HISTORY_LIST,
+    TM_NODE_HISTORY_SCROLL,
+    TM_NODE_STARTUP_PANEL,
+    TM_NODE_STARTUP_LIST,
+    TM_NODE_STARTUP_SCROLL,
+    TM_NODE_WATCH_LIST,
+    TM_NODE_HEATMAP,
+    TM_NODE_COUNT
+} TmLayoutNode;
+
+/** What must be recomputed on the next ui_layout_sync(). */
+typedef enum {
+    TM_LAYOUT_DIRTY_SIZE    = 1u << 0,  /**< Window resized: node rectangles */
+    TM_LAYOUT_DIRTY_CONTENT = 1u << 1,  /**< Row counts changed: scroll extents */
+} TmLayoutDirty;
+
+typedef struct {
+    Rectangle rect[TM_NODE_COUNT];
+    uint32_t  dirty;            /**< TmLayoutDirty bits */
+} TmLayout;
+
 /* -------------------------------------------------------------------------
  * Application State
  * ---------------------------------------------------------------------- */
@@ -194,15 +491,28 @@ typedef struct TmAppState {
     /* Data layer */
     TmProcess    *process_list;
     int           process_count;
+    TmProcess   **process_index;   /**< process_count nodes in list order */
+    uint32_t      process_seq;     /**< Refreshes so far; clocks the history rings */
+    double        process_at;      /**< Monotonic s of the last adopted refresh; 0 = none */
+    uint64_t      warm_ms;         /**< Save time of the warm snapshot on screen; 0 = live */
     TmStartupApp *startup_list;
+    TmStartupApp **startup_index;
+    int           startup_count;
     TmAppHistory *history_list;
+    TmAppHistory **history_index;
+    int           history_count;
     TmPerfData    perf;
-    float         cpu_core_usage[TM_CORE_COUNT];
+    TmCollector   collector;
+    TmFrameSched  frame;
+    TmLayout      layout;
+    TmBurst       burst;
+    TmWatchList   watch;
 
     /* UI state */
     TmTab       tabs[TM_TAB_COUNT];
     TmButton    refresh_btn;
     TmButton    end_task_btn;
+    TmButton    pin_btn;
     TmButton    enable_startup_btn;
     TmButton    disable_startup_btn;
     TmScrollBar process_scroll;
@@ -226,26 +536,285 @@ typedef struct TmAppState {
 } TmAppState;
 
 /* -------------------------------------------------------------------------
- * Observer
+ * Event bus
+ * ---------------------------------------------------------------------- */
+
+/** Event types; a delivery carries the OR of everything coalesced into it. */
+typedef enum {
+    TM_EVENT_NONE              = 0,
+    TM_EVENT_PROCESSES_CHANGED = 1 << 0,
+    TM_EVENT_DETAILS_FETCHED   = 1 << 1,
+    TM_EVENT_SYSTEM_SAMPLED    = 1 << 2,
+    TM_EVENT_HISTORY_TICKED    = 1 << 3,
+    TM_EVENT_BURST_SAMPLED     = 1 << 4,
+    TM_EVENT_WATCH_SAMPLED     = 1 << 5,
+    TM_EVENT_EXPORT_READY      = 1 << 6,  /**< A pass was copied for the exporter worker */
+} TmEventType;
+
+#define TM_EVENT_ALL 0xFFFFFFFFu
+/** Everything that changes what the window shows */
+#define TM_EVENT_DATA_ALL (TM_EVENT_ALL & ~(uint32_t)TM_EVENT_EXPORT_READY)
+
+/** Where a subscriber's callback runs. */
+typedef enum {
+    TM_DISPATCH_UI,      /**< From tm_event_dispatch() on the UI thread */
+    TM_DISPATCH_THREAD,  /**< On a worker thread owned by the subscriber */
+} TmDispatchMode;
+
+typedef struct {
+    uint32_t          types;  /**< Coalesced TmEventType bits */
+    uint32_t          count;  /**< Publications merged into this delivery */
+    uint64_t          seq;    /**< Bus sequence number of the newest one */
+    const TmAppState *state;  /**< App state on UI dispatch; NULL on a worker thread */
+} TmEvent;
+
+typedef void (*TmEventFn)(const TmEvent *ev, void *user_data);
+
+/* -------------------------------------------------------------------------
+ * Headless export
+ * ---------------------------------------------------------------------- */
+
+typedef enum {
+    TM_EXPORT_JSONL = 0,   /**< One JSON object per line */
+    TM_EXPORT_CSV   = 1,   /**< Header row, then one row per record */
+    TM_EXPORT_TMREC = 2,   /**< Binary recording, see tm_record.h */
+} TmExportFormat;
+
+/** Selectable output columns; process fields first, then system fields. */
+typedef enum {
+    TM_FIELD_PID = 0,
+    TM_FIELD_NAME,
+    TM_FIELD_CPU,
+    TM_FIELD_MEM_KB,
+    TM_FIELD_PSS_KB,
+    TM_FIELD_FDS,
+    TM_FIELD_IO_BYTES,
+    TM_FIELD_CMDLINE,
+    TM_FIELD_CPU_TOTAL,
+    TM_FIELD_MEM_USED_KB,
+    TM_FIELD_MEM_TOTAL_KB,
+    TM_FIELD_MEM_AVAIL_KB,
+    TM_FIELD_NPROCS,
+    TM_FIELD_COUNT
+} TmExportField;
+
+/** Growable byte buffer; keeps its capacity when reset to len = 0. */
+typedef struct {
+    char   *data;
+    size_t  len;
+    size_t  cap;
+} TmByteBuf;
+
+/**
+ * Buffered writer; see tm_export.h. Drains to a stdio stream without
+ * allocating, or to a TmByteBuf that grows only past its high-water mark.
+ */
+typedef struct {
+    FILE      *fp;
+    TmByteBuf *mem;               /**< Memory sink when fp is NULL */
+    size_t     len;
+    bool       failed;            /**< A write came up short */
+    uint64_t   bytes;             /**< Flushed so far */
+    char       buf[TM_EXPORT_BUF_BYTES];
+} TmWriter;
+
+typedef struct {
+    TmExportFormat format;
+    uint32_t       fields;        /**< Bit (1u << TmExportField) per column */
+} TmExportConfig;
+
+/* -------------------------------------------------------------------------
+ * Snapshot recording (layout documented in core/tm_record.c)
  * ---------------------------------------------------------------------- */
 
-typedef void (*TmProcessChangedFn)(const TmAppState *s, void *user_data);
+/** Row of the recorder's pid sort. */
+typedef struct {
+    uint32_t pid;
+    int32_t  row;
+} TmRecKey;
+
+/** Recorder: frames are built in scratch buffers, then streamed via out. */
+typedef struct {
+    TmWriter *out;
+    uint64_t  origin;         /**< out position of the file header */
+    uint8_t  *frame;          /**< Frame under construction */
+    size_t    frame_len;
+    size_t    frame_cap;
+    uint8_t  *index;          /**< 16 bytes per frame: ts_ms, offset */
+    uint32_t  frame_count;
+    uint32_t  index_cap;
+    TmRecKey *keys;           /**< Rows in pid order */
+    uint32_t *name_off;       /**< Per key: offset into the string blob */
+    int32_t  *slots;          /**< Name hash table: key index of first use */
+    int       rows_cap;
+    int       slot_mask;
+} TmRecWriter;
+
+/** A recording mapped with tm_rec_open(). */
+typedef struct {
+    const uint8_t *base;
+    size_t         size;
+    const uint8_t *index;       /**< Footer index, or owned_index */
+    uint8_t       *owned_index; /**< Rebuilt by a scan if the footer is missing */
+    uint32_t       frame_count;
+    uint64_t       created_ms;  /**< Unix epoch ms when recording started */
+} TmRecReader;
+
+/** One decoded frame; rows are read in pid order with tm_rec_next_row(). */
+typedef struct {
+    uint64_t       ts_ms;
+    float          cpu_total;
+    uint64_t       mem_used_kb;
+    uint64_t       mem_total_kb;
+    int            core_count;
+    int            row_count;
+    int            string_count;
+    const uint8_t *cores;       /**< Column cursors into the mapping */
+    const uint8_t *strings;
+    size_t         strings_len;
+    const uint8_t *col_pid;
+    const uint8_t *col_name;
+    const uint8_t *col_cpu;
+    const uint8_t *col_mem;
+    const uint8_t *end;
+    int            next_row;
+    uint32_t       last_pid;
+} TmRecFrame;
+
+typedef struct {
+    uint32_t    pid;
+    const char *name;           /**< NUL-terminated, inside the mapping */
+    float       cpu_percent;    /**< TmProcess.cpu_interval when recorded */
+    uint64_t    mem_kb;
+} TmRecRow;
+
+/* -------------------------------------------------------------------------
+ * Shared-memory snapshot (layout documented in core/tm_shm.c)
+ * ---------------------------------------------------------------------- */
+
+/** Segment header; laid out in tm_shm.c, which alone reads it. */
+typedef struct TmShmHeader TmShmHeader;
+
+/** Publisher side of a segment. */
+typedef struct {
+    TmShmHeader *hdr;
+    size_t       size;
+    uint8_t     *stage;         /**< Private image the snapshot is built in */
+    char         name[64];
+} TmShmWriter;
+
+/** A segment mapped read-only, with column pointers into the mapping. */
+typedef struct {
+    const TmShmHeader *hdr;
+    size_t             size;
+    const float       *cores;
+    const uint32_t    *pid;
+    const float       *cpu;
+    const uint64_t    *mem_kb;
+    const char        *names;       /**< row_cap cells of name_len bytes */
+} TmShmReader;
+
+/** A consistent copy of one snapshot; columns sized to the segment caps. */
+typedef struct {
+    uint64_t  seq;
+    uint64_t  ts_ms;
+    uint64_t  mem_used_kb;
+    uint64_t  mem_total_kb;
+    uint64_t  mem_avail_kb;
+    float     cpu_total;
+    int       core_count;
+    int       row_count;
+    int       process_count;
+    int       name_len;
+    float    *cores;
+    uint32_t *pid;
+    float    *cpu;
+    uint64_t *mem_kb;
+    char     *names;
+} TmShmSnapshot;
+
+/* -------------------------------------------------------------------------
+ * History log (core/tm_histlog.c)
+ * ---------------------------------------------------------------------- */
+
+/** One segment of the history log; its file name encodes start_ms. */
+typedef struct {
+    uint64_t start_ms;          /**< Unix epoch ms of the first sample */
+    uint64_t bytes;
+} TmHistSegment;
+
+/* -------------------------------------------------------------------------
+ * Warm start (core/tm_warm.c)
+ * ---------------------------------------------------------------------- */
+
+/** File header; the sections follow in this order, each record a fixed size. */
+typedef struct {
+    char     magic[8];          /**< "TMWARM" NUL-padded */
+    uint32_t version;           /**< TM_WARM_VERSION */
+    uint32_t perf_bytes;        /**< sizeof(TmPerfData) of the writing build */
+    uint32_t app_bytes;         /**< Bytes per app-history record */
+    uint32_t proc_bytes;        /**< Bytes per process record */
+    uint32_t app_count;
+    uint32_t proc_count;
+    uint32_t process_seq;       /**< TmAppState.process_seq at save time */
+    uint32_t reserved;
+    uint64_t saved_ms;          /**< Unix epoch ms */
+} TmWarmHeader;
+
+/* -------------------------------------------------------------------------
+ * Query socket (core/tm_query.c)
+ * ---------------------------------------------------------------------- */
+
+/** One process as the query server sees it. */
+typedef struct {
+    uint32_t pid;
+    float    cpu_percent;       /**< TmProcess.cpu_interval; deltas and top-N use it */
+    uint64_t mem_kb;
+    char     name[TM_QUERY_NAME_LEN];
+} TmQueryRow;
+
+/** A published refresh: rows sorted by PID, so two can be merged into a delta. */
+typedef struct {
+    TmQueryRow *rows;
+    int         count;
+    int         cap;
+    uint64_t    seq;            /**< Publish number; 0 = nothing published */
+    float       cpu_percent;
+    uint64_t    mem_used_kb;
+    uint64_t    mem_total_kb;
+} TmQuerySnap;
+
+/* -------------------------------------------------------------------------
+ * Synthetic load generator (platform/platform_synthetic.c)
+ * ---------------------------------------------------------------------- */
 
+/** Population model; the same seed and settings give the same refreshes. */
 typedef struct {
-    TmProcessChangedFn on_process_changed;
-    void              *user_data;
-} TmObserver;
+    uint64_t seed;
+    int      processes;       /**< Initial population, 1 .. TM_SYNTH_MAX_PROCS */
+    int      spawn_rate;      /**< Processes started per refresh */
+    int      exit_rate;       /**< Processes ended per refresh */
+    int      names;           /**< Distinct names, 1 .. TM_SYNTH_MAX_NAMES */
+    float    cpu_mean;        /**< Mean per-process CPU %, heavy-tailed */
+    uint64_t mem_mean_kb;     /**< Mean per-process RSS, heavy-tailed */
+} TmSynthConfig;
 
 /* -------------------------------------------------------------------------
  * Tab descriptor (Strategy Pattern)
  * ---------------------------------------------------------------------- */
 
 typedef void (*TmTabDrawFn)(const TmAppState *s);
+typedef tm_result_t (*TmTabLoadFn)(TmAppState *s);
+typedef void (*TmTabReleaseFn)(TmAppState *s);
 
 typedef struct {
-    TmTabId      id;
-    const char  *label;
-    TmTabDrawFn  draw;
+    TmTabId        id;
+    const char    *label;
+    TmTabDrawFn    draw;
+    uint32_t       data_needs;  /**< TmDataSet mask the renderer consumes */
+    TmTabLoadFn    load;        /**< Builds the tab's data on first use; NULL = none */
+    TmTabReleaseFn release;     /**< Frees it after TM_TAB_RELEASE_S unseen; NULL = keep.
+                                     Never for data the collector samples */
 } TmTabDescriptor;
 
 #endif /* TM_TYPES_H */
@@ -29,6 +29,10 @@ extern const Color TM_COLOR_DISK;
 extern const Color TM_COLOR_GPU;
 extern const Color TM_COLOR_ENABLED;
 extern const Color TM_COLOR_DISABLED;
+extern const Color TM_COLOR_PINNED;
+
+/** Heatmap colour for a 0–100 % value, green through yellow to red. */
+Color ui_heat_color(float pct);
 
 /* -------------------------------------------------------------------------
  * Layout / Init
@@ -42,10 +46,31 @@ extern const Color TM_COLOR_DISABLED;
 void ui_init(TmAppState *s);
 
 /**
- * Recompute all layout rectangles after a window resize.
+ * Tab lifecycle work for a loop iteration that drew nothing: release the
+ * data of tabs unseen for TM_TAB_RELEASE_S, and once no frame has been
+ * drawn for TM_TAB_PRELOAD_IDLE_S run one never-used tab's load hook.
+ * Tabs otherwise load on first activation (TmTabDescriptor.load).
  * @param s  Application state. Must not be NULL.
  */
-void ui_layout_update(TmAppState *s);
+void ui_tabs_idle(TmAppState *s);
+
+/**
+ * Mark parts of the retained layout stale (ui/ui_layout.c).
+ * @param s      Application state. Must not be NULL.
+ * @param flags  TmLayoutDirty bits: SIZE after a resize, CONTENT after a
+ *               row count changed.
+ */
+void ui_layout_invalidate(TmAppState *s, uint32_t flags);
+
+/**
+ * Recompute whatever is dirty; a no-op on clean frames. Called once per
+ * frame before input handling.
+ * @param s  Application state. Must not be NULL.
+ */
+void ui_layout_sync(TmAppState *s);
+
+/** Cached rectangle of a layout node. */
+Rectangle ui_layout_rect(const TmAppState *s, TmLayoutNode node);
 
 /* -------------------------------------------------------------------------
  * Per-frame update (input + drawing)
@@ -58,6 +83,13 @@ void ui_layout_update(TmAppState *s);
  */
 void ui_input_update(TmAppState *s);
 
+/**
+ * Return true if a key that ui_input_update() handles was pressed or is
+ * held. Reads key state only, so raylib's key and char queues are left
+ * for whoever consumes them.
+ */
+bool ui_input_key_pending(void);
+
 /**
  * Handle window resize events (including drag-resize handle).
  * @param s  Application state. Must not be NULL.
@@ -121,6 +153,237 @@ void ui_scrollbar_update(TmScrollBar *sb, Vector2 mouse, float wheel,
 /** Draw the scrollbar if content exceeds the visible area. */
 void ui_scrollbar_draw(const TmScrollBar *sb);
 
+/* -------------------------------------------------------------------------
+ * Frame scheduler (ui/ui_frame.c)
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Reset scheduler state and subscribe it to the event bus.
+ * Called from ui_init(), after tm_event_init().
+ */
+void ui_frame_init(TmAppState *s);
+
+/**
+ * Decide whether this loop iteration draws: true on input, on a newly
+ * published sample, while a toast is visible, or while settling.
+ * Call after app_update().
+ */
+bool ui_frame_should_draw(TmAppState *s);
+
+/**
+ * Record a drawn frame and its input latency. The first frame, and the
+ * first one drawn from live process data, are timed from
+ * TmFrameSched.launched_at and logged. Call after EndDrawing().
+ */
+void ui_frame_drawn(TmAppState *s);
+
+/** Sleep one poll period and poll input instead of drawing. */
+void ui_frame_idle(TmAppState *s);
+
+/** Log frame counts, input latency and time to first frame at INFO level. */
+void ui_frame_report(const TmAppState *s);
+
+/* -------------------------------------------------------------------------
+ * Text rendering (ui/ui_text.c)
+ * ---------------------------------------------------------------------- */
+
+/** Resolve the glyph atlas metrics. Call once after InitWindow(). */
+void ui_text_init(void);
+
+/**
+ * Draw single-line text; metrics match DrawText() with the default font.
+ * @param text  NUL-terminated string. Bytes outside ASCII draw as '?'.
+ * @param x     Left edge.
+ * @param y     Top edge.
+ * @param size  Font size in pixels.
+ * @param col   Text colour.
+ */
+void ui_text_draw(const char *text, int x, int y, int size, Color col);
+
+/** Width of @p text in pixels, computed on every call. */
+int ui_text_measure(const char *text, int size);
+
+/**
+ * Width of a label that is drawn repeatedly, cached by content and size.
+ * Prefer ui_text_measure() for text that changes every sample.
+ */
+int ui_text_width(const char *label, int size);
+
+/**
+ * @p text cut to fit @p max_w pixels with a trailing "...", or @p text
+ * itself when it fits. The result is cached per (text, size, max_w), so
+ * each name is truncated once rather than every frame.
+ * @return Pointer valid until the cache slot is reused; draw it at once.
+ */
+const char *ui_text_fit(const char *text, int size, int max_w);
+
+/* -------------------------------------------------------------------------
+ * Formatted-text cache (ui/ui_text_cache.c)
+ * ---------------------------------------------------------------------- */
+
+/** Cell columns; with a row id they form the cache key. */
+typedef enum {
+    TM_COL_NONE = 0,
+    TM_COL_PROC_PID,
+    TM_COL_PROC_CPU,
+    TM_COL_PROC_MEM,
+    TM_COL_PROC_PSS,
+    TM_COL_PROC_FDS,
+    TM_COL_PROC_IO,
+    TM_COL_PROC_CMD,
+    TM_COL_PROC_STATS,
+    TM_COL_HIST_CPU,
+    TM_COL_HIST_MEM,
+    TM_COL_HIST_NET,
+    TM_COL_STARTUP_IMPACT,
+    TM_COL_PERF_CPU,
+    TM_COL_PERF_GPU,
+    TM_COL_PERF_MEM,
+    TM_COL_PERF_DISK,
+    TM_COL_PERF_CORES,
+    TM_COL_HEAT_SCORE,
+    TM_COL_HEAT_CAPTION,
+} TmTextColumn;
+
+typedef struct {
+    int  width;                   /**< MeasureText() of text at the cached size */
+    char text[TM_TEXT_CELL_MAX];
+} TmCachedText;
+
+/**
+ * Subscribe the cache to the event bus. Call once from ui_init(),
+ * after tm_event_init().
+ */
+void ui_text_cache_init(void);
+
+/**
+ * Return the generation for a set of event types. It changes whenever
+ * the sampler publishes any of @p types. Use it as the @p gen argument of
+ * ui_text_cell() for values derived from those data sets.
+ * @param types  TmEventType mask; TM_EVENT_NONE gives a constant 0.
+ */
+uint32_t ui_text_gen(uint32_t types);
+
+/**
+ * Return the formatted text of a cell. The text is only re-formatted and
+ * re-measured when (row_id, col, gen, font_size) differs from the cached
+ * cell, so steady-state frames skip snprintf and MeasureText.
+ * @param row_id     Stable row identity (PID, list index, ...).
+ * @param col        Column of the cell.
+ * @param gen        Value generation from ui_text_gen().
+ * @param font_size  Size passed to MeasureText().
+ * @param fmt        printf-style format; arguments follow.
+ * @return           Cached cell; valid until the next ui_text_cell() call
+ *                   that maps to the same slot.
+ */
+const TmCachedText *ui_text_cell(uint32_t row_id, TmTextColumn col, uint32_t gen,
+                                 int font_size, const char *fmt, ...);
+
+/* -------------------------------------------------------------------------
+ * Cached graphs (ui/ui_graph.c)
+ * ---------------------------------------------------------------------- */
+
+/**
+ * Paint a graph with its top-left corner at (0, 0).
+ * @param ctx  Caller data forwarded from ui_graph_draw_cached().
+ * @param w    Graph width in pixels.
+ * @param h    Graph height in pixels.
+ */
+typedef void (*TmGraphPaintFn)(const void *ctx, int w, int h);
+
+/**
+ * Draw a graph through a cached RenderTexture2D. @p paint runs only when
+ * the cached texture for @p key is missing, was resized, or was painted
+ * for a different @p gen; otherwise the frame draws a single texture.
+ * @param key    Stable identity of the graph, e.g. the address of its ring.
+ * @param gen    Sample sequence of the data; change it to force a repaint.
+ * @param bounds Destination on screen.
+ * @param paint  Painter called inside BeginTextureMode().
+ * @param ctx    Forwarded to @p paint.
+ */
+void ui_graph_draw_cached(const void *key, uint32_t gen, Rectangle bounds,
+                          TmGraphPaintFn paint, const void *ctx);
+
+/**
+ * Draw a ring-buffer series as one polyline. When there are more samples
+ * than pixel columns, each column is reduced to its min and max sample, so
+ * the cost is bounded by the width and spikes are kept. The result is
+ * submitted with a single DrawLineStrip().
+ * @param ring   Sample ring of @p cap entries.
+ * @param cap    Ring capacity; the width spans @p cap - 1 sample steps.
+ * @param start  Ring index of the oldest sample.
+ * @param len    Number of valid samples (<= @p cap).
+ * @param max_v  Value drawn at the top edge of @p area.
+ * @param area   Plot rectangle.
+ * @param col    Line colour.
+ */
+void ui_graph_series_draw(const float *ring, int cap, int start, int len,
+                          float max_v, Rectangle area, Color col);
+
+/**
+ * Queue a sparkline into the shared vertex buffer; nothing is drawn until
+ * ui_graph_spark_flush(), so sparklines interleaved with row drawing still
+ * end up in a single line batch.
+ * @param samples  Values, oldest first.
+ * @param n        Number of values; the newest is drawn at the right edge.
+ * @param slots    Samples spanning the full width (n <= slots).
+ * @param max_v    Value drawn at the top edge; larger values are clamped.
+ * @param area     Plot rectangle.
+ */
+void ui_graph_spark_queue(const float *samples, int n, int slots, float max_v,
+                          Rectangle area);
+
+/** Draw and clear all queued sparklines in @p col. */
+void ui_graph_spark_flush(Color col);
+
+/** Unload every cached texture and free scratch buffers. Call before CloseWindow(). */
+void ui_graph_cache_free(void);
+
+/* -------------------------------------------------------------------------
+ * Virtualized lists (ui/ui_vlist.c)
+ * ---------------------------------------------------------------------- */
+
+/** Geometry of a scrolled list of fixed-height rows. */
+typedef struct {
+    Rectangle area;       /**< Viewport on screen                    */
+    int       row_h;      /**< Row height in pixels                  */
+    int       count;      /**< Total number of rows                  */
+    int       scroll_px;  /**< Scroll offset of the first row        */
+} TmVList;
+
+/** Draw row @p index with its top edge at @p y. */
+typedef void (*TmVListRowFn)(const TmAppState *s, int index, int y, int width);
+
+/**
+ * Build a list over a layout node's rectangle.
+ * @param area   Viewport; rows span its width.
+ * @param sb     Scrollbar supplying the scroll offset.
+ * @param row_h  Row height in pixels.
+ * @param count  Number of rows.
+ */
+TmVList ui_vlist_make(Rectangle area, const TmScrollBar *sb, int row_h, int count);
+
+/**
+ * Rows intersecting the viewport, widened by TM_VLIST_OVERSCAN on each
+ * side and clamped to the list. O(1) in the list length.
+ * @param first  Out: index of the first row.
+ * @param count  Out: number of rows from @p first (may be 0).
+ */
+void ui_vlist_range(const TmVList *v, int *first, int *count);
+
+/**
+ * Row under a screen point.
+ * @return Row index, or -1 when the point is outside the viewport or
+ *         below the last row.
+ */
+int ui_vlist_row_at(const TmVList *v, Vector2 point);
+
+/**
+ * Draw the rows in ui_vlist_range(), clipped to the viewport.
+ * @param row  Row renderer; rows are fetched by index, never by walking.
+ */
+void ui_vlist_draw(const TmVList *v, const TmAppState *s, TmVListRowFn row);
+
 /* -------------------------------------------------------------------------
  * Button helpers (ui/ui_button.c)
  * ---------------------------------------------------------------------- */
@@ -140,8 +403,28 @@ void ui_button_draw_and_handle(TmButton *btn, TmAppState *s,
  * ---------------------------------------------------------------------- */
 
 void ui_tab_process_draw(const TmAppState *s);
+
+/** Process list geometry, shared by the renderer and row hit-testing. */
+TmVList ui_process_vlist(const TmAppState *s);
+
+/**
+ * Compute the process rows on screen from process_scroll.scroll_pos.
+ * @param s      Application state. Must not be NULL.
+ * @param first  Out: index of the first visible row.
+ * @param count  Out: maximum number of rows that fit the list area.
+ */
+void ui_process_visible_range(const TmAppState *s, int *first, int *count);
+
 void ui_tab_perf_draw(const TmAppState *s);
 void ui_tab_history_draw(const TmAppState *s);
 void ui_tab_startup_draw(const TmAppState *s);
 
+/** Startup list geometry, shared by the renderer and row hit-testing. */
+TmVList ui_startup_vlist(const TmAppState *s);
+void ui_tab_watch_draw(const TmAppState *s);
+void ui_tab_heatmap_draw(const TmAppState *s);
+
+/** Release the heatmap texture. Call before CloseWindow(). */
+void ui_heatmap_free(void);
+
 #endif /* TM_UI_H */
@@ -0,0 +1,42 @@
+/**
+ * @file tm_warm.h
+ * @brief Warm start: the last snapshot and history rings saved on exit and
+ *        mapped back in at launch, so the first frame has rows to show.
+ *
+ * The restored data is marked stale (TmAppState.warm_ms) until the first
+ * live process gather replaces it.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_WARM_H
+#define TM_WARM_H
+
+#include "tm_types.h"
+
+/**
+ * Value of `--warm-file PATH` on the command line.
+ * @return PATH, or NULL if the option is absent.
+ */
+const char *tm_warm_file_arg(int argc, char **argv);
+
+/**
+ * Map @p path and copy the saved process rows, system rings and app
+ * history into @p s, then set s->warm_ms to the save time. App entries
+ * are matched by name; the app history list is built first if the file
+ * has any and it is not loaded yet. Publishes nothing.
+ * @param s  Application state. Must not be NULL.
+ * @return   TM_OK, TM_ERR_IO if the file is missing or from another
+ *           build, TM_ERR_ALLOC, or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_warm_load(TmAppState *s, const char *path);
+
+/**
+ * Write the process rows, system rings and app history of @p s to
+ * @p path through a temporary file, so a crash leaves the old file.
+ * Nothing is written while the rows are still the warm snapshot.
+ * @param s  Application state. Must not be NULL.
+ * @return   TM_OK, TM_ERR_IO or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_warm_save(const TmAppState *s, const char *path);
+
+#endif /* TM_WARM_H */
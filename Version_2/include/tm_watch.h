@@ -0,0 +1,60 @@
+/**
+ * @file tm_watch.h
+ * @brief Public API for the pinned-process watch list.
+ *
+ * Pinned processes are sampled at their own rate (down to 10 Hz) through
+ * cached platform sampler handles, independently of the full process scan.
+ * Business logic only -- no Raylib symbols.
+ */
+
+#ifndef TM_WATCH_H
+#define TM_WATCH_H
+
+#include "tm_types.h"
+
+/**
+ * Pin @p proc. Its name and command line are remembered so the entry can
+ * follow the process across a restart (new PID).
+ * @param s     Application state. Must not be NULL.
+ * @param proc  Process to pin. Must not be NULL.
+ * @return      TM_OK, or TM_ERR_INVALID_ARG if full or already pinned.
+ */
+tm_result_t tm_watch_pin(TmAppState *s, const TmProcess *proc);
+
+/**
+ * Unpin the entry following @p pid.
+ * @return TM_OK or TM_ERR_INVALID_ARG if @p pid is not pinned.
+ */
+tm_result_t tm_watch_unpin(TmAppState *s, uint32_t pid);
+
+/** Return true if @p pid is currently pinned. */
+bool tm_watch_is_pinned(const TmAppState *s, uint32_t pid);
+
+/**
+ * Change the sampling interval of the entry following @p pid.
+ * @param interval_s  Seconds; clamped to TM_WATCH_INTERVAL_S at minimum.
+ * @return            TM_OK or TM_ERR_INVALID_ARG if not pinned.
+ */
+tm_result_t tm_watch_set_interval(TmAppState *s, uint32_t pid, float interval_s);
+
+/** Return true if an entry lost its process and waits for a re-match. */
+bool tm_watch_needs_rescan(const TmAppState *s);
+
+/**
+ * Re-attach entries whose process exited to a running process with the
+ * same name and command line. Call after each process list refresh.
+ * @param s  Application state. Must not be NULL.
+ */
+void tm_watch_rematch(TmAppState *s);
+
+/**
+ * Sample every entry whose interval has elapsed. Call once per frame.
+ * @param s  Application state. Must not be NULL.
+ * @return   TM_OK or TM_ERR_INVALID_ARG.
+ */
+tm_result_t tm_watch_update(TmAppState *s);
+
+/** Close all sampler handles and clear the list. */
+void tm_watch_free(TmAppState *s);
+
+#endif /* TM_WATCH_H */
@@ -8,6 +8,8 @@
 #include <string.h>
 
 #include "../../include/tm_types.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_event.h"
 #include "../../include/tm_log.h"
 
 /* -------------------------------------------------------------------------
@@ -31,7 +33,20 @@ void tm_history_list_free(TmAppState *s) {
         free(cur);
         cur = nxt;
     }
-    s->history_list = NULL;
+    free(s->history_index);
+    s->history_list  = NULL;
+    s->history_index = NULL;
+    s->history_count = 0;
+}
+
+/* Positional index over the list so rows are reachable in O(1). */
+static tm_result_t build_history_index(TmAppState *s, int count) {
+    s->history_index = (TmAppHistory **)malloc((size_t)count * sizeof(TmAppHistory *));
+    if (!s->history_index) return TM_ERR_ALLOC;
+    int i = 0;
+    for (TmAppHistory *a = s->history_list; a; a = a->next) s->history_index[i++] = a;
+    s->history_count = count;
+    return TM_OK;
 }
 
 static void init_history_entry(TmAppHistory *app, const char *name) {
@@ -42,7 +57,7 @@ static void init_history_entry(TmAppHistory *app, const char *name) {
     app->memory_kb   = 100 + (uint64_t)(rand() % 500);
     app->network_kb  = 10  + (uint64_t)(rand() % 100);
     app->history_idx = 0;
-    app->last_update = clock();
+    app->last_update = g_platform->now_s();
     app->next        = NULL;
 
     for (int j = 0; j < TM_HIST_SHORT; j++) {
@@ -61,12 +76,19 @@ tm_result_t tm_history_init(TmAppState *s) {
     int count = (int)(sizeof(k_history_apps) / sizeof(k_history_apps[0]));
     for (int i = 0; i < count; i++) {
         TmAppHistory *app = (TmAppHistory *)malloc(sizeof(TmAppHistory));
-        if (!app) return TM_ERR_ALLOC;
+        if (!app) {
+            tm_history_list_free(s);
+            return TM_ERR_ALLOC;
+        }
 
         init_history_entry(app, k_history_apps[i]);
         app->next      = s->history_list;
         s->history_list = app;
     }
+    if (build_history_index(s, count) != TM_OK) {
+        tm_history_list_free(s);
+        return TM_ERR_ALLOC;
+    }
 
     tm_log_info("App history initialised: %d entries", count);
     return TM_OK;
@@ -87,19 +109,28 @@ static void update_history_entry(TmAppHistory *app) {
     app->memory_history[app->history_idx]   = app->memory_kb;
     app->network_history[app->history_idx]  = app->network_kb;
     app->history_idx = (app->history_idx + 1) % TM_HIST_SHORT;
-    app->last_update = clock();
+    app->sample_seq++;
+    app->last_update = g_platform->now_s();
 }
 
 tm_result_t tm_history_tick(TmAppState *s) {
     if (!s) return TM_ERR_INVALID_ARG;
 
-    TmAppHistory *cur = s->history_list;
+    TmAppHistory *cur     = s->history_list;
+    bool          updated = false;
     while (cur) {
-        float delta = (float)(clock() - cur->last_update) / (float)CLOCKS_PER_SEC;
+        float delta = (float)(g_platform->now_s() - cur->last_update);
         if (delta >= TM_HISTORY_UPDATE_INTERVAL_S) {
             update_history_entry(cur);
+            updated = true;
         }
         cur = cur->next;
     }
+    if (updated) tm_event_publish(TM_EVENT_HISTORY_TICKED);
     return TM_OK;
 }
+
+TmAppHistory *tm_history_at(const TmAppState *s, int index) {
+    if (!s || index < 0 || index >= s->history_count) return NULL;
+    return s->history_index[index];
+}
@@ -0,0 +1,156 @@
+/**
+ * @file tm_burst.c
+ * @brief Threshold-triggered burst sampling -- business logic, no Raylib.
+ */
+
+#include <string.h>
+
+#include "../../include/tm_burst.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_event.h"
+#include "../../include/tm_log.h"
+
+/* -------------------------------------------------------------------------
+ * Configuration
+ * ---------------------------------------------------------------------- */
+
+void tm_burst_init(TmBurst *b) {
+    if (!b) return;
+    memset(b, 0, sizeof(*b));
+    b->interval_s = TM_BURST_INTERVAL_S;
+    b->window_s   = TM_BURST_WINDOW_S;
+
+    tm_burst_add_trigger(b, (TmBurstTrigger){
+        TM_TRIGGER_SYSTEM_CPU, TM_BURST_CPU_PERCENT, 0.0f });
+    tm_burst_add_trigger(b, (TmBurstTrigger){
+        TM_TRIGGER_RSS_GROWTH, (double)TM_BURST_RSS_GROWTH_B, TM_BURST_RSS_WINDOW_S });
+}
+
+void tm_burst_clear_triggers(TmBurst *b) {
+    if (b) b->trigger_count = 0;
+}
+
+tm_result_t tm_burst_add_trigger(TmBurst *b, TmBurstTrigger t) {
+    if (!b || b->trigger_count >= TM_MAX_TRIGGERS || t.threshold <= 0.0)
+        return TM_ERR_INVALID_ARG;
+    if (t.kind == TM_TRIGGER_RSS_GROWTH && t.window_s <= 0.0f)
+        return TM_ERR_INVALID_ARG;
+    b->triggers[b->trigger_count++] = t;
+    return TM_OK;
+}
+
+/* -------------------------------------------------------------------------
+ * Trigger evaluation
+ * ---------------------------------------------------------------------- */
+
+void tm_burst_start(TmAppState *s, uint32_t pid) {
+    if (!s) return;
+    TmBurst *b   = &s->burst;
+    double   now = g_platform->now_s();
+
+    if (!b->is_active) {
+        uint32_t seq = b->ring.seq;  /* keep counting so cached graphs redraw */
+        memset(&b->ring, 0, sizeof(b->ring));
+        b->ring.seq = seq + 1;
+        b->is_active   = true;
+        b->started_at  = now;
+        b->last_sample = 0.0;
+        b->pid         = pid;
+        g_platform->sample_cpu(&b->cpu_ticks);     /* first sample covers one interval */
+        tm_log_warn("Burst capture started (pid %u, %.0f ms for %.0f s)",
+                    pid, b->interval_s * 1000.0f, b->window_s);
+    } else if (pid && !b->pid) {
+        b->pid = pid;
+    }
+    b->ends_at = now + b->window_s;
+}
+
+/* Return true if @p p grew more than @p t allows within its window. */
+static bool rss_grew(TmProcess *p, const TmBurstTrigger *t, double now) {
+    TmProcessTrend *tr = &p->trend;
+    if (tr->rss_base_t == 0.0 || now - tr->rss_base_t > t->window_s
+        || p->memory_bytes < tr->rss_base_bytes) {
+        tr->rss_base_bytes = p->memory_bytes;
+        tr->rss_base_t     = now;
+        return false;
+    }
+    if ((double)(p->memory_bytes - tr->rss_base_bytes) <= t->threshold) return false;
+
+    /* Re-arm from the new level so sustained growth fires once per step */
+    tr->rss_base_bytes = p->memory_bytes;
+    tr->rss_base_t     = now;
+    return true;
+}
+
+void tm_burst_check_system(TmAppState *s) {
+    if (!s) return;
+    for (int i = 0; i < s->burst.trigger_count; i++) {
+        const TmBurstTrigger *t = &s->burst.triggers[i];
+        if (t->kind == TM_TRIGGER_SYSTEM_CPU
+            && (double)s->perf.cpu_percent > t->threshold) {
+            tm_burst_start(s, 0);
+            return;
+        }
+    }
+}
+
+void tm_burst_check_processes(TmAppState *s) {
+    if (!s) return;
+    double now = g_platform->now_s();
+    for (int i = 0; i < s->burst.trigger_count; i++) {
+        const TmBurstTrigger *t = &s->burst.triggers[i];
+        if (t->kind != TM_TRIGGER_RSS_GROWTH) continue;
+        for (TmProcess *p = s->process_list; p; p = p->next) {
+            if (rss_grew(p, t, now)) tm_burst_start(s, p->pid);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * High-resolution sampling
+ * ---------------------------------------------------------------------- */
+
+static void push_sample(TmBurst *b) {
+    TmBurstRing *r = &b->ring;
+    uint64_t used_kb = 0, total_kb = 0;
+    g_platform->query_memory(&used_kb, &total_kb);
+
+    uint64_t rss = 0;
+    if (b->pid) g_platform->query_process_rss(b->pid, &rss);
+
+    /* Unreadable memory (0/0) repeats the last reading rather than dip to 0 */
+    if (total_kb == 0 && r->count > 0)
+        used_kb = r->mem_kb[(r->idx + TM_BURST_RING_LEN - 1) % TM_BURST_RING_LEN];
+
+    r->cpu[r->idx]      = g_platform->sample_cpu(&b->cpu_ticks);
+    r->mem_kb[r->idx]   = used_kb;
+    r->proc_rss[r->idx] = rss;
+    r->idx = (r->idx + 1) % TM_BURST_RING_LEN;
+    r->seq++;
+    if (r->count < TM_BURST_RING_LEN) r->count++;
+}
+
+tm_result_t tm_burst_update(TmAppState *s) {
+    if (!s) return TM_ERR_INVALID_ARG;
+    TmBurst *b = &s->burst;
+    if (!b->is_active) return TM_OK;
+
+    double now = g_platform->now_s();
+    if (now >= b->ends_at) {
+        b->is_active = false;
+        tm_log_info("Burst capture finished: %d samples", b->ring.count);
+        tm_event_publish(TM_EVENT_BURST_SAMPLED);
+        return TM_OK;
+    }
+    if (now - b->last_sample >= b->interval_s) {
+        b->last_sample = now;
+        push_sample(b);
+        tm_event_publish(TM_EVENT_BURST_SAMPLED);
+    }
+    return TM_OK;
+}
+
+bool tm_burst_has_capture(const TmBurst *b) {
+    if (!b || b->ring.count == 0) return false;
+    return b->is_active || g_platform->now_s() - b->ends_at < TM_BURST_HOLD_S;
+}
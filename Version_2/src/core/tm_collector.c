@@ -0,0 +1,233 @@
+/**
+ * @file tm_collector.c
+ * @brief Tab-aware collection scheduler -- business logic, no Raylib.
+ *
+ * The baseline (system CPU/memory and app-history rings) is sampled on
+ * every interval so history never has gaps; the heavier sets are only
+ * gathered while a visible tab declares it needs them.
+ *
+ * The first process gather may run on a worker thread (tm_collector_prime)
+ * so the window can draw before `ps` returns. Until it lands nothing else
+ * is sampled: platform adapters are never entered from two threads.
+ */
+
+#include "../../include/tm_collector.h"
+#include "../../include/tm_process.h"
+#include "../../include/tm_perf.h"
+#include "../../include/tm_app_history.h"
+#include "../../include/tm_burst.h"
+#include "../../include/tm_watch.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+/* First gather, handed over under s_prime_lock */
+static TmThread    *s_prime_thread = NULL;
+static TmMutex     *s_prime_lock   = NULL;
+static TmProcess   *s_prime_list;
+static int          s_prime_count;
+static tm_result_t  s_prime_result;
+static bool         s_prime_done;
+
+/* -------------------------------------------------------------------------
+ * Helpers
+ * ---------------------------------------------------------------------- */
+
+static float seconds_since(double t) {
+    return (float)(g_platform->now_s() - t);
+}
+
+/* Return the needed sets whose interval has elapsed. */
+static uint32_t due_sets(const TmCollector *c) {
+    uint32_t due = TM_DATA_NONE;
+    if (seconds_since(c->last_system) >= TM_PERF_UPDATE_INTERVAL_S)
+        due |= c->needs & (TM_DATA_BASELINE | TM_DATA_PERF_DETAIL);
+    if ((c->needs & TM_DATA_PROCESSES)
+        && seconds_since(c->last_processes) >= TM_PROCESS_REFRESH_INTERVAL_S)
+        due |= TM_DATA_PROCESSES;
+    if ((c->needs & TM_DATA_PROC_DETAIL)
+        && seconds_since(c->last_detail) >= TM_DETAIL_REFRESH_INTERVAL_S)
+        due |= TM_DATA_PROC_DETAIL;
+    return due;
+}
+
+/* Fetch detail columns for the visible rows plus the prefetch margin. */
+static tm_result_t fetch_view_details(TmAppState *s, bool only_missing) {
+    const TmCollector *c = &s->collector;
+    return tm_process_fetch_details(s, c->view_first - TM_DETAIL_PREFETCH_ROWS,
+                                    c->view_count + 2 * TM_DETAIL_PREFETCH_ROWS,
+                                    only_missing);
+}
+
+/* -------------------------------------------------------------------------
+ * Priming
+ * ---------------------------------------------------------------------- */
+
+static void prime_run(void *arg) {
+    (void)arg;
+    TmProcess  *list;
+    int         count;
+    tm_result_t r = tm_process_list_gather(&list, &count);
+
+    g_platform->mutex_lock(s_prime_lock);
+    s_prime_list   = list;
+    s_prime_count  = count;
+    s_prime_result = r;
+    s_prime_done   = true;
+    g_platform->mutex_unlock(s_prime_lock);
+}
+
+static void prime_join(void) {
+    g_platform->thread_join(s_prime_thread);
+    g_platform->mutex_destroy(s_prime_lock);
+    s_prime_thread = NULL;
+    s_prime_lock   = NULL;
+}
+
+/* Adopt the first gather if it is done; false while it is still running. */
+static bool prime_landed(TmAppState *s) {
+    g_platform->mutex_lock(s_prime_lock);
+    bool done = s_prime_done;
+    g_platform->mutex_unlock(s_prime_lock);
+    if (!done) return false;
+    prime_join();
+
+    TmCollector *c = &s->collector;
+    c->is_priming     = false;
+    c->last_processes = g_platform->now_s();
+    c->view_dirty     = true;
+    /* Everything else the view needs is due now, not one interval later */
+    c->pending        = (c->pending | c->needs) & ~(uint32_t)TM_DATA_PROCESSES;
+    s->warm_ms        = 0;
+
+    if (s_prime_result != TM_OK || tm_process_list_adopt(s, s_prime_list, s_prime_count) != TM_OK) {
+        tm_log_warn("Initial process list refresh failed");
+        return true;
+    }
+    tm_burst_check_processes(s);
+    tm_watch_rematch(s);
+    return true;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+void tm_collector_init(TmCollector *c) {
+    if (!c) return;
+    double now = g_platform->now_s();
+    c->needs          = TM_DATA_BASELINE;
+    c->pinned         = TM_DATA_NONE;
+    c->pending        = TM_DATA_NONE;
+    c->last_system    = now;
+    c->last_processes = now;
+    c->last_detail    = now;
+    c->view_first     = 0;
+    c->view_count     = 0;
+    c->view_dirty     = false;
+    c->is_priming     = false;
+}
+
+void tm_collector_set_needs(TmAppState *s, uint32_t needs) {
+    if (!s) return;
+    TmCollector *c = &s->collector;
+    needs      |= TM_DATA_BASELINE | c->pinned;
+    c->pending |= needs & ~c->needs;
+    c->needs    = needs;
+}
+
+void tm_collector_pin(TmAppState *s, uint32_t sets) {
+    if (!s) return;
+    s->collector.pinned |= sets;
+    tm_collector_set_needs(s, s->collector.needs);
+}
+
+void tm_collector_set_viewport(TmAppState *s, int first, int count) {
+    if (!s) return;
+    TmCollector *c = &s->collector;
+    if (first == c->view_first && count == c->view_count) return;
+    c->view_first = first;
+    c->view_count = count;
+    c->view_dirty = true;
+}
+
+tm_result_t tm_collector_collect(TmAppState *s, uint32_t sets) {
+    if (!s) return TM_ERR_INVALID_ARG;
+    TmCollector *c = &s->collector;
+    if (c->is_priming) {
+        c->pending |= sets;     /* gathered once the first pass lands */
+        return TM_OK;
+    }
+    c->pending &= ~sets;
+
+    if (sets & TM_DATA_PROCESSES) {
+        c->last_processes = g_platform->now_s();
+        c->view_dirty     = true;  /* new PIDs have no detail yet */
+        TM_CHECK(tm_process_list_refresh(s));
+        tm_burst_check_processes(s);
+        tm_watch_rematch(s);
+    }
+    if (sets & TM_DATA_PROC_DETAIL) {
+        c->last_detail = g_platform->now_s();
+        c->view_dirty  = false;
+        TM_CHECK(fetch_view_details(s, false));
+    }
+    if (sets & (TM_DATA_SYSTEM | TM_DATA_PERF_DETAIL)) {
+        if (sets & TM_DATA_SYSTEM) c->last_system = g_platform->now_s();
+        TM_CHECK(tm_perf_sample(s, sets));
+        if (sets & TM_DATA_SYSTEM) tm_burst_check_system(s);
+    }
+    if (sets & TM_DATA_APP_HISTORY) {
+        TM_CHECK(tm_history_tick(s));
+    }
+    return TM_OK;
+}
+
+tm_result_t tm_collector_prime(TmAppState *s) {
+    if (!s) return TM_ERR_INVALID_ARG;
+    if (s->collector.is_priming) return TM_OK;
+
+    s_prime_done   = false;
+    s_prime_list   = NULL;
+    s_prime_count  = 0;
+    s_prime_lock   = g_platform->mutex_create();
+    s_prime_thread = s_prime_lock ? g_platform->thread_start(prime_run, NULL) : NULL;
+    if (!s_prime_thread) {
+        if (s_prime_lock) g_platform->mutex_destroy(s_prime_lock);
+        s_prime_lock = NULL;
+        tm_log_warn("No worker thread; gathering the process list before the first frame");
+        return tm_collector_collect(s, TM_DATA_PROCESSES);
+    }
+    s->collector.is_priming = true;
+    return TM_OK;
+}
+
+void tm_collector_shutdown(TmAppState *s) {
+    if (!s || !s->collector.is_priming) return;
+    prime_join();
+    tm_process_nodes_free(s_prime_list);
+    s_prime_list            = NULL;
+    s->collector.is_priming = false;
+}
+
+tm_result_t tm_collector_update(TmAppState *s) {
+    if (!s) return TM_ERR_INVALID_ARG;
+    if (s->collector.is_priming && !prime_landed(s)) return TM_OK;
+    TM_CHECK(tm_burst_update(s));
+    TM_CHECK(tm_watch_update(s));
+
+    TmCollector *c    = &s->collector;
+    uint32_t     sets = due_sets(c) | c->pending;
+
+    /* A watched process exited: keep scanning so its restart is found */
+    if (tm_watch_needs_rescan(s)
+        && seconds_since(c->last_processes) >= TM_PROCESS_REFRESH_INTERVAL_S)
+        sets |= TM_DATA_PROCESSES;
+    if (sets != TM_DATA_NONE) TM_CHECK(tm_collector_collect(s, sets));
+
+    /* Rows scrolled into view: fill only what is not cached yet */
+    if (c->view_dirty && (c->needs & TM_DATA_PROC_DETAIL)) {
+        c->view_dirty = false;
+        TM_CHECK(fetch_view_details(s, true));
+    }
+    return TM_OK;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file tm_event.c
+ * @brief Typed, coalescing event bus -- business logic, no Raylib.
+ *
+ * Each subscriber's queue is a pending TmEventType mask plus a counter:
+ * publications that arrive before the previous one was delivered merge
+ * into it instead of queueing, so memory per subscriber is constant and a
+ * slow consumer only ever sees the latest state. One lock guards the
+ * subscriber table; callbacks always run with it released.
+ */
+
+#include <stdlib.h>
+
+#include "../../include/tm_event.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+/* -------------------------------------------------------------------------
+ * Subscriber table (module-private)
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    int            id;
+    uint32_t       types;
+    TmDispatchMode mode;
+    TmEventFn      fn;
+    void          *user;
+
+    /* Coalesced queue, guarded by s_lock */
+    uint32_t       pending;
+    uint32_t       pending_count;
+    uint64_t       pending_seq;
+
+    /* TM_DISPATCH_THREAD only */
+    TmThread      *thread;
+    TmCond        *wake;
+    bool           stop;
+} TmSubscriber;
+
+static TmMutex       *s_lock     = NULL;
+static TmSubscriber **s_subs     = NULL;
+static int            s_count    = 0;
+static int            s_capacity = 0;
+static int            s_next_id  = 1;
+static uint64_t       s_seq      = 0;
+
+/* Move the pending queue of @p sub into @p ev. Caller holds s_lock. */
+static bool take_pending(TmSubscriber *sub, TmEvent *ev) {
+    if (sub->pending == TM_EVENT_NONE) return false;
+    ev->types  = sub->pending;
+    ev->count  = sub->pending_count;
+    ev->seq    = sub->pending_seq;
+    ev->state  = NULL;
+    sub->pending       = TM_EVENT_NONE;
+    sub->pending_count = 0;
+    return true;
+}
+
+static void worker_main(void *arg) {
+    TmSubscriber *sub = arg;
+    TmEvent       ev;
+
+    g_platform->mutex_lock(s_lock);
+    for (;;) {
+        while (!sub->stop && sub->pending == TM_EVENT_NONE)
+            g_platform->cond_wait(sub->wake, s_lock);
+        if (sub->stop) break;
+
+        take_pending(sub, &ev);
+        g_platform->mutex_unlock(s_lock);
+        sub->fn(&ev, sub->user);
+        g_platform->mutex_lock(s_lock);
+    }
+    g_platform->mutex_unlock(s_lock);
+}
+
+static void free_subscriber(TmSubscriber *sub) {
+    if (sub->thread) g_platform->thread_join(sub->thread);
+    if (sub->wake)   g_platform->cond_destroy(sub->wake);
+    free(sub);
+}
+
+static tm_result_t grow_table(void) {
+    if (s_count < s_capacity) return TM_OK;
+    int            cap  = s_capacity ? s_capacity * 2 : 8;
+    TmSubscriber **subs = realloc(s_subs, (size_t)cap * sizeof(*subs));
+    if (!subs) return TM_ERR_ALLOC;
+    s_subs     = subs;
+    s_capacity = cap;
+    return TM_OK;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+tm_result_t tm_event_init(void) {
+    if (s_lock) return TM_OK;
+    s_lock = g_platform->mutex_create();
+    return s_lock ? TM_OK : TM_ERR_ALLOC;
+}
+
+tm_result_t tm_event_subscribe(uint32_t types, TmDispatchMode mode,
+                               TmEventFn fn, void *user, int *out_id) {
+    if (!s_lock || !fn || types == TM_EVENT_NONE) return TM_ERR_INVALID_ARG;
+
+    TmSubscriber *sub = calloc(1, sizeof(*sub));
+    if (!sub) return TM_ERR_ALLOC;
+    sub->types = types;
+    sub->mode  = mode;
+    sub->fn    = fn;
+    sub->user  = user;
+
+    if (mode == TM_DISPATCH_THREAD) {
+        sub->wake = g_platform->cond_create();
+        if (!sub->wake) {
+            free(sub);
+            return TM_ERR_ALLOC;
+        }
+    }
+
+    g_platform->mutex_lock(s_lock);
+    tm_result_t r = grow_table();
+    if (r == TM_OK) {
+        sub->id = s_next_id++;
+        s_subs[s_count++] = sub;
+    }
+    g_platform->mutex_unlock(s_lock);
+    if (r != TM_OK) {
+        free_subscriber(sub);
+        return r;
+    }
+
+    if (mode == TM_DISPATCH_THREAD) {
+        sub->thread = g_platform->thread_start(worker_main, sub);
+        if (!sub->thread) {
+            tm_log_error("Event worker thread failed to start");
+            tm_event_unsubscribe(sub->id);
+            return TM_ERR_PLATFORM;
+        }
+    }
+    if (out_id) *out_id = sub->id;
+    return TM_OK;
+}
+
+tm_result_t tm_event_unsubscribe(int id) {
+    if (!s_lock) return TM_ERR_INVALID_ARG;
+
+    TmSubscriber *sub = NULL;
+    g_platform->mutex_lock(s_lock);
+    for (int i = 0; i < s_count; i++) {
+        if (s_subs[i]->id != id) continue;
+        sub = s_subs[i];
+        s_subs[i] = s_subs[--s_count];
+        sub->stop = true;
+        if (sub->wake) g_platform->cond_broadcast(sub->wake);
+        break;
+    }
+    g_platform->mutex_unlock(s_lock);
+
+    if (!sub) return TM_ERR_INVALID_ARG;
+    free_subscriber(sub);
+    return TM_OK;
+}
+
+void tm_event_publish(uint32_t types) {
+    if (!s_lock || types == TM_EVENT_NONE) return;
+
+    g_platform->mutex_lock(s_lock);
+    s_seq++;
+    for (int i = 0; i < s_count; i++) {
+        TmSubscriber *sub  = s_subs[i];
+        uint32_t      hits = types & sub->types;
+        if (hits == TM_EVENT_NONE) continue;
+
+        sub->pending      |= hits;
+        sub->pending_count++;
+        sub->pending_seq   = s_seq;
+        if (sub->wake) g_platform->cond_broadcast(sub->wake);
+    }
+    g_platform->mutex_unlock(s_lock);
+}
+
+void tm_event_dispatch(const TmAppState *s) {
+    if (!s_lock || !s) return;
+
+    /* Re-lock per subscriber so callbacks may publish */
+    for (int i = 0;; i++) {
+        TmSubscriber *sub = NULL;
+        TmEvent       ev;
+
+        g_platform->mutex_lock(s_lock);
+        if (i >= s_count) {
+            g_platform->mutex_unlock(s_lock);
+            break;
+        }
+        if (s_subs[i]->mode == TM_DISPATCH_UI && take_pending(s_subs[i], &ev))
+            sub = s_subs[i];
+        g_platform->mutex_unlock(s_lock);
+
+        if (sub) {
+            ev.state = s;
+            sub->fn(&ev, sub->user);
+        }
+    }
+}
+
+void tm_event_shutdown(void) {
+    if (!s_lock) return;
+    while (s_count > 0) tm_event_unsubscribe(s_subs[s_count - 1]->id);
+    free(s_subs);
+    s_subs     = NULL;
+    s_capacity = 0;
+    g_platform->mutex_destroy(s_lock);
+    s_lock = NULL;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file tm_export.c
+ * @brief JSON Lines / CSV snapshot writer -- business logic, no Raylib.
+ *
+ * Every value is formatted by hand into the writer's fixed buffer, which
+ * is handed to stdio (or a memory sink) only when full or on
+ * tm_writer_flush(). A process row costs a few short memcpy()s and digit
+ * loops; nothing allocates once a memory sink has reached its size.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_export.h"
+#include "../../include/tm_process.h"
+#include "../../include/tm_log.h"
+
+/* -------------------------------------------------------------------------
+ * Writer
+ * ---------------------------------------------------------------------- */
+
+/* Append to the memory sink, doubling it past the high-water mark */
+static size_t mem_append(TmByteBuf *m, const char *p, size_t n) {
+    if (m->len + n > m->cap) {
+        size_t cap = m->cap ? m->cap : TM_EXPORT_BUF_BYTES;
+        while (cap < m->len + n) cap *= 2;
+        char *data = (char *)realloc(m->data, cap);
+        if (!data) return 0;
+        m->data = data;
+        m->cap  = cap;
+    }
+    memcpy(m->data + m->len, p, n);
+    m->len += n;
+    return n;
+}
+
+static void sink(TmWriter *w, const char *p, size_t n) {
+    size_t done = w->fp ? fwrite(p, 1, n, w->fp) : mem_append(w->mem, p, n);
+    if (done != n) w->failed = true;
+    w->bytes += done;
+}
+
+static void drain(TmWriter *w) {
+    if (w->len == 0) return;
+    sink(w, w->buf, w->len);
+    w->len = 0;
+}
+
+/* Room for @p n more bytes (n <= TM_EXPORT_BUF_BYTES); returns the tail. */
+static char *reserve(TmWriter *w, size_t n) {
+    if (w->len + n > sizeof(w->buf)) drain(w);
+    return w->buf + w->len;
+}
+
+void tm_writer_init(TmWriter *w, FILE *fp) {
+    if (!w) return;
+    w->fp     = fp;
+    w->mem    = NULL;
+    w->len    = 0;
+    w->failed = false;
+    w->bytes  = 0;
+}
+
+void tm_writer_init_mem(TmWriter *w, TmByteBuf *out) {
+    if (!w || !out) return;
+    tm_writer_init(w, NULL);
+    w->mem   = out;
+    out->len = 0;
+}
+
+tm_result_t tm_writer_flush(TmWriter *w) {
+    if (!w || (!w->fp && !w->mem)) return TM_ERR_INVALID_ARG;
+    drain(w);
+    if (w->fp && fflush(w->fp) != 0) w->failed = true;
+    return w->failed ? TM_ERR_IO : TM_OK;
+}
+
+void tm_writer_bytes(TmWriter *w, const char *p, size_t n) {
+    if (n > sizeof(w->buf)) {
+        drain(w);
+        sink(w, p, n);
+        return;
+    }
+    memcpy(reserve(w, n), p, n);
+    w->len += n;
+}
+
+void tm_writer_str(TmWriter *w, const char *str) {
+    tm_writer_bytes(w, str, strlen(str));
+}
+
+void tm_writer_u64(TmWriter *w, uint64_t v) {
+    char  tmp[20];
+    char *end = tmp + sizeof(tmp);
+    char *p   = end;
+    do {
+        *--p = (char)('0' + v % 10);
+        v   /= 10;
+    } while (v);
+    tm_writer_bytes(w, p, (size_t)(end - p));
+}
+
+void tm_writer_fixed(TmWriter *w, double v, int decimals) {
+    static const uint64_t k_pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+    if (decimals < 0) decimals = 0;
+    if (decimals > 6) decimals = 6;
+    if (v != v) v = 0.0;                    /* NaN has no JSON spelling */
+
+    bool neg = v < 0.0;
+    if (neg) v = -v;
+    if (v > 1e12) v = 1e12;                 /* keep v * scale inside uint64 */
+
+    uint64_t scale = k_pow10[decimals];
+    uint64_t x     = (uint64_t)(v * (double)scale + 0.5);
+    if (neg && x != 0) tm_writer_bytes(w, "-", 1);
+    tm_writer_u64(w, x / scale);
+    if (decimals == 0) return;
+
+    char    *p    = reserve(w, (size_t)decimals + 1);
+    uint64_t frac = x % scale;
+    p[0] = '.';
+    for (int i = decimals; i > 0; i--) {
+        p[i]  = (char)('0' + frac % 10);
+        frac /= 10;
+    }
+    w->len += (size_t)decimals + 1;
+}
+
+void tm_writer_json_str(TmWriter *w, const char *str) {
+    static const char k_hex[] = "0123456789abcdef";
+    tm_writer_bytes(w, "\"", 1);
+    for (const unsigned char *c = (const unsigned char *)str; *c; c++) {
+        char *p = reserve(w, 6);
+        size_t n = 1;
+        switch (*c) {
+            case '"':  p[0] = '\\'; p[1] = '"';  n = 2; break;
+            case '\\': p[0] = '\\'; p[1] = '\\'; n = 2; break;
+            case '\n': p[0] = '\\'; p[1] = 'n';  n = 2; break;
+            case '\r': p[0] = '\\'; p[1] = 'r';  n = 2; break;
+            case '\t': p[0] = '\\'; p[1] = 't';  n = 2; break;
+            default:
+                if (*c < 0x20) {
+                    memcpy(p, "\\u00", 4);
+                    p[4] = k_hex[*c >> 4];
+                    p[5] = k_hex[*c & 0xF];
+                    n    = 6;
+                } else {
+                    p[0] = (char)*c;
+                }
+                break;
+        }
+        w->len += n;
+    }
+    tm_writer_bytes(w, "\"", 1);
+}
+
+void tm_writer_csv_str(TmWriter *w, const char *str) {
+    if (!strpbrk(str, ",\"\r\n")) {
+        tm_writer_str(w, str);
+        return;
+    }
+    tm_writer_bytes(w, "\"", 1);
+    for (const char *c = str; *c; c++) {
+        if (*c == '"') tm_writer_bytes(w, "\"\"", 2);
+        else           tm_writer_bytes(w, c, 1);
+    }
+    tm_writer_bytes(w, "\"", 1);
+}
+
+/* -------------------------------------------------------------------------
+ * Field table
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    const char *name;
+    bool        is_system;  /* system record rather than process record */
+    uint32_t    sets;       /* TmDataSet mask that fills it */
+} TmFieldSpec;
+
+static const TmFieldSpec k_fields[TM_FIELD_COUNT] = {
+    [TM_FIELD_PID]          = { "pid",          false, TM_DATA_PROCESSES },
+    [TM_FIELD_NAME]         = { "name",         false, TM_DATA_PROCESSES },
+    [TM_FIELD_CPU]          = { "cpu",          false, TM_DATA_PROCESSES },
+    [TM_FIELD_MEM_KB]       = { "mem_kb",       false, TM_DATA_PROCESSES },
+    [TM_FIELD_PSS_KB]       = { "pss_kb",       false, TM_DATA_PROCESSES | TM_DATA_PROC_DETAIL },
+    [TM_FIELD_FDS]          = { "fds",          false, TM_DATA_PROCESSES | TM_DATA_PROC_DETAIL },
+    [TM_FIELD_IO_BYTES]     = { "io_bytes",     false, TM_DATA_PROCESSES | TM_DATA_PROC_DETAIL },
+    [TM_FIELD_CMDLINE]      = { "cmdline",      false, TM_DATA_PROCESSES | TM_DATA_PROC_DETAIL },
+    [TM_FIELD_CPU_TOTAL]    = { "cpu_total",    true,  TM_DATA_SYSTEM },
+    [TM_FIELD_MEM_USED_KB]  = { "mem_used_kb",  true,  TM_DATA_SYSTEM },
+    [TM_FIELD_MEM_TOTAL_KB] = { "mem_total_kb", true,  TM_DATA_SYSTEM },
+    [TM_FIELD_MEM_AVAIL_KB] = { "mem_avail_kb", true,  TM_DATA_SYSTEM },
+    [TM_FIELD_NPROCS]       = { "nprocs",       true,  TM_DATA_PROCESSES },
+};
+
+#define FIELD_BIT(f) (1u << (f))
+
+static uint32_t fields_of_kind(uint32_t fields, bool is_system) {
+    uint32_t out = 0;
+    for (int f = 0; f < TM_FIELD_COUNT; f++) {
+        if ((fields & FIELD_BIT(f)) && k_fields[f].is_system == is_system)
+            out |= FIELD_BIT(f);
+    }
+    return out;
+}
+
+const char *tm_export_field_name(TmExportField f) {
+    return ((unsigned)f < TM_FIELD_COUNT) ? k_fields[f].name : "?";
+}
+
+tm_result_t tm_export_parse_fields(const char *list, uint32_t *out) {
+    if (!list || !out) return TM_ERR_INVALID_ARG;
+    uint32_t fields = 0;
+    const char *p = list;
+    while (*p) {
+        while (*p == ',' || *p == ' ') p++;
+        size_t n = strcspn(p, ", ");
+        if (n == 0) break;
+
+        int match = -1;
+        for (int f = 0; f < TM_FIELD_COUNT && match < 0; f++) {
+            if (strlen(k_fields[f].name) == n && strncmp(p, k_fields[f].name, n) == 0)
+                match = f;
+        }
+        if (n == 3 && strncmp(p, "all", 3) == 0) {
+            fields |= FIELD_BIT(TM_FIELD_COUNT) - 1u;
+        } else if (match < 0) {
+            tm_log_error("Unknown field '%.*s'", (int)n, p);
+            return TM_ERR_INVALID_ARG;
+        } else {
+            fields |= FIELD_BIT(match);
+        }
+        p += n;
+    }
+    if (fields == 0) return TM_ERR_INVALID_ARG;
+    *out = fields;
+    return TM_OK;
+}
+
+uint32_t tm_export_data_sets(uint32_t fields) {
+    uint32_t sets = TM_DATA_NONE;
+    for (int f = 0; f < TM_FIELD_COUNT; f++) {
+        if (fields & FIELD_BIT(f)) sets |= k_fields[f].sets;
+    }
+    return sets;
+}
+
+/* -------------------------------------------------------------------------
+ * Records
+ * ---------------------------------------------------------------------- */
+
+static void write_text(TmWriter *w, const TmExportConfig *cfg, const char *str) {
+    if (cfg->format == TM_EXPORT_JSONL) tm_writer_json_str(w, str);
+    else                                tm_writer_csv_str(w, str);
+}
+
+/* Missing value: JSON null, empty CSV cell */
+static void write_null(TmWriter *w, const TmExportConfig *cfg) {
+    if (cfg->format == TM_EXPORT_JSONL) tm_writer_bytes(w, "null", 4);
+}
+
+static void write_value(TmWriter *w, const TmExportConfig *cfg, TmExportField f,
+                        const TmAppState *s, const TmProcess *p) {
+    const TmPerfData *d = &s->perf;
+    bool has_detail     = p && p->detail.is_valid;
+    switch (f) {
+        case TM_FIELD_PID:          tm_writer_u64(w, p->pid);                         break;
+        case TM_FIELD_NAME:         write_text(w, cfg, p->name);                      break;
+        case TM_FIELD_CPU:          tm_writer_fixed(w, p->cpu_interval, 1);           break;
+        case TM_FIELD_MEM_KB:       tm_writer_u64(w, p->memory_bytes / 1024);         break;
+        case TM_FIELD_PSS_KB:
+            if (has_detail) tm_writer_u64(w, p->detail.pss_kb);
+            else            write_null(w, cfg);
+            break;
+        case TM_FIELD_FDS:
+            if (has_detail && p->detail.fd_count >= 0)
+                tm_writer_u64(w, (uint64_t)p->detail.fd_count);
+            else
+                write_null(w, cfg);
+            break;
+        case TM_FIELD_IO_BYTES:
+            if (has_detail) tm_writer_u64(w, p->detail.io_bytes);
+            else            write_null(w, cfg);
+            break;
+        case TM_FIELD_CMDLINE:
+            if (has_detail) write_text(w, cfg, p->detail.cmdline);
+            else            write_null(w, cfg);
+            break;
+        case TM_FIELD_CPU_TOTAL:    tm_writer_fixed(w, d->cpu_percent, 1);            break;
+        case TM_FIELD_MEM_USED_KB:
+        case TM_FIELD_MEM_TOTAL_KB:
+        case TM_FIELD_MEM_AVAIL_KB:
+            if (d->mem_total_kb == 0)              write_null(w, cfg);  /* not readable */
+            else if (f == TM_FIELD_MEM_USED_KB)    tm_writer_u64(w, d->mem_used_kb);
+            else if (f == TM_FIELD_MEM_TOTAL_KB)   tm_writer_u64(w, d->mem_total_kb);
+            else                                   tm_writer_u64(w, d->mem_available_kb);
+            break;
+        case TM_FIELD_NPROCS:       tm_writer_u64(w, (uint64_t)s->process_count);     break;
+        default:                                                                      break;
+    }
+}
+
+/*
+ * One record. CSV rows carry every selected column so all rows line up
+ * with the header; columns of the other record kind are left empty.
+ */
+static void write_record(TmWriter *w, const TmExportConfig *cfg, uint64_t ts_ms,
+                         const TmAppState *s, const TmProcess *p) {
+    bool        is_system = (p == NULL);
+    const char *kind      = is_system ? "system" : "process";
+
+    if (cfg->format == TM_EXPORT_JSONL) {
+        tm_writer_bytes(w, "{\"ts\":", 6);
+        tm_writer_u64(w, ts_ms);
+        tm_writer_bytes(w, ",\"record\":\"", 11);
+        tm_writer_str(w, kind);
+        tm_writer_bytes(w, "\"", 1);
+        for (int f = 0; f < TM_FIELD_COUNT; f++) {
+            if (!(cfg->fields & FIELD_BIT(f)) || k_fields[f].is_system != is_system)
+                continue;
+            tm_writer_bytes(w, ",\"", 2);
+            tm_writer_str(w, k_fields[f].name);
+            tm_writer_bytes(w, "\":", 2);
+            write_value(w, cfg, (TmExportField)f, s, p);
+        }
+        tm_writer_bytes(w, "}\n", 2);
+    } else {
+        tm_writer_u64(w, ts_ms);
+        tm_writer_bytes(w, ",", 1);
+        tm_writer_str(w, kind);
+        for (int f = 0; f < TM_FIELD_COUNT; f++) {
+            if (!(cfg->fields & FIELD_BIT(f))) continue;
+            tm_writer_bytes(w, ",", 1);
+            if (k_fields[f].is_system == is_system)
+                write_value(w, cfg, (TmExportField)f, s, p);
+        }
+        tm_writer_bytes(w, "\n", 1);
+    }
+}
+
+void tm_export_header(TmWriter *w, const TmExportConfig *cfg) {
+    if (!w || !cfg || cfg->format != TM_EXPORT_CSV) return;
+    tm_writer_str(w, "ts,record");
+    for (int f = 0; f < TM_FIELD_COUNT; f++) {
+        if (!(cfg->fields & FIELD_BIT(f))) continue;
+        tm_writer_bytes(w, ",", 1);
+        tm_writer_str(w, k_fields[f].name);
+    }
+    tm_writer_bytes(w, "\n", 1);
+}
+
+int tm_export_snapshot(TmWriter *w, const TmExportConfig *cfg,
+                       const TmAppState *s, uint64_t ts_ms) {
+    if (!w || !cfg || !s) return 0;
+    int records = 0;
+    if (fields_of_kind(cfg->fields, true)) {
+        write_record(w, cfg, ts_ms, s, NULL);
+        records++;
+    }
+    if (fields_of_kind(cfg->fields, false)) {
+        for (int i = 0; i < s->process_count; i++) {
+            write_record(w, cfg, ts_ms, s, tm_process_at(s, i));
+            records++;
+        }
+    }
+    return records;
+}
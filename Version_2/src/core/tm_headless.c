@@ -0,0 +1,285 @@
+/**
+ * @file tm_headless.c
+ * @brief Headless collector loop -- business logic, no Raylib.
+ *
+ * Gathers only the data sets the selected fields need, at a fixed period
+ * of its own (the GUI's per-tab intervals do not apply), and streams each
+ * snapshot through an allocation-free TmWriter. Output is flushed once
+ * per snapshot so `tail -f` and pipes see whole records promptly.
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_headless.h"
+#include "../../include/tm_export.h"
+#include "../../include/tm_record.h"
+#include "../../include/tm_metrics.h"
+#include "../../include/tm_shm.h"
+#include "../../include/tm_query.h"
+#include "../../include/tm_histlog.h"
+#include "../../include/tm_collector.h"
+#include "../../include/tm_process.h"
+#include "../../include/tm_perf.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+#define DEFAULT_FIELDS "pid,name,cpu,mem_kb,cpu_total,mem_used_kb,mem_total_kb"
+
+typedef struct {
+    TmExportConfig export;
+    double         interval_s;
+    long           count;       /* snapshots to write; 0 = until signalled */
+    const char    *output;      /* NULL = stdout */
+    int            metrics_port; /* 0 = no OpenMetrics endpoint */
+    const char    *shm_name;    /* NULL = no shared-memory snapshot */
+    int            shm_rows;
+    const char    *query_socket; /* NULL = no query socket */
+    const char    *history_dir; /* NULL = no history log */
+    int            history_max_mb;
+} TmHeadlessOpts;
+
+static volatile sig_atomic_t s_stop = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    s_stop = 1;
+}
+
+/* -------------------------------------------------------------------------
+ * Command line
+ * ---------------------------------------------------------------------- */
+
+static void print_usage(void) {
+    fprintf(stderr,
+            "usage: task_manager --headless [options]\n"
+            "  --format FORMAT      jsonl, csv or tmrec (binary recording,\n"
+            "                       fixed columns; default jsonl)\n"
+            "  --interval SECONDS   snapshot period (default %.1f, min %.2f)\n"
+            "  --fields LIST        comma-separated fields or 'all'\n"
+            "                       (default " DEFAULT_FIELDS ")\n"
+            "  --output PATH        write to PATH instead of stdout\n"
+            "  --count N            stop after N snapshots (default: run until SIGINT)\n"
+            "  --metrics-port PORT  also serve OpenMetrics on 127.0.0.1:PORT/metrics\n"
+            "  --shm NAME           also publish each snapshot to shared memory NAME\n"
+            "  --shm-rows N         process rows the segment holds (default %d)\n"
+            "  --query-socket PATH  also answer queries and subscriptions on a\n"
+            "                       Unix domain socket at PATH\n"
+            "  --history-dir DIR    also append every snapshot to the history log\n"
+            "                       in DIR (read it with `task_manager query`)\n"
+            "  --history-max-mb MB  delete the oldest history past MB (default %d)\n"
+            "  --replay PATH        sample a tmrec recording instead of this host\n"
+            "  --speed N|max        replay speed (default 1; max = no waiting)\n"
+            "  --synthetic N        sample N generated processes instead of this host\n"
+            "  --seed S             synthetic: population seed (default 1)\n"
+            "  --spawn-rate N       synthetic: processes started per refresh\n"
+            "  --exit-rate N        synthetic: processes ended per refresh\n"
+            "                       (both default to 1%% of N)\n"
+            "  --names K            synthetic: distinct process names (default 1000)\n"
+            "  --cpu-mean PERCENT   synthetic: mean CPU per process (default 0.5)\n"
+            "  --mem-mean MB        synthetic: mean memory per process (default 32)\n"
+            "fields:",
+            TM_HEADLESS_INTERVAL_S, TM_HEADLESS_MIN_INTERVAL_S, TM_SHM_DEFAULT_ROWS,
+            TM_HISTLOG_DEFAULT_MAX_MB);
+    for (int f = 0; f < TM_FIELD_COUNT; f++)
+        fprintf(stderr, " %s", tm_export_field_name((TmExportField)f));
+    fprintf(stderr, "\n");
+}
+
+static tm_result_t parse_options(int argc, char **argv, TmHeadlessOpts *o) {
+    const char *fields = DEFAULT_FIELDS;
+    o->export.format = TM_EXPORT_JSONL;
+    o->interval_s    = TM_HEADLESS_INTERVAL_S;
+    o->count         = 0;
+    o->output        = NULL;
+    o->metrics_port  = 0;
+    o->query_socket  = NULL;
+    if (!tm_shm_parse_args(argc, argv, &o->shm_name, &o->shm_rows)) return TM_ERR_INVALID_ARG;
+    if (!tm_histlog_parse_args(argc, argv, &o->history_dir, &o->history_max_mb))
+        return TM_ERR_INVALID_ARG;
+
+    for (int i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        if (strcmp(opt, "--headless") == 0) continue;
+        if (strcmp(opt, "--help") == 0)     return TM_ERR_INVALID_ARG;
+
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!val || strncmp(opt, "--", 2) != 0) {
+            tm_log_error("Unexpected argument '%s'", opt);
+            return TM_ERR_INVALID_ARG;
+        }
+        i++;
+        if (strcmp(opt, "--format") == 0) {
+            if      (strcmp(val, "jsonl") == 0) o->export.format = TM_EXPORT_JSONL;
+            else if (strcmp(val, "csv") == 0)   o->export.format = TM_EXPORT_CSV;
+            else if (strcmp(val, "tmrec") == 0) o->export.format = TM_EXPORT_TMREC;
+            else return TM_ERR_INVALID_ARG;
+        } else if (strcmp(opt, "--interval") == 0) {
+            o->interval_s = atof(val);
+            if (o->interval_s < TM_HEADLESS_MIN_INTERVAL_S) return TM_ERR_INVALID_ARG;
+        } else if (strcmp(opt, "--fields") == 0) {
+            fields = val;
+        } else if (strcmp(opt, "--output") == 0) {
+            o->output = val;
+        } else if (strcmp(opt, "--count") == 0) {
+            o->count = atol(val);
+            if (o->count < 0) return TM_ERR_INVALID_ARG;
+        } else if (strcmp(opt, "--metrics-port") == 0) {
+            o->metrics_port = tm_metrics_port_arg(argc, argv);
+            if (o->metrics_port < 0) return TM_ERR_INVALID_ARG;
+        } else if (strcmp(opt, "--query-socket") == 0) {
+            o->query_socket = val;
+        } else if (strcmp(opt, "--shm") == 0 || strcmp(opt, "--shm-rows") == 0) {
+            /* read by tm_shm_parse_args() above */
+        } else if (strcmp(opt, "--history-dir") == 0 || strcmp(opt, "--history-max-mb") == 0) {
+            /* read by tm_histlog_parse_args() above */
+        } else if (tm_platform_is_adapter_option(opt)) {
+            /* consumed by tm_platform_from_args() */
+        } else {
+            tm_log_error("Unknown option '%s'", opt);
+            return TM_ERR_INVALID_ARG;
+        }
+    }
+    return tm_export_parse_fields(fields, &o->export.fields);
+}
+
+/* -------------------------------------------------------------------------
+ * Sampling
+ * ---------------------------------------------------------------------- */
+
+/* Detail columns are fetched for every row, not a viewport. */
+static tm_result_t collect(TmAppState *s, uint32_t sets) {
+    TM_CHECK(tm_collector_collect(s, sets & ~(uint32_t)TM_DATA_PROC_DETAIL));
+    if (sets & TM_DATA_PROC_DETAIL)
+        TM_CHECK(tm_process_fetch_details(s, 0, s->process_count, false));
+    return TM_OK;
+}
+
+static int stream(TmAppState *s, const TmHeadlessOpts *o, TmWriter *w, TmShmWriter *shm) {
+    bool     is_rec   = (o->export.format == TM_EXPORT_TMREC);
+    uint32_t sets     = is_rec ? (TM_DATA_SYSTEM | TM_DATA_PERF_DETAIL | TM_DATA_PROCESSES)
+                               : tm_export_data_sets(o->export.fields);
+    if (o->metrics_port || o->shm_name || o->query_socket || o->history_dir)
+        sets |= TM_DATA_EXPORTED;
+    /* Stamps follow the source's clock: a replay keeps its recorded times */
+    double   mono0    = g_platform->now_s();
+    uint64_t epoch_ms = g_platform->epoch_ms();
+    double   next     = mono0;
+    double   busy_s   = 0.0;   /* time spent serialising */
+    uint64_t records  = 0;
+    long     written  = 0;
+    int      status   = 0;
+    TmRecWriter rec;
+
+    if (is_rec) tm_rec_writer_open(&rec, w, epoch_ms);
+    else        tm_export_header(w, &o->export);
+
+    /* The first pass is written too: a replay's frame 0 is data, and live
+     * CPU figures start from the since-boot and lifetime averages */
+    for (bool first = true; !s_stop && (o->count == 0 || written < o->count); first = false) {
+        double now;
+        if (!first) {
+            next += o->interval_s;
+            now   = g_platform->now_s();
+            if (next > now) g_platform->sleep_s(next - now);
+            else            next = now;      /* fell behind: do not burst */
+            if (s_stop) break;
+        }
+
+        if (collect(s, sets) != TM_OK) tm_log_warn("Collection failed; writing stale data");
+        now = g_platform->now_s();
+        uint64_t ts_ms = epoch_ms + (uint64_t)((now - mono0) * 1000.0);
+        tm_metrics_publish(s);
+        tm_shm_publish(shm, s, ts_ms);
+        tm_query_fetch_details();
+        tm_query_publish(s);
+        tm_histlog_append(s, ts_ms);
+        if (is_rec) {
+            if (tm_rec_write_frame(&rec, s, ts_ms) != TM_OK) {
+                status = 1;
+                break;
+            }
+            records += (uint64_t)s->process_count;
+        } else {
+            records += (uint64_t)tm_export_snapshot(w, &o->export, s, ts_ms);
+        }
+        if (tm_writer_flush(w) != TM_OK) {
+            status = 1;
+            break;
+        }
+        busy_s += g_platform->now_s() - now;
+        written++;
+        if (g_platform->is_exhausted()) break;   /* replay finished */
+    }
+
+    if (is_rec) tm_rec_writer_close(&rec);    /* footer even after SIGINT */
+    if (tm_writer_flush(w) != TM_OK) status = 1;
+    if (status != 0) tm_log_error("Output write failed");
+    tm_log_info("Wrote %ld snapshots, %llu records, %llu bytes; serialising took %.3f s "
+                "(%.2f us/record)", written, (unsigned long long)records,
+                (unsigned long long)w->bytes, busy_s,
+                records ? busy_s * 1e6 / (double)records : 0.0);
+    return status;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+bool tm_headless_requested(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) return true;
+    }
+    return false;
+}
+
+int tm_headless_run(int argc, char **argv) {
+    tm_log_use_stderr();
+
+    TmHeadlessOpts opts;
+    if (parse_options(argc, argv, &opts) != TM_OK) {
+        print_usage();
+        return 2;
+    }
+
+    FILE *fp = opts.output ? fopen(opts.output, "w") : stdout;
+    if (!fp) {
+        tm_log_error("Cannot open %s", opts.output);
+        return 1;
+    }
+
+    /* Large (history rings, writer buffer): keep off the stack */
+    static TmAppState app;
+    static TmWriter   writer;
+    tm_perf_data_init(&app.perf);
+    tm_collector_init(&app.collector);
+    tm_writer_init(&writer, fp);
+
+    static TmShmWriter shm;
+    if ((opts.metrics_port && tm_metrics_start(opts.metrics_port) != TM_OK) ||
+        (opts.shm_name && tm_shm_writer_open(&shm, opts.shm_name, opts.shm_rows) != TM_OK) ||
+        (opts.query_socket && tm_query_start(opts.query_socket) != TM_OK) ||
+        (opts.history_dir && tm_histlog_open(opts.history_dir, opts.history_max_mb) != TM_OK)) {
+        tm_metrics_stop();
+        tm_shm_writer_close(&shm);
+        tm_query_stop();
+        if (opts.output) fclose(fp);
+        return 1;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    static const char *k_format_names[] = { "JSON Lines", "CSV", "binary recording" };
+    tm_log_info("Headless: %s every %.2f s", k_format_names[opts.export.format],
+                opts.interval_s);
+
+    int status = stream(&app, &opts, &writer, &shm);
+    tm_metrics_stop();
+    tm_shm_writer_close(&shm);
+    tm_query_stop();
+    tm_histlog_close();
+
+    tm_process_list_free(&app);
+    if (opts.output) fclose(fp);
+    return status;
+}
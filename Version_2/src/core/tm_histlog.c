@@ -0,0 +1,344 @@
+/**
+ * @file tm_histlog.c
+ * @brief History log writer and segment directory -- business logic, no Raylib.
+ *
+ * Directory layout: one tmrec recording per segment, named
+ * `tm-<start_ms, 16 digits>.tmrec` so that name order is time order.
+ *
+ * The sampler owns a TmRecWriter whose TmWriter drains into memory. Each
+ * sample is encoded there, then copied onto a queue of chunks under the
+ * lock. The writer thread wakes every TM_HISTLOG_SYNC_S, takes the whole
+ * queue, appends it and issues one fsync for the batch. The sampler never
+ * touches the file, so a slow disk costs it samples, never time.
+ *
+ * Crash safety: a segment is only ever appended to. One that was never
+ * finished has no index footer, and tm_rec_open() rebuilds the index from
+ * the frames that made it to disk, stopping at a torn last frame. A
+ * finished segment gets its footer and an fsync before the next one is
+ * created, so at most the newest segment is ever partial. After a failed
+ * write the rest of that segment is dropped rather than leave a gap.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_histlog.h"
+#include "../../include/tm_record.h"
+#include "../../include/tm_export.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+#define DIR_CAP      512
+#define WAKE_STEP_S  0.05   /* writer checks for shutdown this often */
+
+/** Encoded bytes for one segment, waiting for the writer thread. */
+typedef struct TmHistChunk {
+    struct TmHistChunk *next;
+    uint64_t            segment;    /* start_ms of its segment */
+    bool                final;      /* the segment ends with these bytes */
+    TmByteBuf           data;
+} TmHistChunk;
+
+static char          s_dir[DIR_CAP];
+static uint64_t      s_max_bytes;
+static TmThread     *s_thread = NULL;
+static TmMutex      *s_lock   = NULL;
+
+/* Sampler side */
+static TmWriter      s_out;             /* large: keep off the stack */
+static TmByteBuf     s_encoded;         /* s_out's memory sink */
+static TmRecWriter   s_rec;
+static uint64_t      s_seg_start;       /* 0 = no segment open */
+static bool          s_skipping;
+
+/* Shared, under s_lock */
+static TmHistChunk  *s_head;
+static TmHistChunk  *s_tail;
+static size_t        s_queued;          /* bytes in the chunks */
+static bool          s_stop;
+
+/* Writer thread */
+static FILE         *s_fp;
+static uint64_t      s_fp_seg;          /* segment s_fp belongs to */
+
+/* -------------------------------------------------------------------------
+ * Segments
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    TmHistSegment *segs;
+    int            count;
+    int            cap;
+    bool           failed;
+} TmSegList;
+
+/* list_dir() callback: keep names of the form tm-<16 digits>.tmrec */
+static void collect_segment(const char *name, uint64_t bytes, void *user) {
+    TmSegList *l = (TmSegList *)user;
+    if (strncmp(name, "tm-", 3) != 0 || strlen(name) != 3 + 16 + 6 ||
+        strcmp(name + 19, ".tmrec") != 0)
+        return;
+    uint64_t start = 0;
+    for (int i = 3; i < 19; i++) {
+        if (name[i] < '0' || name[i] > '9') return;
+        start = start * 10 + (uint64_t)(name[i] - '0');
+    }
+    if (l->count == l->cap) {
+        int            cap  = l->cap ? l->cap * 2 : 64;
+        TmHistSegment *segs = (TmHistSegment *)realloc(l->segs, (size_t)cap * sizeof(*segs));
+        if (!segs) {
+            l->failed = true;
+            return;
+        }
+        l->segs = segs;
+        l->cap  = cap;
+    }
+    l->segs[l->count++] = (TmHistSegment){ start, bytes };
+}
+
+static int cmp_segment(const void *a, const void *b) {
+    uint64_t x = ((const TmHistSegment *)a)->start_ms;
+    uint64_t y = ((const TmHistSegment *)b)->start_ms;
+    return (x > y) - (x < y);
+}
+
+int tm_histlog_segments(const char *dir, TmHistSegment **out) {
+    TmSegList l = {0};
+    *out = NULL;
+    if (g_platform->list_dir(dir, collect_segment, &l) < 0 || l.failed) {
+        free(l.segs);
+        return -1;
+    }
+    qsort(l.segs, (size_t)l.count, sizeof(*l.segs), cmp_segment);
+    *out = l.segs;
+    return l.count;
+}
+
+void tm_histlog_segment_path(const char *dir, uint64_t start_ms, char *out, size_t cap) {
+    snprintf(out, cap, "%s/tm-%016llu.tmrec", dir, (unsigned long long)start_ms);
+}
+
+/* Delete the oldest segments while the log is over budget; never the newest */
+static void prune(void) {
+    TmHistSegment *segs;
+    int            n = tm_histlog_segments(s_dir, &segs);
+    uint64_t       total = 0;
+    for (int i = 0; i < n; i++) total += segs[i].bytes;
+
+    for (int i = 0; i + 1 < n && total > s_max_bytes; i++) {
+        char path[DIR_CAP + 32];
+        tm_histlog_segment_path(s_dir, segs[i].start_ms, path, sizeof(path));
+        if (!g_platform->remove_file(path)) {
+            tm_log_warn("Cannot delete old history segment %s", path);
+            break;
+        }
+        total -= segs[i].bytes;
+        tm_log_info("History over %llu MiB; deleted %s",
+                    (unsigned long long)(s_max_bytes >> 20), path);
+    }
+    free(segs);
+}
+
+/* -------------------------------------------------------------------------
+ * Writer thread
+ * ---------------------------------------------------------------------- */
+
+static bool stopping(void) {
+    g_platform->mutex_lock(s_lock);
+    bool stop = s_stop;
+    g_platform->mutex_unlock(s_lock);
+    return stop;
+}
+
+static void write_chunk(const TmHistChunk *c) {
+    if (c->segment != s_fp_seg) {
+        if (s_fp) fclose(s_fp);         /* predecessor never finished */
+        char path[DIR_CAP + 32];
+        tm_histlog_segment_path(s_dir, c->segment, path, sizeof(path));
+        s_fp     = fopen(path, "wb");
+        s_fp_seg = c->segment;
+        if (!s_fp) tm_log_error("Cannot create history segment %s", path);
+    }
+    if (!s_fp) return;                  /* segment abandoned */
+
+    if (fwrite(c->data.data, 1, c->data.len, s_fp) != c->data.len) {
+        tm_log_error("History write failed; dropping the rest of this segment");
+        fclose(s_fp);
+        s_fp = NULL;
+        return;
+    }
+    if (c->final) {
+        if (!g_platform->sync_file(s_fp)) tm_log_warn("History fsync failed");
+        fclose(s_fp);
+        s_fp = NULL;
+        prune();
+    }
+}
+
+static void run(void *arg) {
+    (void)arg;
+    for (;;) {
+        double until = g_platform->now_s() + TM_HISTLOG_SYNC_S;
+        bool   stop;
+        while (!(stop = stopping()) && g_platform->now_s() < until)
+            g_platform->sleep_s(WAKE_STEP_S);
+
+        g_platform->mutex_lock(s_lock);
+        TmHistChunk *batch = s_head;
+        s_head   = NULL;
+        s_tail   = NULL;
+        s_queued = 0;
+        g_platform->mutex_unlock(s_lock);
+
+        while (batch) {
+            TmHistChunk *next = batch->next;
+            write_chunk(batch);
+            free(batch->data.data);
+            free(batch);
+            batch = next;
+        }
+        if (s_fp && !g_platform->sync_file(s_fp)) tm_log_warn("History fsync failed");
+        if (stop) break;
+    }
+    if (s_fp) fclose(s_fp);
+    s_fp     = NULL;
+    s_fp_seg = 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Sampler side
+ * ---------------------------------------------------------------------- */
+
+static bool buf_append(TmByteBuf *b, const char *p, size_t n) {
+    if (b->len + n > b->cap) {
+        size_t cap = b->cap ? b->cap : TM_EXPORT_BUF_BYTES;
+        while (cap < b->len + n) cap *= 2;
+        char *data = (char *)realloc(b->data, cap);
+        if (!data) return false;
+        b->data = data;
+        b->cap  = cap;
+    }
+    memcpy(b->data + b->len, p, n);
+    b->len += n;
+    return true;
+}
+
+/* Move what the recorder has written onto the queue */
+static void enqueue(bool final) {
+    if (tm_writer_flush(&s_out) != TM_OK) tm_log_warn("History encode buffer allocation failed");
+
+    g_platform->mutex_lock(s_lock);
+    TmHistChunk *c = s_tail;
+    if (!c || c->segment != s_seg_start || c->final) {
+        c = (TmHistChunk *)calloc(1, sizeof(*c));
+        if (c) {
+            c->segment = s_seg_start;
+            if (s_tail) s_tail->next = c;
+            else        s_head       = c;
+            s_tail = c;
+        }
+    }
+    if (c && buf_append(&c->data, s_encoded.data, s_encoded.len)) {
+        s_queued += s_encoded.len;
+        c->final  = final;
+    } else {
+        tm_log_warn("History queue allocation failed; sample lost");
+    }
+    g_platform->mutex_unlock(s_lock);
+    s_encoded.len = 0;
+}
+
+static void open_segment(uint64_t ts_ms) {
+    tm_writer_init_mem(&s_out, &s_encoded);
+    tm_rec_writer_open(&s_rec, &s_out, ts_ms);
+    s_seg_start = ts_ms;
+}
+
+static void close_segment(void) {
+    tm_rec_writer_close(&s_rec);
+    enqueue(true);
+    s_seg_start = 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+bool tm_histlog_parse_args(int argc, char **argv, const char **dir, int *max_mb) {
+    *dir    = NULL;
+    *max_mb = TM_HISTLOG_DEFAULT_MAX_MB;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--history-dir") == 0) *dir = argv[i + 1];
+        if (strcmp(argv[i], "--history-max-mb") == 0) {
+            *max_mb = atoi(argv[i + 1]);
+            if (*max_mb < 1) return false;
+        }
+    }
+    return true;
+}
+
+tm_result_t tm_histlog_open(const char *dir, int max_mb) {
+    if (!dir || !*dir || max_mb < 1 || strlen(dir) >= sizeof(s_dir)) return TM_ERR_INVALID_ARG;
+    if (s_thread) return TM_OK;
+    if (!g_platform->make_dir(dir)) {
+        tm_log_error("Cannot create history directory %s", dir);
+        return TM_ERR_IO;
+    }
+    snprintf(s_dir, sizeof(s_dir), "%s", dir);
+    s_max_bytes = (uint64_t)max_mb << 20;
+    prune();
+
+    s_lock = g_platform->mutex_create();
+    if (!s_lock) return TM_ERR_PLATFORM;
+    s_stop      = false;
+    s_seg_start = 0;
+    s_thread    = g_platform->thread_start(run, NULL);
+    if (!s_thread) {
+        g_platform->mutex_destroy(s_lock);
+        s_lock = NULL;
+        return TM_ERR_PLATFORM;
+    }
+    tm_log_info("Logging history to %s (up to %d MiB)", dir, max_mb);
+    return TM_OK;
+}
+
+void tm_histlog_append(const TmAppState *s, uint64_t ts_ms) {
+    if (!s || !s_thread) return;
+
+    g_platform->mutex_lock(s_lock);
+    bool behind = s_queued > TM_HISTLOG_QUEUE_MAX;
+    g_platform->mutex_unlock(s_lock);
+    if (behind) {
+        if (!s_skipping) tm_log_warn("History writer is behind; skipping samples");
+        s_skipping = true;
+        return;
+    }
+    s_skipping = false;
+
+    if (s_seg_start && (s_out.bytes + s_out.len >= TM_HISTLOG_SEGMENT_BYTES ||
+                        ts_ms < s_seg_start || ts_ms - s_seg_start >= TM_HISTLOG_SEGMENT_MS))
+        close_segment();
+    if (!s_seg_start) open_segment(ts_ms);
+
+    if (tm_rec_write_frame(&s_rec, s, ts_ms) != TM_OK) {
+        tm_log_warn("History frame allocation failed; sample lost");
+        return;
+    }
+    enqueue(false);
+}
+
+void tm_histlog_close(void) {
+    if (!s_thread) return;
+    if (s_seg_start) close_segment();
+
+    g_platform->mutex_lock(s_lock);
+    s_stop = true;
+    g_platform->mutex_unlock(s_lock);
+    g_platform->thread_join(s_thread);      /* drains the queue first */
+    g_platform->mutex_destroy(s_lock);
+
+    free(s_encoded.data);
+    s_encoded = (TmByteBuf){0};
+    s_thread  = NULL;
+    s_lock    = NULL;
+}
@@ -0,0 +1,388 @@
+/**
+ * @file tm_histquery.c
+ * @brief `task_manager query` over the history log -- business logic, no Raylib.
+ *
+ * Segment names give each segment's start, so only segments overlapping
+ * the requested range are mapped at all. Within one, tm_rec_seek() finds
+ * the first frame by binary search over its index, and frames are decoded
+ * in place until the end of the range. Rows are folded into one entry per
+ * (pid, name) in an open-addressing table: peak memory, mean and peak CPU.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../include/tm_histlog.h"
+#include "../../include/tm_record.h"
+#include "../../include/tm_export.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+typedef struct {
+    uint32_t pid;
+    uint32_t samples;
+    uint64_t mem_peak_kb;
+    double   cpu_sum;
+    float    cpu_peak;
+    bool     used;
+    char     name[TM_HISTLOG_NAME_LEN];
+} TmHistAgg;
+
+typedef struct {
+    const char *dir;
+    uint64_t    from_ms;
+    uint64_t    to_ms;
+    int         top;
+    bool        by_cpu;
+    bool        jsonl;
+} TmQueryOpts;
+
+typedef struct {
+    TmHistAgg *slots;
+    int        mask;
+    int        used;
+    uint32_t   frames;
+    uint32_t   segments;
+    uint64_t   first_ms;
+    uint64_t   last_ms;
+    double     cpu_sum;
+    float      cpu_peak;
+    uint64_t   mem_peak_kb;
+    uint64_t   mem_total_kb;
+} TmQueryTotals;
+
+/* -------------------------------------------------------------------------
+ * Command line
+ * ---------------------------------------------------------------------- */
+
+static void print_usage(void) {
+    fprintf(stderr,
+            "usage: task_manager query --history-dir DIR [options]\n"
+            "  --from TIME          start of the range (default: oldest sample)\n"
+            "  --to TIME            end of the range (default: now)\n"
+            "  --top N              processes to list (default 10)\n"
+            "  --by mem|cpu         rank by peak memory or mean CPU (default mem)\n"
+            "  --format table|jsonl (default table)\n"
+            "TIME is HH:MM[:SS] (the most recent one), YYYY-MM-DD[ HH:MM[:SS]]\n"
+            "or 'now', in local time.\n");
+}
+
+/* Local time to epoch ms; HH:MM[:SS] alone means the latest one not after now */
+static bool parse_time(const char *str, time_t now, uint64_t *out) {
+    if (strcmp(str, "now") == 0) {
+        *out = (uint64_t)now * 1000u;
+        return true;
+    }
+    struct tm t = *localtime(&now);
+    int  year, mon, day, hour = 0, min = 0, sec = 0, n = 0;
+    bool time_only = false;
+
+    if (sscanf(str, "%d-%d-%d%n", &year, &mon, &day, &n) == 3) {
+        t.tm_year = year - 1900;
+        t.tm_mon  = mon - 1;
+        t.tm_mday = day;
+        str      += n;
+        if (*str == ' ' || *str == 'T') str++;
+    } else {
+        time_only = true;
+    }
+    if (*str) {
+        n = 0;
+        if (sscanf(str, "%d:%d%n", &hour, &min, &n) != 2) return false;
+        str += n;
+        if (*str == ':') {
+            n = 0;
+            if (sscanf(str + 1, "%d%n", &sec, &n) != 1) return false;
+            str += 1 + n;
+        }
+        if (*str) return false;
+    } else if (time_only) {
+        return false;
+    }
+    if (hour < 0 || hour > 23 || min < 0 || min > 59 || sec < 0 || sec > 60) return false;
+
+    t.tm_hour  = hour;
+    t.tm_min   = min;
+    t.tm_sec   = sec;
+    t.tm_isdst = -1;
+    time_t when = mktime(&t);
+    if (time_only && when > now) {
+        t.tm_mday--;
+        t.tm_isdst = -1;
+        when = mktime(&t);
+    }
+    if (when == (time_t)-1 || when < 0) return false;
+    *out = (uint64_t)when * 1000u;
+    return true;
+}
+
+static tm_result_t parse_options(int argc, char **argv, TmQueryOpts *o) {
+    time_t now = time(NULL);
+    o->dir     = NULL;
+    o->from_ms = 0;
+    o->to_ms   = (uint64_t)now * 1000u;
+    o->top     = 10;
+    o->by_cpu  = false;
+    o->jsonl   = false;
+
+    for (int i = 2; i < argc; i++) {            /* argv[1] is "query" */
+        const char *opt = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!val) {
+            tm_log_error("Option '%s' needs a value", opt);
+            return TM_ERR_INVALID_ARG;
+        }
+        i++;
+        if (strcmp(opt, "--history-dir") == 0) {
+            o->dir = val;
+        } else if (strcmp(opt, "--from") == 0 || strcmp(opt, "--to") == 0) {
+            uint64_t *dst = (opt[2] == 'f') ? &o->from_ms : &o->to_ms;
+            if (!parse_time(val, now, dst)) {
+                tm_log_error("Cannot read time '%s'", val);
+                return TM_ERR_INVALID_ARG;
+            }
+        } else if (strcmp(opt, "--top") == 0) {
+            o->top = atoi(val);
+            if (o->top < 1) return TM_ERR_INVALID_ARG;
+        } else if (strcmp(opt, "--by") == 0) {
+            if      (strcmp(val, "cpu") == 0) o->by_cpu = true;
+            else if (strcmp(val, "mem") == 0) o->by_cpu = false;
+            else return TM_ERR_INVALID_ARG;
+        } else if (strcmp(opt, "--format") == 0) {
+            if      (strcmp(val, "jsonl") == 0) o->jsonl = true;
+            else if (strcmp(val, "table") == 0) o->jsonl = false;
+            else return TM_ERR_INVALID_ARG;
+        } else if (tm_platform_is_adapter_option(opt)) {
+            /* consumed by tm_platform_from_args() */
+        } else {
+            tm_log_error("Unknown option '%s'", opt);
+            return TM_ERR_INVALID_ARG;
+        }
+    }
+    if (!o->dir) {
+        tm_log_error("--history-dir is required");
+        return TM_ERR_INVALID_ARG;
+    }
+    if (o->from_ms > o->to_ms) {
+        tm_log_error("--from is after --to");
+        return TM_ERR_INVALID_ARG;
+    }
+    return TM_OK;
+}
+
+/* -------------------------------------------------------------------------
+ * Aggregation
+ * ---------------------------------------------------------------------- */
+
+/* Hashes only the name bytes an entry keeps, so rehashing finds the same slot */
+static uint32_t hash_row(uint32_t pid, const char *name) {
+    uint32_t h = pid * 2654435761u;
+    const unsigned char *c = (const unsigned char *)name;
+    for (int i = 0; c[i] && i < TM_HISTLOG_NAME_LEN - 1; i++)
+        h = (h ^ c[i]) * 16777619u;
+    return h;
+}
+
+static bool same_name(const char *stored, const char *name) {
+    return strncmp(stored, name, TM_HISTLOG_NAME_LEN - 1) == 0;
+}
+
+static bool totals_grow(TmQueryTotals *t) {
+    int        cap   = t->slots ? (t->mask + 1) * 2 : 4096;
+    TmHistAgg *slots = (TmHistAgg *)calloc((size_t)cap, sizeof(*slots));
+    if (!slots) return false;
+    for (int i = 0; t->slots && i <= t->mask; i++) {
+        if (!t->slots[i].used) continue;
+        uint32_t h = hash_row(t->slots[i].pid, t->slots[i].name) & (uint32_t)(cap - 1);
+        while (slots[h].used) h = (h + 1) & (uint32_t)(cap - 1);
+        slots[h] = t->slots[i];
+    }
+    free(t->slots);
+    t->slots = slots;
+    t->mask  = cap - 1;
+    return true;
+}
+
+static bool fold_row(TmQueryTotals *t, const TmRecRow *r) {
+    if ((t->used + 1) * 2 > t->mask + 1 && !totals_grow(t)) return false;
+    uint32_t   h = hash_row(r->pid, r->name) & (uint32_t)t->mask;
+    TmHistAgg *a = &t->slots[h];
+    while (a->used && !(a->pid == r->pid && same_name(a->name, r->name))) {
+        h = (h + 1) & (uint32_t)t->mask;
+        a = &t->slots[h];
+    }
+    if (!a->used) {
+        a->used = true;
+        a->pid  = r->pid;
+        snprintf(a->name, sizeof(a->name), "%s", r->name);
+        t->used++;
+    }
+    a->samples++;
+    a->cpu_sum += r->cpu_percent;
+    if (r->cpu_percent > a->cpu_peak) a->cpu_peak = r->cpu_percent;
+    if (r->mem_kb > a->mem_peak_kb)   a->mem_peak_kb = r->mem_kb;
+    return true;
+}
+
+/* Fold the frames of one segment that fall inside the range */
+static tm_result_t fold_segment(TmQueryTotals *t, const TmQueryOpts *o, const char *path) {
+    TmRecReader r;
+    tm_result_t rc = tm_rec_open(&r, path);
+    if (rc != TM_OK) return rc;
+    uint32_t i = tm_rec_seek(&r, o->from_ms);
+    if (i < r.frame_count && tm_rec_frame_ts(&r, i) < o->from_ms) i++;
+
+    bool any = false;
+    for (; i < r.frame_count && tm_rec_frame_ts(&r, i) <= o->to_ms; i++) {
+        TmRecFrame f;
+        if (tm_rec_frame(&r, i, &f) != TM_OK) {
+            tm_log_warn("%s: frame %u is corrupt; skipped", path, i);
+            continue;
+        }
+        TmRecRow row;
+        while (tm_rec_next_row(&f, &row)) {
+            if (!fold_row(t, &row)) {
+                rc = TM_ERR_ALLOC;
+                break;
+            }
+        }
+        if (rc != TM_OK) break;
+        any = true;
+        if (t->frames++ == 0) t->first_ms = f.ts_ms;
+        t->last_ms = f.ts_ms;
+        t->cpu_sum += f.cpu_total;
+        if (f.cpu_total > t->cpu_peak)      t->cpu_peak     = f.cpu_total;
+        if (f.mem_used_kb > t->mem_peak_kb) t->mem_peak_kb  = f.mem_used_kb;
+        t->mem_total_kb = f.mem_total_kb;
+    }
+    if (any) t->segments++;
+    tm_rec_close(&r);
+    return rc;
+}
+
+static bool s_rank_cpu;     /* qsort has no context argument */
+
+static double agg_cpu_mean(const TmHistAgg *a) {
+    return a->samples ? a->cpu_sum / a->samples : 0.0;
+}
+
+/* Highest first; ties go to the lower pid */
+static int cmp_agg(const void *pa, const void *pb) {
+    const TmHistAgg *a = (const TmHistAgg *)pa;
+    const TmHistAgg *b = (const TmHistAgg *)pb;
+    if (s_rank_cpu) {
+        double x = agg_cpu_mean(a), y = agg_cpu_mean(b);
+        if (x != y) return (x < y) ? 1 : -1;
+    } else if (a->mem_peak_kb != b->mem_peak_kb) {
+        return (a->mem_peak_kb < b->mem_peak_kb) ? 1 : -1;
+    }
+    return (a->pid > b->pid) - (a->pid < b->pid);
+}
+
+/* -------------------------------------------------------------------------
+ * Output
+ * ---------------------------------------------------------------------- */
+
+static void format_local(uint64_t ms, char *out, size_t cap) {
+    time_t secs = (time_t)(ms / 1000u);
+    strftime(out, cap, "%Y-%m-%d %H:%M:%S", localtime(&secs));
+}
+
+static void print_table(const TmQueryTotals *t, const TmHistAgg *rows, int n) {
+    char from[32], to[32];
+    format_local(t->first_ms, from, sizeof(from));
+    format_local(t->last_ms, to, sizeof(to));
+    printf("History %s .. %s: %u samples from %u segment%s\n", from, to,
+           t->frames, t->segments, t->segments == 1 ? "" : "s");
+    printf("System CPU mean %.1f %%, peak %.1f %%; memory peak %.1f of %.1f GiB\n\n",
+           t->cpu_sum / t->frames, t->cpu_peak,
+           (double)t->mem_peak_kb / (1024.0 * 1024.0),
+           (double)t->mem_total_kb / (1024.0 * 1024.0));
+    printf("%8s  %-28s %12s %9s %9s %6s\n",
+           "PID", "NAME", "PEAK MEM", "MEAN CPU", "PEAK CPU", "SEEN");
+    for (int i = 0; i < n; i++) {
+        const TmHistAgg *a = &rows[i];
+        printf("%8u  %-28.28s %8.1f MiB %7.1f %% %7.1f %% %5.0f%%\n",
+               a->pid, a->name, (double)a->mem_peak_kb / 1024.0, agg_cpu_mean(a),
+               a->cpu_peak, 100.0 * a->samples / t->frames);
+    }
+}
+
+static void print_jsonl(const TmHistAgg *rows, int n) {
+    static TmWriter w;                      /* large: keep off the stack */
+    tm_writer_init(&w, stdout);
+    for (int i = 0; i < n; i++) {
+        const TmHistAgg *a = &rows[i];
+        tm_writer_str(&w, "{\"pid\":");
+        tm_writer_u64(&w, a->pid);
+        tm_writer_str(&w, ",\"name\":");
+        tm_writer_json_str(&w, a->name);
+        tm_writer_str(&w, ",\"mem_peak_kb\":");
+        tm_writer_u64(&w, a->mem_peak_kb);
+        tm_writer_str(&w, ",\"cpu_mean\":");
+        tm_writer_fixed(&w, agg_cpu_mean(a), 2);
+        tm_writer_str(&w, ",\"cpu_peak\":");
+        tm_writer_fixed(&w, a->cpu_peak, 2);
+        tm_writer_str(&w, ",\"samples\":");
+        tm_writer_u64(&w, a->samples);
+        tm_writer_str(&w, "}\n");
+    }
+    tm_writer_flush(&w);
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+bool tm_histquery_requested(int argc, char **argv) {
+    return argc > 1 && strcmp(argv[1], "query") == 0;
+}
+
+int tm_histquery_run(int argc, char **argv) {
+    tm_log_use_stderr();
+    TmQueryOpts o;
+    if (parse_options(argc, argv, &o) != TM_OK) {
+        print_usage();
+        return 2;
+    }
+
+    TmHistSegment *segs;
+    int            n = tm_histlog_segments(o.dir, &segs);
+    if (n < 0) {
+        tm_log_error("Cannot read history directory %s", o.dir);
+        return 1;
+    }
+
+    /* Segment i holds [start_i, start_i+1): skip those wholly outside */
+    TmQueryTotals t = {0};
+    int           status = 0;
+    for (int i = 0; i < n && status == 0; i++) {
+        if (segs[i].start_ms > o.to_ms) break;
+        if (i + 1 < n && segs[i + 1].start_ms <= o.from_ms) continue;
+        char path[1024];
+        tm_histlog_segment_path(o.dir, segs[i].start_ms, path, sizeof(path));
+        tm_result_t rc = fold_segment(&t, &o, path);
+        if (rc == TM_ERR_ALLOC) status = 1;
+        else if (rc != TM_OK) tm_log_warn("Skipping unreadable segment %s", path);
+    }
+    free(segs);
+
+    if (status == 0 && t.frames == 0) {
+        tm_log_error("No samples in that range");
+        status = 1;
+    }
+    if (status == 0) {
+        /* Compact the used slots to the front, then rank them */
+        int k = 0;
+        for (int i = 0; i <= t.mask; i++)
+            if (t.slots[i].used) t.slots[k++] = t.slots[i];
+        s_rank_cpu = o.by_cpu;
+        qsort(t.slots, (size_t)k, sizeof(*t.slots), cmp_agg);
+        int shown = (o.top < k) ? o.top : k;
+        if (o.jsonl) print_jsonl(t.slots, shown);
+        else         print_table(&t, t.slots, shown);
+    }
+    free(t.slots);
+    return status;
+}
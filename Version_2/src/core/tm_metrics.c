@@ -0,0 +1,293 @@
+/**
+ * @file tm_metrics.c
+ * @brief OpenMetrics endpoint -- business logic, no Raylib.
+ *
+ * Two TmByteBufs alternate: the sampler renders into the back one with a
+ * TmWriter memory sink and flips `front` under the lock; the server thread
+ * pins the front one (a reader count per buffer) for as long as it takes
+ * to send it. A publish that finds its back buffer still pinned by an
+ * earlier scrape skips that snapshot rather than wait. Buffers keep their
+ * capacity, so once the body has reached its size nothing allocates.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_metrics.h"
+#include "../../include/tm_export.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+#define CONTENT_TYPE "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+static TmByteBuf  s_body[2];
+static int        s_readers[2];      /* scrapes sending each buffer */
+static int        s_front   = -1;    /* -1 until the first publish */
+static bool       s_stop    = false;
+static TmMutex   *s_lock    = NULL;
+static TmThread  *s_thread  = NULL;
+static int        s_listener = -1;
+static TmWriter   s_writer;          /* large: keep off the stack */
+
+/* -------------------------------------------------------------------------
+ * Rendering
+ * ---------------------------------------------------------------------- */
+
+static void family(TmWriter *w, const char *name, const char *help) {
+    tm_writer_str(w, "# TYPE ");
+    tm_writer_str(w, name);
+    tm_writer_str(w, " gauge\n# HELP ");
+    tm_writer_str(w, name);
+    tm_writer_bytes(w, " ", 1);
+    tm_writer_str(w, help);
+    tm_writer_bytes(w, "\n", 1);
+}
+
+/* Label value with \ " and newline escaped, as OpenMetrics requires */
+static void label_str(TmWriter *w, const char *str) {
+    tm_writer_bytes(w, "\"", 1);
+    for (const char *c = str; *c; c++) {
+        if      (*c == '\\') tm_writer_bytes(w, "\\\\", 2);
+        else if (*c == '"')  tm_writer_bytes(w, "\\\"", 2);
+        else if (*c == '\n') tm_writer_bytes(w, "\\n", 2);
+        else                 tm_writer_bytes(w, c, 1);
+    }
+    tm_writer_bytes(w, "\"", 1);
+}
+
+static void gauge_u64(TmWriter *w, const char *name, const char *help, uint64_t v) {
+    family(w, name, help);
+    tm_writer_str(w, name);
+    tm_writer_bytes(w, " ", 1);
+    tm_writer_u64(w, v);
+    tm_writer_bytes(w, "\n", 1);
+}
+
+static void gauge_pct(TmWriter *w, const char *name, const char *help, float v) {
+    family(w, name, help);
+    tm_writer_str(w, name);
+    tm_writer_bytes(w, " ", 1);
+    tm_writer_fixed(w, v, 1);
+    tm_writer_bytes(w, "\n", 1);
+}
+
+/* `name{pid="1",name="init"} ` -- the start of a per-process sample */
+static void process_sample(TmWriter *w, const char *metric, const TmProcess *p) {
+    tm_writer_str(w, metric);
+    tm_writer_str(w, "{pid=\"");
+    tm_writer_u64(w, p->pid);
+    tm_writer_str(w, "\",name=");
+    label_str(w, p->name);
+    tm_writer_str(w, "} ");
+}
+
+/* Disk, GPU and thread figures are still demo values in tm_perf.c, so
+ * they stay off the endpoint until they have real sources. */
+static void render(TmWriter *w, const TmAppState *s) {
+    const TmPerfData *d = &s->perf;
+
+    gauge_pct(w, "tm_cpu_usage_percent", "Overall CPU usage.", d->cpu_percent);
+    family(w, "tm_cpu_core_usage_percent", "Per-core CPU usage.");
+    for (int i = 0; i < d->core_count; i++) {
+        tm_writer_str(w, "tm_cpu_core_usage_percent{core=\"");
+        tm_writer_u64(w, (uint64_t)i);
+        tm_writer_str(w, "\"} ");
+        tm_writer_fixed(w, d->core_percent[i], 1);
+        tm_writer_bytes(w, "\n", 1);
+    }
+    if (d->mem_total_kb > 0) {
+        gauge_u64(w, "tm_memory_used_bytes", "Physical memory in use.", d->mem_used_kb * 1024);
+        gauge_u64(w, "tm_memory_total_bytes", "Installed physical memory.", d->mem_total_kb * 1024);
+        gauge_u64(w, "tm_memory_available_bytes", "Memory available without swapping.",
+                  d->mem_available_kb * 1024);
+    }
+    gauge_u64(w, "tm_uptime_seconds", "Seconds since sampling began.", (uint64_t)d->uptime_s);
+    gauge_u64(w, "tm_processes", "Processes in the latest table.", (uint64_t)s->process_count);
+
+    family(w, "tm_process_cpu_usage_percent", "Per-process CPU usage since the previous refresh.");
+    for (const TmProcess *p = s->process_list; p; p = p->next) {
+        process_sample(w, "tm_process_cpu_usage_percent", p);
+        tm_writer_fixed(w, p->cpu_interval, 1);
+        tm_writer_bytes(w, "\n", 1);
+    }
+    family(w, "tm_process_resident_bytes", "Per-process resident set size.");
+    for (const TmProcess *p = s->process_list; p; p = p->next) {
+        process_sample(w, "tm_process_resident_bytes", p);
+        tm_writer_u64(w, p->memory_bytes);
+        tm_writer_bytes(w, "\n", 1);
+    }
+    tm_writer_str(w, "# EOF\n");
+}
+
+/* -------------------------------------------------------------------------
+ * Server thread
+ * ---------------------------------------------------------------------- */
+
+static bool stopping(void) {
+    g_platform->mutex_lock(s_lock);
+    bool stop = s_stop;
+    g_platform->mutex_unlock(s_lock);
+    return stop;
+}
+
+/* Read the request head into @p req; false if the client gave up. */
+static bool read_request(int sock, char *req, size_t cap) {
+    double deadline = g_platform->now_s() + TM_METRICS_RECV_TIMEOUT_S;
+    size_t len      = 0;
+    while (len + 1 < cap) {
+        double left = deadline - g_platform->now_s();
+        if (left <= 0.0) return false;  /* a trickling client gets no more */
+        long n = g_platform->sock_recv(sock, req + len, cap - 1 - len, left);
+        if (n <= 0) return false;
+        len += (size_t)n;
+        req[len] = '\0';
+        if (strstr(req, "\r\n\r\n")) return true;
+    }
+    return true;                /* oversized head: answer from what we have */
+}
+
+static void send_status(int sock, const char *status) {
+    char head[160];
+    int  n = snprintf(head, sizeof(head),
+                      "HTTP/1.1 %s\r\nContent-Type: text/plain\r\n"
+                      "Content-Length: %zu\r\nConnection: close\r\n\r\n%s\n",
+                      status, strlen(status) + 1, status);
+    g_platform->sock_send(sock, head, (size_t)n, TM_METRICS_RECV_TIMEOUT_S);
+}
+
+/* Send the front buffer, pinned so no publish rewrites it meanwhile. */
+static void send_metrics(int sock, bool with_body) {
+    g_platform->mutex_lock(s_lock);
+    int idx = s_front;
+    if (idx >= 0) s_readers[idx]++;
+    g_platform->mutex_unlock(s_lock);
+    if (idx < 0) {
+        send_status(sock, "503 Service Unavailable");
+        return;
+    }
+
+    const TmByteBuf *body = &s_body[idx];
+    char head[192];
+    int  n = snprintf(head, sizeof(head),
+                      "HTTP/1.1 200 OK\r\nContent-Type: " CONTENT_TYPE "\r\n"
+                      "Content-Length: %zu\r\nConnection: close\r\n\r\n", body->len);
+    /* A client that stops reading is dropped at the deadline, which
+     * unpins the buffer and keeps tm_metrics_stop() from waiting on it */
+    double deadline = g_platform->now_s() + TM_METRICS_RECV_TIMEOUT_S;
+    if (g_platform->sock_send(sock, head, (size_t)n, TM_METRICS_RECV_TIMEOUT_S) && with_body)
+        g_platform->sock_send(sock, body->data, body->len, deadline - g_platform->now_s());
+
+    g_platform->mutex_lock(s_lock);
+    s_readers[idx]--;
+    g_platform->mutex_unlock(s_lock);
+}
+
+static void handle(int sock) {
+    char req[TM_METRICS_REQUEST_MAX];
+    if (!read_request(sock, req, sizeof(req))) return;
+
+    bool get  = strncmp(req, "GET ", 4) == 0;
+    bool head = strncmp(req, "HEAD ", 5) == 0;
+    if (!get && !head) {
+        send_status(sock, "405 Method Not Allowed");
+        return;
+    }
+    const char *path = req + (get ? 4 : 5);
+    if (strncmp(path, "/metrics", 8) != 0 || (path[8] != ' ' && path[8] != '?')) {
+        send_status(sock, "404 Not Found");
+        return;
+    }
+    send_metrics(sock, get);
+}
+
+static void serve(void *arg) {
+    (void)arg;
+    while (!stopping()) {
+        int sock = g_platform->sock_accept(s_listener, TM_METRICS_ACCEPT_WAIT_S);
+        if (sock < 0) continue;
+        handle(sock);
+        g_platform->sock_close(sock);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+int tm_metrics_port_arg(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--metrics-port") != 0) continue;
+        long port = strtol(argv[i + 1], NULL, 10);
+        return (port >= 1 && port <= 65535) ? (int)port : -1;
+    }
+    return 0;
+}
+
+tm_result_t tm_metrics_start(int port) {
+    if (port < 1 || port > 65535) return TM_ERR_INVALID_ARG;
+    if (s_thread) return TM_OK;
+
+    s_lock = g_platform->mutex_create();
+    if (!s_lock) return TM_ERR_ALLOC;
+    s_listener = g_platform->tcp_listen(port);
+    if (s_listener < 0) {
+        g_platform->mutex_destroy(s_lock);
+        s_lock = NULL;
+        return TM_ERR_PLATFORM;
+    }
+
+    s_stop   = false;
+    s_front  = -1;
+    s_thread = g_platform->thread_start(serve, NULL);
+    if (!s_thread) {
+        g_platform->sock_close(s_listener);
+        g_platform->mutex_destroy(s_lock);
+        s_listener = -1;
+        s_lock     = NULL;
+        return TM_ERR_PLATFORM;
+    }
+    tm_log_info("Serving OpenMetrics on http://127.0.0.1:%d/metrics", port);
+    return TM_OK;
+}
+
+void tm_metrics_publish(const TmAppState *s) {
+    if (!s || !s_thread) return;
+
+    g_platform->mutex_lock(s_lock);
+    int  back = (s_front == 0) ? 1 : 0;
+    bool busy = s_readers[back] > 0;
+    g_platform->mutex_unlock(s_lock);
+    if (busy) {
+        tm_log_debug("Metrics buffer still being scraped; snapshot skipped");
+        return;
+    }
+
+    /* Only the front buffer is ever pinned, so back stays ours until the flip */
+    tm_writer_init_mem(&s_writer, &s_body[back]);
+    render(&s_writer, s);
+    if (tm_writer_flush(&s_writer) != TM_OK) {
+        tm_log_warn("Metrics body allocation failed; keeping the previous one");
+        return;
+    }
+
+    g_platform->mutex_lock(s_lock);
+    s_front = back;
+    g_platform->mutex_unlock(s_lock);
+}
+
+void tm_metrics_stop(void) {
+    if (!s_thread) return;
+    g_platform->mutex_lock(s_lock);
+    s_stop = true;
+    g_platform->mutex_unlock(s_lock);
+    g_platform->thread_join(s_thread);    /* within one accept wait + one request */
+    g_platform->sock_close(s_listener);
+    g_platform->mutex_destroy(s_lock);
+    for (int i = 0; i < 2; i++) {
+        free(s_body[i].data);
+        s_body[i] = (TmByteBuf){0};
+    }
+    s_thread   = NULL;
+    s_lock     = NULL;
+    s_listener = -1;
+}
@@ -3,7 +3,7 @@
  * @brief System performance monitoring -- business logic, no Raylib.
  *
  * Each metric has its own private update function (~12 lines each).
- * The orchestrator tm_perf_update() is flat and readable.
+ * The orchestrator tm_perf_sample() is flat and readable.
  */
 
 #include <string.h>
@@ -11,8 +11,8 @@
 
 #include "../../include/tm_perf.h"
 #include "../../include/tm_platform.h"
+#include "../../include/tm_event.h"
 #include "../../include/tm_log.h"
-#include "../../include/tm_app_history.h"
 
 /* -------------------------------------------------------------------------
  * Init
@@ -21,9 +21,9 @@
 void tm_perf_data_init(TmPerfData *d) {
     if (!d) return;
     memset(d, 0, sizeof(*d));
-    d->mem_total_kb  = (uint64_t)16 * 1024 * 1024; /* 16 GiB in KB */
     d->disk_total_kb = (uint64_t)500 * 1024 * 1024; /* 500 GiB in KB */
-    d->last_update   = clock();
+    d->core_count    = g_platform->cpu_count();
+    d->last_update   = g_platform->now_s();
 }
 
 /* -------------------------------------------------------------------------
@@ -31,14 +31,15 @@ void tm_perf_data_init(TmPerfData *d) {
  * ---------------------------------------------------------------------- */
 
 static void update_cpu(TmPerfData *d) {
-    d->cpu_percent = g_platform->sample_cpu();
+    d->cpu_percent = g_platform->sample_cpu(&d->cpu_ticks);
     if (d->cpu_percent > 100.0f) d->cpu_percent = 100.0f;
     d->cpu_history[d->cpu_idx] = d->cpu_percent;
     d->cpu_idx = (d->cpu_idx + 1) % TM_HIST_LEN;
+    d->cpu_seq++;
 }
 
 static void update_memory(TmPerfData *d) {
-    g_platform->query_memory(&d->mem_used_kb, &d->mem_total_kb);
+    g_platform->query_memory(&d->mem_used_kb, &d->mem_total_kb);   /* 0/0: unknown */
     if (d->mem_used_kb > d->mem_total_kb)
         d->mem_used_kb = d->mem_total_kb;
     d->mem_available_kb      = d->mem_total_kb - d->mem_used_kb;
@@ -58,6 +59,19 @@ static void update_gpu(TmPerfData *d) {
     if (d->gpu_percent > 100.0f) d->gpu_percent = 100.0f;
     d->gpu_history[d->gpu_idx] = d->gpu_percent;
     d->gpu_idx = (d->gpu_idx + 1) % TM_HIST_LEN;
+    d->gpu_seq++;
+}
+
+static void update_cores(TmPerfData *d) {
+    int n = g_platform->sample_cpu_cores(d->core_ticks, d->core_percent, TM_MAX_CORES);
+    if (n <= 0) return;
+    d->core_count = n;
+    for (int i = 0; i < n; i++) {
+        if (d->core_percent[i] > 100.0f) d->core_percent[i] = 100.0f;
+        d->core_history[i][d->core_idx] = d->core_percent[i];
+    }
+    d->core_idx = (d->core_idx + 1) % TM_CORE_HIST_LEN;
+    d->core_seq++;
 }
 
 static void update_threads(TmPerfData *d) {
@@ -70,25 +84,27 @@ static void update_threads(TmPerfData *d) {
 
 float tm_perf_delta_seconds(const TmPerfData *d) {
     if (!d) return 0.0f;
-    return (float)(clock() - d->last_update) / (float)CLOCKS_PER_SEC;
+    return (float)(g_platform->now_s() - d->last_update);
 }
 
-tm_result_t tm_perf_update(TmAppState *s) {
+tm_result_t tm_perf_sample(TmAppState *s, uint32_t sets) {
     if (!s) return TM_ERR_INVALID_ARG;
 
-    float delta = tm_perf_delta_seconds(&s->perf);
-    if (delta < TM_PERF_UPDATE_INTERVAL_S) return TM_OK;
-
-    s->perf.last_update    = clock();
-    s->perf.process_count  = s->process_count;
-    s->perf.uptime_s      += (uint32_t)delta;
-
-    update_cpu(&s->perf);
-    update_memory(&s->perf);
-    update_disk(&s->perf);
-    update_gpu(&s->perf);
-    update_threads(&s->perf);
-
-    TM_CHECK(tm_history_tick(s));
+    if (sets & TM_DATA_SYSTEM) {
+        float delta = tm_perf_delta_seconds(&s->perf);
+        s->perf.last_update    = g_platform->now_s();
+        s->perf.process_count  = s->process_count;
+        s->perf.uptime_s      += delta;
+
+        update_cpu(&s->perf);
+        update_memory(&s->perf);
+    }
+    if (sets & TM_DATA_PERF_DETAIL) {
+        update_disk(&s->perf);
+        update_gpu(&s->perf);
+        update_cores(&s->perf);
+        update_threads(&s->perf);
+    }
+    tm_event_publish(TM_EVENT_SYSTEM_SAMPLED);
     return TM_OK;
 }
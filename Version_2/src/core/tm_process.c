@@ -9,87 +9,299 @@
 
 #include "../../include/tm_process.h"
 #include "../../include/tm_platform.h"
+#include "../../include/tm_event.h"
 #include "../../include/tm_log.h"
 
 /* -------------------------------------------------------------------------
- * Observer registry (module-private)
+ * List management
  * ---------------------------------------------------------------------- */
 
-static TmObserver s_observers[TM_MAX_OBSERVERS];
-static int        s_observer_count = 0;
-
-static void notify_observers(const TmAppState *s) {
-    for (int i = 0; i < s_observer_count; i++) {
-        if (s_observers[i].on_process_changed) {
-            s_observers[i].on_process_changed(s, s_observers[i].user_data);
-        }
+static void free_nodes(TmProcess *head) {
+    while (head) {
+        TmProcess *nxt = head->next;
+        free(head);
+        head = nxt;
     }
 }
 
-tm_result_t tm_process_observer_add(TmProcessChangedFn fn, void *user) {
-    if (!fn || s_observer_count >= TM_MAX_OBSERVERS)
-        return TM_ERR_INVALID_ARG;
-    s_observers[s_observer_count++] = (TmObserver){ fn, user };
-    return TM_OK;
-}
-
-/* -------------------------------------------------------------------------
- * List management
- * ---------------------------------------------------------------------- */
-
 void tm_process_list_free(TmAppState *s) {
     if (!s) return;
-    TmProcess *cur = s->process_list;
-    while (cur) {
-        TmProcess *nxt = cur->next;
-        free(cur);
-        cur = nxt;
-    }
+    free_nodes(s->process_list);
+    free(s->process_index);
     s->process_list  = NULL;
+    s->process_index = NULL;
     s->process_count = 0;
 }
 
-/* Allocate and prepend a copy of @p entry to the process list. */
-static tm_result_t prepend_process(TmAppState *s, const TmProcess *entry) {
+/* Rebuild the positional index so rows are reachable in O(1). */
+static tm_result_t build_process_index(TmAppState *s) {
+    TmProcess **ix = (TmProcess **)realloc(s->process_index,
+                                           (size_t)(s->process_count + 1) * sizeof(*ix));
+    if (!ix) return TM_ERR_ALLOC;
+    s->process_index = ix;
+
+    int i = 0;
+    for (TmProcess *p = s->process_list; p; p = p->next) ix[i++] = p;
+    return TM_OK;
+}
+
+/* Allocate and prepend a copy of @p entry to the list at @p head. */
+static tm_result_t prepend_process(TmProcess **head, int *count, const TmProcess *entry) {
     TmProcess *node = (TmProcess *)malloc(sizeof(TmProcess));
     if (!node) return TM_ERR_ALLOC;
-    *node         = *entry;
-    node->next    = s->process_list;
-    s->process_list = node;
-    s->process_count++;
+    *node      = *entry;
+    node->next = *head;
+    *head      = node;
+    (*count)++;
     return TM_OK;
 }
 
-tm_result_t tm_process_list_refresh(TmAppState *s) {
-    if (!s) return TM_ERR_INVALID_ARG;
+/* -------------------------------------------------------------------------
+ * PID index (open addressing) -- carries cached details across a rebuild
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    TmProcess **slots;
+    uint32_t    mask;
+} TmPidIndex;
+
+static uint32_t pid_hash(uint32_t pid) {
+    return pid * 2654435761u;  /* Knuth multiplicative hash */
+}
+
+static bool pid_index_build(TmPidIndex *ix, TmProcess *list, int count) {
+    uint32_t cap = 16;
+    while (cap < (uint32_t)count * 2u) cap <<= 1;
+    ix->slots = (TmProcess **)calloc(cap, sizeof(TmProcess *));
+    ix->mask  = cap - 1;
+    if (!ix->slots) return false;
+
+    for (TmProcess *p = list; p; p = p->next) {
+        uint32_t i = pid_hash(p->pid) & ix->mask;
+        while (ix->slots[i]) i = (i + 1) & ix->mask;
+        ix->slots[i] = p;
+    }
+    return true;
+}
+
+static const TmProcess *pid_index_find(const TmPidIndex *ix, uint32_t pid) {
+    uint32_t i = pid_hash(pid) & ix->mask;
+    while (ix->slots[i]) {
+        if (ix->slots[i]->pid == pid) return ix->slots[i];
+        i = (i + 1) & ix->mask;
+    }
+    return NULL;
+}
+
+/* Same process as @p old: the PID matches and, where known, so does the start time. */
+static bool same_process(const TmProcess *p, const TmProcess *old) {
+    return !p->start_ticks || !old->start_ticks || p->start_ticks == old->start_ticks;
+}
+
+/*
+ * CPU over the @p dt seconds since @p old was sampled, from the cumulative
+ * counters. Adapters without counters report a current value already; a
+ * process seen for the first time only has the adapter's figure.
+ */
+static void derive_interval_cpu(TmProcess *p, const TmProcess *old, double dt) {
+    p->cpu_interval = p->cpu_percent;
+    if (!p->start_ticks || !old || old->start_ticks != p->start_ticks || dt <= 0.0) return;
+    double used = p->cpu_time_s - old->cpu_time_s;
+    p->cpu_interval = (used > 0.0) ? (float)(used / dt * 100.0) : 0.0f;
+}
+
+/* Carry cached detail, trend and history state from @p old_list into matching new nodes. */
+static void carry_over_details(TmProcess *list, TmProcess *old_list, int old_count, double dt) {
+    TmPidIndex ix = { NULL, 0 };
+    if (old_list) pid_index_build(&ix, old_list, old_count);   /* on failure details refetch */
 
-    tm_process_list_free(s);
+    for (TmProcess *p = list; p; p = p->next) {
+        const TmProcess *old = ix.slots ? pid_index_find(&ix, p->pid) : NULL;
+        if (old && !same_process(p, old)) old = NULL;      /* PID was reused */
+        derive_interval_cpu(p, old, dt);
+        if (!old) continue;
+        p->detail  = old->detail;
+        p->trend   = old->trend;
+        p->history = old->history;
+    }
+    free(ix.slots);
+}
+
+/* Re-select the process with @p pid after a rebuild; clears selection if gone. */
+static void restore_selection(TmAppState *s, uint32_t pid, bool had_selection) {
+    s->selected_process_idx = -1;
+    for (int i = 0; i < s->process_count && had_selection; i++) {
+        TmProcess *p = s->process_index[i];
+        if (p->pid != pid) continue;
+        p->is_selected          = true;
+        s->selected_process_idx = i;
+        break;
+    }
+    s->end_task_btn.is_enabled = (s->selected_process_idx >= 0);
+}
+
+/* Append this refresh's interval CPU to every process ring. */
+static void push_history(TmAppState *s) {
+    s->process_seq++;
+    int slot = (int)(s->process_seq % TM_PROC_HIST_LEN);
+    for (TmProcess *p = s->process_list; p; p = p->next) {
+        p->history.cpu[slot] = p->cpu_interval;
+        p->history.samples++;
+    }
+}
+
+tm_result_t tm_process_list_gather(TmProcess **list, int *count) {
+    if (!list || !count) return TM_ERR_INVALID_ARG;
+    *list  = NULL;
+    *count = 0;
 
-    FILE *fp = g_platform->open_process_list();
-    if (!fp) {
+    TmProcessList *pl = g_platform->open_process_list();
+    if (!pl) {
         tm_log_error("open_process_list() failed");
         return TM_ERR_IO;
     }
 
-    TmProcess entry = {0};
-    while (g_platform->parse_process_line(fp, &entry)) {
-        tm_result_t r = prepend_process(s, &entry);
-        if (r != TM_OK) {
-            pclose(fp);
-            return r;
-        }
+    TmProcess   entry = {0};
+    tm_result_t r     = TM_OK;
+    while (r == TM_OK && g_platform->parse_process_line(pl, &entry)) {
+        r = prepend_process(list, count, &entry);
     }
-    pclose(fp);
+    g_platform->close_process_list(pl);
 
-    /* Reset selection after refresh */
-    s->selected_process_idx  = -1;
-    s->end_task_btn.is_enabled = false;
+    if (r != TM_OK) {
+        free_nodes(*list);
+        *list  = NULL;
+        *count = 0;
+    }
+    return r;
+}
 
-    notify_observers(s);
-    tm_log_info("Process list refreshed: %d entries", s->process_count);
+void tm_process_nodes_free(TmProcess *list) {
+    free_nodes(list);
+}
+
+/* Link the first @p v->count rows in order and index them */
+static void view_relink(TmProcessView *v) {
+    for (int i = 0; i < v->count; i++) {
+        v->rows[i].next = (i + 1 < v->count) ? &v->rows[i + 1] : NULL;
+        v->index[i]     = &v->rows[i];
+    }
+}
+
+tm_result_t tm_process_view_copy(TmProcessView *v, const TmAppState *src) {
+    if (!v || !src) return TM_ERR_INVALID_ARG;
+    int n = src->process_count;
+    if (n > v->cap) {
+        int        cap  = (n > 2 * v->cap) ? n : 2 * v->cap;
+        TmProcess *rows = (TmProcess *)realloc(v->rows, (size_t)cap * sizeof(*rows));
+        if (!rows) return TM_ERR_ALLOC;
+        v->rows = rows;
+        view_relink(v);                 /* the old rows may have moved */
+        TmProcess **ix = (TmProcess **)realloc(v->index, (size_t)cap * sizeof(*ix));
+        if (!ix) return TM_ERR_ALLOC;
+        v->index = ix;
+        v->cap   = cap;
+    }
+
+    int i = 0;
+    for (const TmProcess *p = src->process_list; p && i < n; p = p->next) v->rows[i++] = *p;
+    v->count = i;
+    v->seq   = src->process_seq;
+    view_relink(v);
+    return TM_OK;
+}
+
+void tm_process_view_attach(const TmProcessView *v, TmAppState *s) {
+    if (!v || !s) return;
+    s->process_list  = v->count ? v->rows : NULL;
+    s->process_index = v->index;
+    s->process_count = v->count;
+    s->process_seq   = v->seq;
+}
+
+void tm_process_view_free(TmProcessView *v) {
+    if (!v) return;
+    free(v->rows);
+    free(v->index);
+    *v = (TmProcessView){0};
+}
+
+/* Swap @p list in for the current one; the old nodes are returned to the caller. */
+static TmProcess *install_list(TmAppState *s, TmProcess *list, int count,
+                               uint32_t *sel_pid, bool *had_sel) {
+    /* Selection survives periodic refreshes as long as the PID does */
+    const TmProcess *sel = tm_process_get_selected(s);
+    *had_sel = (sel != NULL);
+    *sel_pid = sel ? sel->pid : 0;
+
+    TmProcess *old = s->process_list;
+    s->process_list  = list;
+    s->process_count = count;
+    return old;
+}
+
+tm_result_t tm_process_list_adopt(TmAppState *s, TmProcess *list, int count) {
+    if (!s) {
+        free_nodes(list);
+        return TM_ERR_INVALID_ARG;
+    }
+    uint32_t   sel_pid;
+    bool       had_sel;
+    int        old_count = s->process_count;
+    double     now       = g_platform->now_s();
+    double     dt        = s->process_at ? now - s->process_at : 0.0;
+    TmProcess *old_list  = install_list(s, list, count, &sel_pid, &had_sel);
+    s->process_at = now;
+
+    /* Old nodes live until the rebuild is done so cached details carry over */
+    carry_over_details(s->process_list, old_list, old_count, dt);
+    free_nodes(old_list);
+    if (build_process_index(s) != TM_OK) {
+        tm_process_list_free(s);
+        restore_selection(s, 0, false);
+        return TM_ERR_ALLOC;
+    }
+    restore_selection(s, sel_pid, had_sel);
+    push_history(s);
+
+    tm_event_publish(TM_EVENT_PROCESSES_CHANGED);
+    tm_log_debug("Process list refreshed: %d entries", s->process_count);
     return TM_OK;
 }
 
+tm_result_t tm_process_list_restore(TmAppState *s, TmProcess *list, int count,
+                                    uint32_t seq) {
+    if (!s) {
+        free_nodes(list);
+        return TM_ERR_INVALID_ARG;
+    }
+    uint32_t sel_pid;
+    bool     had_sel;
+    free_nodes(install_list(s, list, count, &sel_pid, &had_sel));
+    s->process_seq = seq;
+    if (build_process_index(s) != TM_OK) {
+        tm_process_list_free(s);
+        restore_selection(s, 0, false);
+        return TM_ERR_ALLOC;
+    }
+    restore_selection(s, sel_pid, had_sel);
+    return TM_OK;
+}
+
+tm_result_t tm_process_list_refresh(TmAppState *s) {
+    if (!s) return TM_ERR_INVALID_ARG;
+
+    TmProcess  *list;
+    int         count;
+    tm_result_t r = tm_process_list_gather(&list, &count);
+    if (r != TM_OK) {
+        tm_process_list_free(s);
+        restore_selection(s, 0, false);
+        return r;
+    }
+    return tm_process_list_adopt(s, list, count);
+}
+
 /* -------------------------------------------------------------------------
  * Process operations
  * ---------------------------------------------------------------------- */
@@ -98,15 +310,51 @@ tm_result_t tm_process_kill(uint32_t pid) {
     return g_platform->kill_process(pid);
 }
 
-TmProcess *tm_process_get_selected(const TmAppState *s) {
-    if (!s || s->selected_process_idx < 0) return NULL;
+/* Refresh detail for @p p unless it is already cached and @p only_missing. */
+static int fetch_detail(TmProcess *p, bool only_missing) {
+    if (only_missing && p->detail.is_valid) return 0;
+    TmProcessDetail d = {0};
+    if (!g_platform->query_process_detail(p->pid, &d)) return 0;
+    p->detail = d;
+    return 1;
+}
 
-    TmProcess *cur = s->process_list;
-    int        idx = 0;
-    while (cur) {
-        if (idx == s->selected_process_idx) return cur;
-        cur = cur->next;
-        idx++;
+tm_result_t tm_process_fetch_details(TmAppState *s, int first, int count,
+                                     bool only_missing) {
+    if (!s || count < 0) return TM_ERR_INVALID_ARG;
+    if (first < 0) {
+        count += first;
+        first  = 0;
     }
-    return NULL;
+
+    int end     = (first + count < s->process_count) ? first + count : s->process_count;
+    int fetched = 0;
+    for (int i = first; i < end; i++) {
+        fetched += fetch_detail(s->process_index[i], only_missing);
+    }
+    /* The selected row may sit outside the window */
+    int sel = s->selected_process_idx;
+    if (sel >= 0 && sel < s->process_count && (sel < first || sel >= end))
+        fetched += fetch_detail(s->process_index[sel], only_missing);
+
+    if (fetched > 0) tm_event_publish(TM_EVENT_DETAILS_FETCHED);
+    return TM_OK;
+}
+
+TmProcess *tm_process_at(const TmAppState *s, int index) {
+    if (!s || index < 0 || index >= s->process_count) return NULL;
+    return s->process_index[index];
+}
+
+bool tm_process_history_cpu(const TmAppState *s, const TmProcess *p,
+                            uint32_t seq, float *out) {
+    if (!s || !p || !out) return false;
+    uint32_t age = s->process_seq - seq;
+    if (age >= TM_PROC_HIST_LEN || age >= p->history.samples) return false;
+    *out = p->history.cpu[seq % TM_PROC_HIST_LEN];
+    return true;
+}
+
+TmProcess *tm_process_get_selected(const TmAppState *s) {
+    return s ? tm_process_at(s, s->selected_process_idx) : NULL;
 }
@@ -0,0 +1,831 @@
+/**
+ * @file tm_query.c
+ * @brief Query socket server -- business logic, no Raylib.
+ *
+ * Four TmQuerySnaps rotate between the two threads. The sampler fills its
+ * own, then swaps it with `ready` under the lock and wakes the poller; the
+ * server swaps `ready` in as `cur`, keeping the one it replaces as `prev`.
+ * Each delta is therefore a single merge of two PID-sorted arrays, built
+ * once per refresh and copied to every subscriber. If the server falls
+ * behind, the sampler simply overwrites `ready`: deltas are always taken
+ * against what the server last saw, so subscribers stay consistent.
+ *
+ * `pid` needs the costly columns, which only the sampler may ask the
+ * adapter for. The server queues the PID under the lock; the sampler
+ * answers the queue in tm_query_fetch_details() after its next pass and
+ * the server replies then, so that reply can arrive after replies to
+ * later requests.
+ *
+ * Clients are non-blocking. Replies queue in a per-client buffer that the
+ * poller drains as the socket allows; a subscriber still sitting on more
+ * than TM_QUERY_BACKLOG_MAX unsent bytes when the next message arrives is
+ * disconnected rather than buffered without bound.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_query.h"
+#include "../../include/tm_export.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+typedef struct {
+    int        sock;
+    char       in[TM_QUERY_LINE_MAX];
+    size_t     in_len;
+    TmByteBuf  out;
+    size_t     out_off;         /* bytes of out already sent */
+    bool       writing;         /* watching for TM_POLL_OUT */
+    bool       subscribed;
+    bool       need_full;       /* subscribed before the first snapshot */
+    bool       awaiting;        /* `pid detail_pid` is queued for the sampler */
+    uint32_t   detail_pid;
+    bool       dead;            /* closed at the end of the loop pass */
+} TmQueryClient;
+
+/** The sampler's answer to one `pid` request. */
+typedef struct {
+    uint32_t        pid;
+    bool            have;
+    TmProcessDetail detail;
+} TmQueryDetail;
+
+static TmQuerySnap     s_snap[4];
+static TmQuerySnap    *s_fill  = &s_snap[0];   /* sampler's */
+static TmQuerySnap    *s_ready = &s_snap[1];   /* handed over, under s_lock */
+static TmQuerySnap    *s_cur   = &s_snap[2];   /* server's latest */
+static TmQuerySnap    *s_prev  = &s_snap[3];   /* server's previous */
+static bool            s_fresh = false;        /* ready is newer than cur */
+static uint64_t        s_seq   = 0;
+
+static uint32_t        s_asked[TM_QUERY_DETAIL_MAX];    /* under s_lock */
+static int             s_asked_count;
+static TmQueryDetail   s_answers[TM_QUERY_DETAIL_MAX];  /* under s_lock */
+static int             s_answer_count;
+static TmQueryDetail   s_delivered[TM_QUERY_DETAIL_MAX]; /* server's */
+
+static bool            s_stop     = false;
+static TmMutex        *s_lock     = NULL;
+static TmThread       *s_thread   = NULL;
+static TmPoller       *s_poller   = NULL;
+static int             s_listener = -1;
+static char            s_path[256];
+
+/* Server thread only */
+static TmQueryClient **s_clients;
+static int             s_client_count;
+static int             s_client_cap;
+static TmWriter        s_writer;               /* large: keep off the stack */
+static TmByteBuf       s_reply;
+static TmByteBuf       s_delta;
+static TmByteBuf       s_full;
+static uint64_t        s_full_seq;             /* snapshot rendered in s_full */
+static int             s_top[TM_QUERY_TOP_MAX];
+
+/* -------------------------------------------------------------------------
+ * Sampler side
+ * ---------------------------------------------------------------------- */
+
+static bool snap_reserve(TmQuerySnap *q, int n) {
+    if (n <= q->cap) return true;
+    int cap = q->cap ? q->cap : 256;
+    while (cap < n) cap *= 2;
+    TmQueryRow *rows = (TmQueryRow *)realloc(q->rows, (size_t)cap * sizeof(*rows));
+    if (!rows) return false;
+    q->rows = rows;
+    q->cap  = cap;
+    return true;
+}
+
+static int cmp_pid(const void *a, const void *b) {
+    uint32_t x = ((const TmQueryRow *)a)->pid;
+    uint32_t y = ((const TmQueryRow *)b)->pid;
+    return (x > y) - (x < y);
+}
+
+/* Copy at most TM_QUERY_NAME_LEN - 1 bytes without splitting a UTF-8 sequence */
+static void copy_name(char *dst, const char *src) {
+    size_t n = strlen(src);
+    if (n >= TM_QUERY_NAME_LEN) {
+        n = TM_QUERY_NAME_LEN - 1;
+        while (n > 0 && ((unsigned char)src[n] & 0xC0) == 0x80) n--;
+    }
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+/* -------------------------------------------------------------------------
+ * Client buffers
+ * ---------------------------------------------------------------------- */
+
+static void out_append(TmQueryClient *c, const char *p, size_t n) {
+    if (c->dead) return;
+    /* Judge the backlog before this message, so one large snapshot still fits */
+    if (c->out.len - c->out_off > TM_QUERY_BACKLOG_MAX) {
+        tm_log_warn("Query client not reading; disconnecting it");
+        c->dead = true;
+        return;
+    }
+    if (c->out_off > 0) {               /* slide the unsent tail to the front */
+        memmove(c->out.data, c->out.data + c->out_off, c->out.len - c->out_off);
+        c->out.len -= c->out_off;
+        c->out_off  = 0;
+    }
+    if (c->out.len + n > c->out.cap) {
+        size_t cap = c->out.cap ? c->out.cap : 4096;
+        while (cap < c->out.len + n) cap *= 2;
+        char *data = (char *)realloc(c->out.data, cap);
+        if (!data) {
+            c->dead = true;
+            return;
+        }
+        c->out.data = data;
+        c->out.cap  = cap;
+    }
+    memcpy(c->out.data + c->out.len, p, n);
+    c->out.len += n;
+}
+
+/* Send what the socket takes now; watch for writability while any is left */
+static void flush(TmQueryClient *c) {
+    while (!c->dead && c->out_off < c->out.len) {
+        long n = g_platform->sock_send_some(c->sock, c->out.data + c->out_off,
+                                            c->out.len - c->out_off);
+        if (n < 0) c->dead = true;
+        if (n <= 0) break;
+        c->out_off += (size_t)n;
+    }
+    if (c->dead) return;
+    if (c->out_off == c->out.len) c->out.len = c->out_off = 0;
+
+    bool want = c->out.len > 0;
+    if (want != c->writing &&
+        g_platform->poller_watch(s_poller, c->sock, TM_POLL_IN | (want ? TM_POLL_OUT : 0), c))
+        c->writing = want;
+}
+
+/* -------------------------------------------------------------------------
+ * Rendering (all replies go through s_writer)
+ * ---------------------------------------------------------------------- */
+
+static void head(TmWriter *w, const char *type, uint64_t seq) {
+    tm_writer_str(w, "{\"type\":\"");
+    tm_writer_str(w, type);
+    tm_writer_str(w, "\",\"seq\":");
+    tm_writer_u64(w, seq);
+}
+
+/* Row object without its closing brace, so callers can add fields */
+static void write_row_fields(TmWriter *w, const TmQueryRow *r) {
+    tm_writer_str(w, "{\"pid\":");
+    tm_writer_u64(w, r->pid);
+    tm_writer_str(w, ",\"name\":");
+    tm_writer_json_str(w, r->name);
+    tm_writer_str(w, ",\"cpu\":");
+    tm_writer_fixed(w, r->cpu_percent, 1);
+    tm_writer_str(w, ",\"mem_kb\":");
+    tm_writer_u64(w, r->mem_kb);
+}
+
+static void write_row(TmWriter *w, const TmQueryRow *r) {
+    write_row_fields(w, r);
+    tm_writer_bytes(w, "}", 1);
+}
+
+static void separator(TmWriter *w, bool *first) {
+    if (!*first) tm_writer_bytes(w, ",", 1);
+    *first = false;
+}
+
+/* Finish the line in s_reply and queue it for @p c */
+static void send_reply(TmQueryClient *c) {
+    tm_writer_str(&s_writer, "}\n");
+    if (tm_writer_flush(&s_writer) != TM_OK) {
+        c->dead = true;
+        return;
+    }
+    out_append(c, s_reply.data, s_reply.len);
+}
+
+static void reply_error(TmQueryClient *c, const char *msg) {
+    tm_writer_init_mem(&s_writer, &s_reply);
+    tm_writer_str(&s_writer, "{\"type\":\"error\",\"error\":");
+    tm_writer_json_str(&s_writer, msg);
+    send_reply(c);
+}
+
+/* Full table for a new subscriber; rendered once per refresh and shared */
+static void reply_snapshot(TmQueryClient *c) {
+    if (s_full_seq != s_cur->seq) {
+        TmWriter *w     = &s_writer;
+        bool      first = true;
+        tm_writer_init_mem(w, &s_full);
+        head(w, "snapshot", s_cur->seq);
+        tm_writer_str(w, ",\"rows\":[");
+        for (int i = 0; i < s_cur->count; i++) {
+            separator(w, &first);
+            write_row(w, &s_cur->rows[i]);
+        }
+        tm_writer_str(w, "]}\n");
+        if (tm_writer_flush(w) != TM_OK) {
+            c->dead = true;
+            return;
+        }
+        s_full_seq = s_cur->seq;
+    }
+    out_append(c, s_full.data, s_full.len);
+}
+
+/* -------------------------------------------------------------------------
+ * Deltas
+ * ---------------------------------------------------------------------- */
+
+typedef enum { DELTA_ADDED, DELTA_REMOVED, DELTA_CHANGED } TmDeltaKind;
+
+/* CPU as shown (one decimal), so sub-display jitter is not a change */
+static int cpu_tenths(float v) {
+    return (int)(v * 10.0f + 0.5f);
+}
+
+static void write_changes(TmWriter *w, const TmQueryRow *a, const TmQueryRow *b,
+                          bool *first) {
+    bool name = strcmp(a->name, b->name) != 0;
+    bool cpu  = cpu_tenths(a->cpu_percent) != cpu_tenths(b->cpu_percent);
+    bool mem  = a->mem_kb != b->mem_kb;
+    if (!name && !cpu && !mem) return;
+
+    separator(w, first);
+    tm_writer_str(w, "{\"pid\":");
+    tm_writer_u64(w, b->pid);
+    if (name) {
+        tm_writer_str(w, ",\"name\":");
+        tm_writer_json_str(w, b->name);
+    }
+    if (cpu) {
+        tm_writer_str(w, ",\"cpu\":");
+        tm_writer_fixed(w, b->cpu_percent, 1);
+    }
+    if (mem) {
+        tm_writer_str(w, ",\"mem_kb\":");
+        tm_writer_u64(w, b->mem_kb);
+    }
+    tm_writer_bytes(w, "}", 1);
+}
+
+/* One merge of prev and cur, writing the entries of one delta array */
+static void write_delta_array(TmWriter *w, TmDeltaKind kind) {
+    const TmQuerySnap *a = s_prev, *b = s_cur;
+    bool first = true;
+    int  i = 0, j = 0;
+    while (i < a->count || j < b->count) {
+        const TmQueryRow *ra = (i < a->count) ? &a->rows[i] : NULL;
+        const TmQueryRow *rb = (j < b->count) ? &b->rows[j] : NULL;
+        if (rb && (!ra || rb->pid < ra->pid)) {
+            if (kind == DELTA_ADDED) {
+                separator(w, &first);
+                write_row(w, rb);
+            }
+            j++;
+        } else if (ra && (!rb || ra->pid < rb->pid)) {
+            if (kind == DELTA_REMOVED) {
+                separator(w, &first);
+                tm_writer_u64(w, ra->pid);
+            }
+            i++;
+        } else {
+            if (kind == DELTA_CHANGED) write_changes(w, ra, rb, &first);
+            i++;
+            j++;
+        }
+    }
+}
+
+static bool build_delta(void) {
+    TmWriter *w = &s_writer;
+    tm_writer_init_mem(w, &s_delta);
+    head(w, "delta", s_cur->seq);
+    tm_writer_str(w, ",\"added\":[");
+    write_delta_array(w, DELTA_ADDED);
+    tm_writer_str(w, "],\"removed\":[");
+    write_delta_array(w, DELTA_REMOVED);
+    tm_writer_str(w, "],\"changed\":[");
+    write_delta_array(w, DELTA_CHANGED);
+    tm_writer_str(w, "]}\n");
+    return tm_writer_flush(w) == TM_OK;
+}
+
+/* Adopt the sampler's latest snapshot; false if there is none newer */
+static bool take_snapshot(void) {
+    g_platform->mutex_lock(s_lock);
+    bool fresh = s_fresh;
+    if (fresh) {
+        TmQuerySnap *old = s_prev;
+        s_prev  = s_cur;
+        s_cur   = s_ready;
+        s_ready = old;
+        s_fresh = false;
+    }
+    g_platform->mutex_unlock(s_lock);
+    return fresh;
+}
+
+static void publish_to_subscribers(void) {
+    bool built = false, ok = false;
+    for (int i = 0; i < s_client_count; i++) {
+        TmQueryClient *c = s_clients[i];
+        if (c->dead || !c->subscribed) continue;
+        if (c->need_full) {
+            reply_snapshot(c);
+            c->need_full = false;
+        } else {
+            if (!built) {
+                ok    = build_delta();
+                built = true;
+            }
+            if (ok) out_append(c, s_delta.data, s_delta.len);
+            else    c->dead = true;       /* lost a delta: it cannot catch up */
+        }
+        flush(c);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Requests
+ * ---------------------------------------------------------------------- */
+
+/* Next space-separated word of *p, NUL-terminated in place; NULL at the end */
+static char *next_word(char **p) {
+    char *s = *p;
+    while (*s == ' ' || *s == '\t') s++;
+    if (!*s) return NULL;
+    char *word = s;
+    while (*s && *s != ' ' && *s != '\t') s++;
+    if (*s) *s++ = '\0';
+    *p = s;
+    return word;
+}
+
+/* Does row a rank below row b? Ties go to the lower PID. */
+static bool ranks_below(const TmQueryRow *a, const TmQueryRow *b, bool by_mem) {
+    if (by_mem) {
+        if (a->mem_kb != b->mem_kb) return a->mem_kb < b->mem_kb;
+    } else if (a->cpu_percent != b->cpu_percent) {
+        return a->cpu_percent < b->cpu_percent;
+    }
+    return a->pid > b->pid;
+}
+
+/* Restore the min-heap (weakest row at the root) below slot @p i */
+static void sift_down(int *heap, int n, int i, bool by_mem) {
+    const TmQueryRow *rows = s_cur->rows;
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, min = i;
+        if (l < n && ranks_below(&rows[heap[l]], &rows[heap[min]], by_mem)) min = l;
+        if (r < n && ranks_below(&rows[heap[r]], &rows[heap[min]], by_mem)) min = r;
+        if (min == i) return;
+        int t = heap[i];
+        heap[i]   = heap[min];
+        heap[min] = t;
+        i = min;
+    }
+}
+
+/* `top N [cpu|mem]`: a bounded heap keeps this O(rows log N) */
+static void query_top(TmQueryClient *c, char *args) {
+    char *count = next_word(&args);
+    char *key   = next_word(&args);
+    long  n     = count ? strtol(count, NULL, 10) : 0;
+    if (n < 1 || (key && strcmp(key, "cpu") != 0 && strcmp(key, "mem") != 0)) {
+        reply_error(c, "usage: top N [cpu|mem]");
+        return;
+    }
+    if (n > TM_QUERY_TOP_MAX) n = TM_QUERY_TOP_MAX;
+    bool by_mem = key && strcmp(key, "mem") == 0;
+
+    const TmQueryRow *rows = s_cur->rows;
+    int               size = 0;
+    for (int i = 0; i < s_cur->count; i++) {
+        if (size < n) {
+            int k = size++;                 /* sift up */
+            s_top[k] = i;
+            while (k > 0 && ranks_below(&rows[s_top[k]], &rows[s_top[(k - 1) / 2]], by_mem)) {
+                int p = (k - 1) / 2, t = s_top[k];
+                s_top[k] = s_top[p];
+                s_top[p] = t;
+                k = p;
+            }
+        } else if (ranks_below(&rows[s_top[0]], &rows[i], by_mem)) {
+            s_top[0] = i;
+            sift_down(s_top, size, 0, by_mem);
+        }
+    }
+    /* Heapsort: popping the weakest to the back leaves the array best-first */
+    for (int end = size - 1; end > 0; end--) {
+        int t = s_top[0];
+        s_top[0]   = s_top[end];
+        s_top[end] = t;
+        sift_down(s_top, end, 0, by_mem);
+    }
+
+    TmWriter *w     = &s_writer;
+    bool      first = true;
+    tm_writer_init_mem(w, &s_reply);
+    head(w, "top", s_cur->seq);
+    tm_writer_str(w, by_mem ? ",\"by\":\"mem\",\"rows\":[" : ",\"by\":\"cpu\",\"rows\":[");
+    for (int i = 0; i < size; i++) {
+        separator(w, &first);
+        write_row(w, &rows[s_top[i]]);
+    }
+    tm_writer_bytes(w, "]", 1);
+    send_reply(c);
+}
+
+static const TmQueryRow *find_row(uint32_t pid) {
+    int lo = 0, hi = s_cur->count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if      (s_cur->rows[mid].pid < pid) lo = mid + 1;
+        else if (s_cur->rows[mid].pid > pid) hi = mid - 1;
+        else                                 return &s_cur->rows[mid];
+    }
+    return NULL;
+}
+
+/* Queue @p pid for the sampler unless it is already queued; false if full */
+static bool ask_sampler(uint32_t pid) {
+    g_platform->mutex_lock(s_lock);
+    int i = 0;
+    while (i < s_asked_count && s_asked[i] != pid) i++;
+    bool ok = i < s_asked_count || s_asked_count < TM_QUERY_DETAIL_MAX;
+    if (ok && i == s_asked_count) s_asked[s_asked_count++] = pid;
+    g_platform->mutex_unlock(s_lock);
+    return ok;
+}
+
+/* `pid PID`: the costly columns come from the sampler, see reply_pid() */
+static void query_pid(TmQueryClient *c, char *args) {
+    char *word = next_word(&args);
+    char *end  = NULL;
+    unsigned long pid = word ? strtoul(word, &end, 10) : 0;
+    if (!word || *end || pid > UINT32_MAX) {
+        reply_error(c, "usage: pid PID");
+        return;
+    }
+    if (!find_row((uint32_t)pid)) {
+        reply_error(c, "no such pid");
+        return;
+    }
+    if (c->awaiting) {
+        reply_error(c, "a pid request is already pending");
+        return;
+    }
+    if (!ask_sampler((uint32_t)pid)) {
+        reply_error(c, "too many pid requests pending");
+        return;
+    }
+    c->awaiting   = true;
+    c->detail_pid = (uint32_t)pid;
+}
+
+/* The current snapshot row plus the sampler's costly columns */
+static void reply_pid(TmQueryClient *c, const TmQueryDetail *a) {
+    const TmQueryRow *row = find_row(a->pid);
+    if (!row) {
+        reply_error(c, "no such pid");     /* ended while queued */
+        return;
+    }
+    const TmProcessDetail *d = &a->detail;
+
+    TmWriter *w = &s_writer;
+    tm_writer_init_mem(w, &s_reply);
+    head(w, "pid", s_cur->seq);
+    tm_writer_str(w, ",\"row\":");
+    write_row_fields(w, row);
+    if (a->have) {
+        tm_writer_str(w, ",\"pss_kb\":");
+        tm_writer_u64(w, d->pss_kb);
+        tm_writer_str(w, ",\"io_bytes\":");
+        tm_writer_u64(w, d->io_bytes);
+        tm_writer_str(w, ",\"fd_count\":");
+        tm_writer_u64(w, d->fd_count > 0 ? (uint64_t)d->fd_count : 0);
+        tm_writer_str(w, ",\"cmdline\":");
+        tm_writer_json_str(w, d->cmdline);
+    }
+    tm_writer_bytes(w, "}", 1);
+    send_reply(c);
+}
+
+/* Reply to every client waiting on a PID the sampler has answered */
+static void deliver_details(void) {
+    g_platform->mutex_lock(s_lock);
+    int n = s_answer_count;
+    memcpy(s_delivered, s_answers, (size_t)n * sizeof(s_answers[0]));
+    s_answer_count = 0;
+    g_platform->mutex_unlock(s_lock);
+
+    for (int k = 0; k < n; k++) {
+        for (int i = 0; i < s_client_count; i++) {
+            TmQueryClient *c = s_clients[i];
+            if (c->dead || !c->awaiting || c->detail_pid != s_delivered[k].pid) continue;
+            c->awaiting = false;
+            reply_pid(c, &s_delivered[k]);
+            flush(c);
+        }
+    }
+}
+
+static void query_system(TmQueryClient *c) {
+    TmWriter *w = &s_writer;
+    tm_writer_init_mem(w, &s_reply);
+    head(w, "system", s_cur->seq);
+    tm_writer_str(w, ",\"cpu\":");
+    tm_writer_fixed(w, s_cur->cpu_percent, 1);
+    tm_writer_str(w, ",\"mem_used_kb\":");
+    tm_writer_u64(w, s_cur->mem_used_kb);
+    tm_writer_str(w, ",\"mem_total_kb\":");
+    tm_writer_u64(w, s_cur->mem_total_kb);
+    tm_writer_str(w, ",\"processes\":");
+    tm_writer_u64(w, (uint64_t)s_cur->count);
+    send_reply(c);
+}
+
+static void handle_line(TmQueryClient *c, char *line) {
+    char *verb = next_word(&line);
+    if (!verb) return;                      /* blank line */
+
+    if (strcmp(verb, "subscribe") == 0) {
+        c->subscribed = true;
+        c->need_full  = s_cur->seq == 0;
+        if (!c->need_full) reply_snapshot(c);
+        return;
+    }
+    if (strcmp(verb, "unsubscribe") == 0) {
+        c->subscribed = false;
+        c->need_full  = false;
+        tm_writer_init_mem(&s_writer, &s_reply);
+        tm_writer_str(&s_writer, "{\"type\":\"ok\"");
+        send_reply(c);
+        return;
+    }
+
+    bool known = strcmp(verb, "top") == 0 || strcmp(verb, "pid") == 0 ||
+                 strcmp(verb, "system") == 0;
+    if (!known) {
+        reply_error(c, "unknown request (top, pid, system, subscribe, unsubscribe)");
+        return;
+    }
+    if (s_cur->seq == 0) {
+        reply_error(c, "no snapshot yet");
+        return;
+    }
+    if      (verb[0] == 't') query_top(c, line);
+    else if (verb[0] == 'p') query_pid(c, line);
+    else                     query_system(c);
+}
+
+/* -------------------------------------------------------------------------
+ * Server thread
+ * ---------------------------------------------------------------------- */
+
+static bool stopping(void) {
+    g_platform->mutex_lock(s_lock);
+    bool stop = s_stop;
+    g_platform->mutex_unlock(s_lock);
+    return stop;
+}
+
+static void on_accept(void) {
+    for (;;) {
+        int sock = g_platform->sock_accept(s_listener, 0.0);
+        if (sock < 0) return;
+
+        if (s_client_count == s_client_cap) {
+            int             cap     = s_client_cap ? s_client_cap * 2 : 16;
+            TmQueryClient **clients = (TmQueryClient **)realloc(
+                s_clients, (size_t)cap * sizeof(*clients));
+            if (!clients) {
+                g_platform->sock_close(sock);
+                return;
+            }
+            s_clients    = clients;
+            s_client_cap = cap;
+        }
+        TmQueryClient *c = (TmQueryClient *)calloc(1, sizeof(*c));
+        if (!c || !g_platform->poller_watch(s_poller, sock, TM_POLL_IN, c)) {
+            free(c);
+            g_platform->sock_close(sock);
+            continue;
+        }
+        c->sock = sock;
+        s_clients[s_client_count++] = c;
+    }
+}
+
+static void on_readable(TmQueryClient *c) {
+    long n = g_platform->sock_recv(c->sock, c->in + c->in_len,
+                                   sizeof(c->in) - c->in_len, 0.0);
+    if (n <= 0) {
+        c->dead = true;
+        return;
+    }
+    c->in_len += (size_t)n;
+
+    size_t start = 0;
+    for (size_t i = 0; i < c->in_len && !c->dead; i++) {
+        if (c->in[i] != '\n') continue;
+        c->in[i] = '\0';
+        if (i > start && c->in[i - 1] == '\r') c->in[i - 1] = '\0';
+        handle_line(c, c->in + start);
+        start = i + 1;
+    }
+    memmove(c->in, c->in + start, c->in_len - start);
+    c->in_len -= start;
+    if (c->in_len == sizeof(c->in)) {
+        reply_error(c, "request line too long");
+        c->in_len = 0;
+    }
+    flush(c);
+}
+
+static void drop(TmQueryClient *c) {
+    g_platform->poller_forget(s_poller, c->sock);
+    g_platform->sock_close(c->sock);
+    free(c->out.data);
+    free(c);
+}
+
+static void reap(void) {
+    for (int i = 0; i < s_client_count; ) {
+        if (s_clients[i]->dead) {
+            drop(s_clients[i]);
+            s_clients[i] = s_clients[--s_client_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+static void serve(void *arg) {
+    (void)arg;
+    TmPollEvent ev[64];
+    while (!stopping()) {
+        int n = g_platform->poller_wait(s_poller, ev, 64, TM_QUERY_WAIT_S);
+        if (take_snapshot()) publish_to_subscribers();
+        deliver_details();
+
+        for (int i = 0; i < n; i++) {
+            if (ev[i].user == &s_listener) {
+                on_accept();
+                continue;
+            }
+            TmQueryClient *c = (TmQueryClient *)ev[i].user;
+            if (c->dead) continue;
+            if (ev[i].events & TM_POLL_IN)        on_readable(c);
+            else if (ev[i].events & TM_POLL_HUP)  c->dead = true;
+            if (!c->dead && (ev[i].events & TM_POLL_OUT)) flush(c);
+        }
+        reap();
+    }
+
+    for (int i = 0; i < s_client_count; i++) drop(s_clients[i]);
+    free(s_clients);
+    s_clients      = NULL;
+    s_client_count = 0;
+    s_client_cap   = 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+const char *tm_query_socket_arg(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i++)
+        if (strcmp(argv[i], "--query-socket") == 0) return argv[i + 1];
+    return NULL;
+}
+
+tm_result_t tm_query_start(const char *path) {
+    if (!path || !*path || strlen(path) >= sizeof(s_path)) return TM_ERR_INVALID_ARG;
+    if (s_thread) return TM_OK;
+
+    s_lock   = g_platform->mutex_create();
+    s_poller = g_platform->poller_create();
+    if (!s_lock || !s_poller) {
+        tm_result_t rc = s_lock ? TM_ERR_PLATFORM : TM_ERR_ALLOC;
+        if (!s_poller) tm_log_error("Query socket needs a readiness poller on this platform");
+        tm_query_stop();
+        return rc;
+    }
+    s_listener = g_platform->uds_listen(path);
+    if (s_listener < 0 || !g_platform->poller_watch(s_poller, s_listener, TM_POLL_IN, &s_listener)) {
+        tm_query_stop();
+        return TM_ERR_PLATFORM;
+    }
+    snprintf(s_path, sizeof(s_path), "%s", path);
+
+    s_stop   = false;
+    s_thread = g_platform->thread_start(serve, NULL);
+    if (!s_thread) {
+        tm_query_stop();
+        return TM_ERR_PLATFORM;
+    }
+    tm_log_info("Serving queries on %s", path);
+    return TM_OK;
+}
+
+void tm_query_fetch_details(void) {
+    if (!s_thread) return;
+    uint32_t pids[TM_QUERY_DETAIL_MAX];
+    g_platform->mutex_lock(s_lock);
+    int n = s_asked_count;
+    if (n > TM_QUERY_DETAIL_MAX - s_answer_count) n = TM_QUERY_DETAIL_MAX - s_answer_count;
+    memcpy(pids, s_asked, (size_t)n * sizeof(pids[0]));
+    memmove(s_asked, s_asked + n, (size_t)(s_asked_count - n) * sizeof(s_asked[0]));
+    s_asked_count -= n;
+    g_platform->mutex_unlock(s_lock);
+
+    for (int i = 0; i < n; i++) {
+        TmQueryDetail a;
+        memset(&a, 0, sizeof(a));
+        a.pid  = pids[i];
+        a.have = g_platform->query_process_detail(a.pid, &a.detail);
+        g_platform->mutex_lock(s_lock);
+        s_answers[s_answer_count++] = a;
+        g_platform->mutex_unlock(s_lock);
+    }
+    if (n > 0) g_platform->poller_wake(s_poller);
+}
+
+void tm_query_publish(const TmAppState *s) {
+    if (!s || !s_thread) return;
+
+    TmQuerySnap *q = s_fill;
+    if (!snap_reserve(q, s->process_count)) {
+        tm_log_warn("Query snapshot allocation failed; refresh not published");
+        return;
+    }
+    int  n      = 0;
+    bool sorted = true;
+    for (const TmProcess *p = s->process_list; p && n < q->cap; p = p->next) {
+        TmQueryRow *r = &q->rows[n];
+        r->pid         = p->pid;
+        r->cpu_percent = p->cpu_interval;
+        r->mem_kb      = p->memory_bytes / 1024;
+        copy_name(r->name, p->name);
+        if (n > 0 && q->rows[n - 1].pid >= r->pid) sorted = false;
+        n++;
+    }
+    if (!sorted) qsort(q->rows, (size_t)n, sizeof(q->rows[0]), cmp_pid);
+    q->count        = n;
+    q->seq          = ++s_seq;
+    q->cpu_percent  = s->perf.cpu_percent;
+    q->mem_used_kb  = s->perf.mem_used_kb;
+    q->mem_total_kb = s->perf.mem_total_kb;
+
+    g_platform->mutex_lock(s_lock);
+    s_fill  = s_ready;
+    s_ready = q;
+    s_fresh = true;
+    g_platform->mutex_unlock(s_lock);
+    g_platform->poller_wake(s_poller);
+}
+
+void tm_query_stop(void) {
+    if (s_thread) {
+        g_platform->mutex_lock(s_lock);
+        s_stop = true;
+        g_platform->mutex_unlock(s_lock);
+        g_platform->poller_wake(s_poller);
+        g_platform->thread_join(s_thread);
+    }
+    if (s_listener >= 0) {
+        g_platform->poller_forget(s_poller, s_listener);
+        g_platform->sock_close(s_listener);
+        if (s_path[0]) g_platform->remove_file(s_path);
+    }
+    if (s_poller) g_platform->poller_destroy(s_poller);
+    if (s_lock)   g_platform->mutex_destroy(s_lock);
+
+    for (int i = 0; i < 4; i++) {
+        free(s_snap[i].rows);
+        s_snap[i] = (TmQuerySnap){0};
+    }
+    free(s_reply.data);
+    free(s_delta.data);
+    free(s_full.data);
+    s_reply    = (TmByteBuf){0};
+    s_delta    = (TmByteBuf){0};
+    s_full     = (TmByteBuf){0};
+    s_full_seq = 0;
+    s_fresh    = false;
+    s_seq      = 0;
+    s_asked_count  = 0;
+    s_answer_count = 0;
+    s_thread   = NULL;
+    s_poller   = NULL;
+    s_lock     = NULL;
+    s_listener = -1;
+    s_path[0]  = '\0';
+}
@@ -0,0 +1,451 @@
+/**
+ * @file tm_record.c
+ * @brief Binary snapshot recorder and mmap reader -- business logic, no Raylib.
+ *
+ * File layout (integers little-endian, varints LEB128):
+ *
+ *   header   "TMRC" u16 version, u16 header_bytes, u64 created_ms
+ *   frame *  one per snapshot, self-delimiting (see below)
+ *   index    frame_count x { u64 ts_ms, u64 frame_offset }
+ *   trailer  "TMIX" u32 frame_count, u64 index_offset
+ *
+ * Frame: a fixed header followed by one column per field, so a reader
+ * can pull a single column without touching the others.
+ *
+ *   "TMFR" u32 frame_bytes, u64 ts_ms, u32 row_count, u32 string_count,
+ *   u32 cpu_total (0.01 %), u32 core_count, u64 mem_used_kb,
+ *   u64 mem_total_kb, u32 column offsets from the frame start:
+ *   cores    core_count varints, 0.01 %
+ *   strings  each distinct process name once, NUL-terminated
+ *   pid      varint delta from the previous row (rows sorted by pid)
+ *   name     varint byte offset into strings
+ *   cpu      varint, 0.01 %
+ *   mem      varint, KiB
+ *
+ * Frames are independent of each other, so seeking never replays history.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_record.h"
+#include "../../include/tm_export.h"
+#include "../../include/tm_process.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+#define FILE_HDR     16
+#define FRAME_HDR    72
+#define TRAILER      16
+#define INDEX_ENTRY  16
+#define COLUMNS      6      /* cores, strings, pid, name, cpu, mem */
+
+/* -------------------------------------------------------------------------
+ * Byte helpers
+ * ---------------------------------------------------------------------- */
+
+static void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_u64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+static uint64_t get_u64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+static uint8_t *put_varint(uint8_t *p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v  >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static bool get_varint(const uint8_t **p, const uint8_t *end, uint64_t *out) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64 && *p < end; shift += 7) {
+        uint8_t b = *(*p)++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t centi(float v) {
+    return (v > 0.0f) ? (uint32_t)(v * 100.0f + 0.5f) : 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Recorder
+ * ---------------------------------------------------------------------- */
+
+static uint64_t out_pos(const TmWriter *w) {
+    return w->bytes + w->len;
+}
+
+static tm_result_t ensure_rows(TmRecWriter *r, int n) {
+    if (n <= r->rows_cap) return TM_OK;
+    int cap = r->rows_cap ? r->rows_cap : 256;
+    while (cap < n) cap *= 2;
+    int slots = 1;
+    while (slots < 2 * cap) slots <<= 1;
+
+    TmRecKey *keys = (TmRecKey *)realloc(r->keys, (size_t)cap * sizeof(*keys));
+    if (!keys) return TM_ERR_ALLOC;
+    r->keys = keys;
+    uint32_t *off = (uint32_t *)realloc(r->name_off, (size_t)cap * sizeof(*off));
+    if (!off) return TM_ERR_ALLOC;
+    r->name_off = off;
+    int32_t *sl = (int32_t *)realloc(r->slots, (size_t)slots * sizeof(*sl));
+    if (!sl) return TM_ERR_ALLOC;
+    r->slots     = sl;
+    r->rows_cap  = cap;
+    r->slot_mask = slots - 1;
+    return TM_OK;
+}
+
+static bool frame_reserve(TmRecWriter *r, size_t n) {
+    if (n <= r->frame_cap) return true;
+    size_t cap = r->frame_cap ? r->frame_cap : 4096;
+    while (cap < n) cap *= 2;
+    uint8_t *p = (uint8_t *)realloc(r->frame, cap);
+    if (!p) return false;
+    r->frame     = p;
+    r->frame_cap = cap;
+    return true;
+}
+
+static bool index_append(TmRecWriter *r, uint64_t ts_ms, uint64_t offset) {
+    if (r->frame_count == r->index_cap) {
+        uint32_t cap = r->index_cap ? r->index_cap * 2 : 1024;
+        uint8_t *p   = (uint8_t *)realloc(r->index, (size_t)cap * INDEX_ENTRY);
+        if (!p) return false;
+        r->index     = p;
+        r->index_cap = cap;
+    }
+    uint8_t *e = r->index + (size_t)r->frame_count * INDEX_ENTRY;
+    put_u64(e, ts_ms);
+    put_u64(e + 8, offset);
+    r->frame_count++;
+    return true;
+}
+
+static int cmp_key(const void *a, const void *b) {
+    uint32_t pa = ((const TmRecKey *)a)->pid;
+    uint32_t pb = ((const TmRecKey *)b)->pid;
+    return (pa > pb) - (pa < pb);
+}
+
+static uint32_t hash_name(const char *s) {
+    uint32_t h = 2166136261u;                       /* FNV-1a */
+    while (*s) h = (h ^ (uint8_t)*s++) * 16777619u;
+    return h;
+}
+
+static const char *key_name(const TmAppState *s, const TmRecWriter *r, int k) {
+    return tm_process_at(s, r->keys[k].row)->name;
+}
+
+/* Assign each row its name's offset in the string blob; returns blob size */
+static uint32_t intern_names(TmRecWriter *r, const TmAppState *s, int n, int *strings) {
+    memset(r->slots, 0xFF, (size_t)(r->slot_mask + 1) * sizeof(int32_t));
+    uint32_t blob = 0;
+    *strings      = 0;
+    for (int k = 0; k < n; k++) {
+        const char *name = key_name(s, r, k);
+        uint32_t    h    = hash_name(name) & (uint32_t)r->slot_mask;
+        while (r->slots[h] >= 0 && strcmp(key_name(s, r, r->slots[h]), name) != 0)
+            h = (h + 1) & (uint32_t)r->slot_mask;
+        if (r->slots[h] < 0) {
+            r->slots[h]    = k;
+            r->name_off[k] = blob;
+            blob          += (uint32_t)strlen(name) + 1;
+            (*strings)++;
+        } else {
+            r->name_off[k] = r->name_off[r->slots[h]];
+        }
+    }
+    return blob;
+}
+
+tm_result_t tm_rec_writer_open(TmRecWriter *r, TmWriter *out, uint64_t epoch_ms) {
+    if (!r || !out) return TM_ERR_INVALID_ARG;
+    memset(r, 0, sizeof(*r));
+    r->out    = out;
+    r->origin = out_pos(out);
+
+    uint8_t hdr[FILE_HDR];
+    memcpy(hdr, "TMRC", 4);
+    put_u16(hdr + 4, TM_REC_VERSION);
+    put_u16(hdr + 6, FILE_HDR);
+    put_u64(hdr + 8, epoch_ms);
+    tm_writer_bytes(out, (const char *)hdr, sizeof(hdr));
+    return TM_OK;
+}
+
+tm_result_t tm_rec_write_frame(TmRecWriter *r, const TmAppState *s, uint64_t ts_ms) {
+    if (!r || !r->out || !s) return TM_ERR_INVALID_ARG;
+    const TmPerfData *d = &s->perf;
+    int n     = s->process_count;
+    int cores = (d->core_count < TM_MAX_CORES) ? d->core_count : TM_MAX_CORES;
+    if (cores < 0) cores = 0;
+
+    TM_CHECK(ensure_rows(r, n > 0 ? n : 1));
+    for (int i = 0; i < n; i++) {
+        r->keys[i].pid = tm_process_at(s, i)->pid;
+        r->keys[i].row = i;
+    }
+    qsort(r->keys, (size_t)n, sizeof(TmRecKey), cmp_key);
+
+    int      strings;
+    uint32_t blob = intern_names(r, s, n, &strings);
+
+    /* Worst case: 5-byte varints for u32 columns, 10 for memory */
+    size_t bound = FRAME_HDR + (size_t)cores * 5 + blob + (size_t)n * 25;
+    if (!frame_reserve(r, bound)) return TM_ERR_ALLOC;
+    uint8_t *f = r->frame;
+    uint8_t *p = f + FRAME_HDR;
+    uint32_t col[COLUMNS];
+
+    col[0] = (uint32_t)(p - f);
+    for (int c = 0; c < cores; c++) p = put_varint(p, centi(d->core_percent[c]));
+
+    col[1] = (uint32_t)(p - f);
+    uint32_t written = 0;       /* first uses appear in offset order */
+    for (int k = 0; k < n; k++) {
+        if (r->name_off[k] != written) continue;
+        const char *name = key_name(s, r, k);
+        size_t      len  = strlen(name) + 1;
+        memcpy(p, name, len);
+        p       += len;
+        written += (uint32_t)len;
+    }
+
+    col[2] = (uint32_t)(p - f);
+    uint32_t prev = 0;
+    for (int k = 0; k < n; k++) {
+        p    = put_varint(p, r->keys[k].pid - prev);
+        prev = r->keys[k].pid;
+    }
+    col[3] = (uint32_t)(p - f);
+    for (int k = 0; k < n; k++) p = put_varint(p, r->name_off[k]);
+    col[4] = (uint32_t)(p - f);
+    for (int k = 0; k < n; k++) p = put_varint(p, centi(tm_process_at(s, r->keys[k].row)->cpu_interval));
+    col[5] = (uint32_t)(p - f);
+    for (int k = 0; k < n; k++) p = put_varint(p, tm_process_at(s, r->keys[k].row)->memory_bytes / 1024);
+
+    uint32_t bytes = (uint32_t)(p - f);
+    memcpy(f, "TMFR", 4);
+    put_u32(f + 4,  bytes);
+    put_u64(f + 8,  ts_ms);
+    put_u32(f + 16, (uint32_t)n);
+    put_u32(f + 20, (uint32_t)strings);
+    put_u32(f + 24, centi(d->cpu_percent));
+    put_u32(f + 28, (uint32_t)cores);
+    put_u64(f + 32, d->mem_used_kb);
+    put_u64(f + 40, d->mem_total_kb);
+    for (int i = 0; i < COLUMNS; i++) put_u32(f + 48 + 4 * i, col[i]);
+
+    if (!index_append(r, ts_ms, out_pos(r->out) - r->origin)) return TM_ERR_ALLOC;
+    tm_writer_bytes(r->out, (const char *)f, bytes);
+    return TM_OK;
+}
+
+void tm_rec_writer_close(TmRecWriter *r) {
+    if (!r || !r->out) return;
+    uint64_t index_off = out_pos(r->out) - r->origin;
+    tm_writer_bytes(r->out, (const char *)r->index, (size_t)r->frame_count * INDEX_ENTRY);
+
+    uint8_t trailer[TRAILER];
+    memcpy(trailer, "TMIX", 4);
+    put_u32(trailer + 4, r->frame_count);
+    put_u64(trailer + 8, index_off);
+    tm_writer_bytes(r->out, (const char *)trailer, sizeof(trailer));
+
+    free(r->frame);
+    free(r->index);
+    free(r->keys);
+    free(r->name_off);
+    free(r->slots);
+    memset(r, 0, sizeof(*r));
+}
+
+/* -------------------------------------------------------------------------
+ * Reader
+ * ---------------------------------------------------------------------- */
+
+static bool read_footer(TmRecReader *r) {
+    if (r->size < FILE_HDR + TRAILER) return false;
+    const uint8_t *t = r->base + r->size - TRAILER;
+    if (memcmp(t, "TMIX", 4) != 0) return false;
+
+    uint32_t count = get_u32(t + 4);
+    uint64_t off   = get_u64(t + 8);
+    uint64_t end   = r->size - TRAILER;
+    if (off < FILE_HDR || off > end || (end - off) != (uint64_t)count * INDEX_ENTRY)
+        return false;
+    r->index       = r->base + off;
+    r->frame_count = count;
+    return true;
+}
+
+/* Recorder died before writing the footer: walk the frames once */
+static tm_result_t rebuild_index(TmRecReader *r, size_t first) {
+    uint32_t cap = 0;
+    size_t   off = first;
+    while (off + FRAME_HDR <= r->size && memcmp(r->base + off, "TMFR", 4) == 0) {
+        uint32_t bytes = get_u32(r->base + off + 4);
+        if (bytes < FRAME_HDR || bytes > r->size - off) break;
+        if (r->frame_count == cap) {
+            cap = cap ? cap * 2 : 1024;
+            uint8_t *p = (uint8_t *)realloc(r->owned_index, (size_t)cap * INDEX_ENTRY);
+            if (!p) return TM_ERR_ALLOC;
+            r->owned_index = p;
+        }
+        uint8_t *e = r->owned_index + (size_t)r->frame_count * INDEX_ENTRY;
+        put_u64(e, get_u64(r->base + off + 8));
+        put_u64(e + 8, off);
+        r->frame_count++;
+        off += bytes;
+    }
+    r->index = r->owned_index;
+    tm_log_warn("Recording has no index footer; rebuilt from %u frames", r->frame_count);
+    return TM_OK;
+}
+
+tm_result_t tm_rec_open(TmRecReader *r, const char *path) {
+    if (!r || !path) return TM_ERR_INVALID_ARG;
+    memset(r, 0, sizeof(*r));
+    r->base = (const uint8_t *)g_platform->map_file(path, &r->size);
+    if (!r->base) {
+        tm_log_error("Cannot map recording %s", path);
+        return TM_ERR_IO;
+    }
+    if (r->size < FILE_HDR || memcmp(r->base, "TMRC", 4) != 0
+        || get_u16(r->base + 4) != TM_REC_VERSION) {
+        tm_log_error("%s is not a version %d recording", path, TM_REC_VERSION);
+        tm_rec_close(r);
+        return TM_ERR_IO;
+    }
+    r->created_ms = get_u64(r->base + 8);
+
+    if (!read_footer(r)) {
+        tm_result_t rc = rebuild_index(r, get_u16(r->base + 6));
+        if (rc != TM_OK) {
+            tm_rec_close(r);
+            return rc;
+        }
+    }
+    return TM_OK;
+}
+
+void tm_rec_close(TmRecReader *r) {
+    if (!r) return;
+    if (r->base) g_platform->unmap_file(r->base, r->size);
+    free(r->owned_index);
+    memset(r, 0, sizeof(*r));
+}
+
+uint64_t tm_rec_frame_ts(const TmRecReader *r, uint32_t i) {
+    if (!r || i >= r->frame_count) return 0;
+    return get_u64(r->index + (size_t)i * INDEX_ENTRY);
+}
+
+uint32_t tm_rec_seek(const TmRecReader *r, uint64_t ts_ms) {
+    if (!r) return 0;
+    uint32_t lo = 0, hi = r->frame_count;     /* first frame after ts_ms */
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (tm_rec_frame_ts(r, mid) <= ts_ms) lo = mid + 1;
+        else                                  hi = mid;
+    }
+    return lo ? lo - 1 : 0;
+}
+
+tm_result_t tm_rec_frame(const TmRecReader *r, uint32_t i, TmRecFrame *out) {
+    if (!r || !out || i >= r->frame_count) return TM_ERR_INVALID_ARG;
+    uint64_t off = get_u64(r->index + (size_t)i * INDEX_ENTRY + 8);
+    if (off > r->size || r->size - off < FRAME_HDR) return TM_ERR_IO;
+
+    const uint8_t *f     = r->base + off;
+    uint32_t       bytes = get_u32(f + 4);
+    if (memcmp(f, "TMFR", 4) != 0 || bytes < FRAME_HDR || bytes > r->size - off)
+        return TM_ERR_IO;
+
+    uint32_t col[COLUMNS];
+    for (int c = 0; c < COLUMNS; c++) {
+        col[c] = get_u32(f + 48 + 4 * c);
+        if (col[c] > bytes || col[c] < (c ? col[c - 1] : FRAME_HDR)) return TM_ERR_IO;
+    }
+    /* The blob must end in a NUL so no name can run past it */
+    if (col[2] > col[1] && f[col[2] - 1] != '\0') return TM_ERR_IO;
+
+    memset(out, 0, sizeof(*out));
+    out->ts_ms        = get_u64(f + 8);
+    out->row_count    = (int)get_u32(f + 16);
+    out->string_count = (int)get_u32(f + 20);
+    out->cpu_total    = (float)get_u32(f + 24) / 100.0f;
+    out->core_count   = (int)get_u32(f + 28);
+    out->mem_used_kb  = get_u64(f + 32);
+    out->mem_total_kb = get_u64(f + 40);
+    out->cores        = f + col[0];
+    out->strings      = f + col[1];
+    out->strings_len  = col[2] - col[1];
+    out->col_pid      = f + col[2];
+    out->col_name     = f + col[3];
+    out->col_cpu      = f + col[4];
+    out->col_mem      = f + col[5];
+    out->end          = f + bytes;
+    return TM_OK;
+}
+
+bool tm_rec_next_row(TmRecFrame *f, TmRecRow *out) {
+    if (!f || !out || f->next_row >= f->row_count) return false;
+    uint64_t dpid, name, cpu, mem;
+    if (!get_varint(&f->col_pid,  f->end, &dpid) || !get_varint(&f->col_name, f->end, &name)
+        || !get_varint(&f->col_cpu, f->end, &cpu) || !get_varint(&f->col_mem, f->end, &mem)
+        || name >= f->strings_len)
+        return false;
+
+    f->last_pid     += (uint32_t)dpid;
+    out->pid         = f->last_pid;
+    out->name        = (const char *)f->strings + name;
+    out->cpu_percent = (float)cpu / 100.0f;
+    out->mem_kb      = mem;
+    f->next_row++;
+    return true;
+}
+
+int tm_rec_cores(const TmRecFrame *f, float *out, int max) {
+    if (!f || !out) return 0;
+    const uint8_t *p = f->cores;
+    int            n = 0;
+    uint64_t       v;
+    while (n < f->core_count && n < max && get_varint(&p, f->strings, &v))
+        out[n++] = (float)v / 100.0f;
+    return n;
+}
@@ -0,0 +1,324 @@
+/**
+ * @file tm_shm.c
+ * @brief Shared-memory snapshot publisher and reader -- business logic, no Raylib.
+ *
+ * Segment layout (native endianness; the segment never leaves the host):
+ *
+ *   TmShmHeader   128 bytes: magic "TMSH", version, caps, column offsets,
+ *                 the seqlock counter and the snapshot scalars
+ *   cores         float[core_cap]            per-core CPU %
+ *   pid           uint32[row_cap]            }
+ *   cpu           float[row_cap]             } one row per process,
+ *   mem_kb        uint64[row_cap]            } in process-table order
+ *   name          char[row_cap][name_len]    }
+ *
+ * Columns start on 64-byte boundaries. Sizes and offsets are fixed when
+ * the segment is created, so readers resolve their pointers once.
+ *
+ * Seqlock: the publisher builds the snapshot in a private stage, makes seq
+ * odd, copies the used part of each column in, then makes it even again
+ * (release), so the window readers must retry across is a few memcpy()s.
+ * A reader loads seq (acquire), reads, and accepts the data only if seq
+ * was even and unchanged afterwards. Readers never write to the segment,
+ * so there is no limit on their number. seq is a plain uint64_t touched
+ * only through the platform atomics, so the layout stays valid C and C++
+ * for every compiler.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_shm.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+/* 128 bytes, shared by every process that maps the segment */
+struct TmShmHeader {
+    char     magic[4];          /* "TMSH" */
+    uint32_t version;           /* TM_SHM_VERSION */
+    uint64_t size;              /* segment bytes */
+    uint32_t row_cap;           /* rows each column holds */
+    uint32_t core_cap;
+    uint32_t name_len;          /* bytes per name cell, NUL-padded */
+    uint32_t reserved;
+    uint64_t off_cores;         /* column offsets from the segment base */
+    uint64_t off_pid;
+    uint64_t off_cpu;
+    uint64_t off_mem;
+    uint64_t off_name;
+    uint64_t seq;               /* seqlock: odd while a snapshot is written */
+
+    /* Snapshot scalars, guarded by seq like the columns */
+    uint64_t ts_ms;             /* Unix epoch ms */
+    uint64_t mem_used_kb;
+    uint64_t mem_total_kb;
+    uint64_t mem_avail_kb;
+    float    cpu_total;
+    uint32_t core_count;
+    uint32_t row_count;
+    uint32_t process_count;     /* > row_count when the table was cut */
+};
+
+static size_t align64(size_t n) {
+    return (n + 63) & ~(size_t)63;
+}
+
+/* -------------------------------------------------------------------------
+ * Publisher
+ * ---------------------------------------------------------------------- */
+
+bool tm_shm_parse_args(int argc, char **argv, const char **name, int *rows) {
+    *name = NULL;
+    *rows = TM_SHM_DEFAULT_ROWS;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--shm") == 0) *name = argv[i + 1];
+        if (strcmp(argv[i], "--shm-rows") == 0) {
+            *rows = atoi(argv[i + 1]);
+            if (*rows < 1) return false;
+        }
+    }
+    return true;
+}
+
+tm_result_t tm_shm_writer_open(TmShmWriter *w, const char *name, int rows) {
+    if (!w || !name || rows < 1 || strlen(name) >= sizeof(w->name))
+        return TM_ERR_INVALID_ARG;
+
+    TmShmHeader h = {0};
+    memcpy(h.magic, "TMSH", 4);
+    h.version   = TM_SHM_VERSION;
+    h.row_cap   = (uint32_t)rows;
+    h.core_cap  = TM_MAX_CORES;
+    h.name_len  = TM_SHM_NAME_LEN;
+    h.off_cores = align64(sizeof(TmShmHeader));
+    h.off_pid   = align64(h.off_cores + (size_t)h.core_cap * sizeof(float));
+    h.off_cpu   = align64(h.off_pid + (size_t)rows * sizeof(uint32_t));
+    h.off_mem   = align64(h.off_cpu + (size_t)rows * sizeof(float));
+    h.off_name  = align64(h.off_mem + (size_t)rows * sizeof(uint64_t));
+    h.size      = align64(h.off_name + (size_t)rows * h.name_len);
+
+    /* Zeroed, so name cells stay NUL-terminated after strncpy() */
+    w->stage = (uint8_t *)calloc(1, (size_t)h.size);
+    if (!w->stage) return TM_ERR_ALLOC;
+    void *base = g_platform->shm_create(name, (size_t)h.size);
+    if (!base) {
+        free(w->stage);
+        w->stage = NULL;
+        return TM_ERR_PLATFORM;
+    }
+
+    /* The seqlock counter starts at 0: "nothing published yet" */
+    w->hdr  = (TmShmHeader *)base;
+    w->size = (size_t)h.size;
+    memcpy(w->hdr, &h, sizeof(h));
+    memcpy(w->stage, &h, sizeof(h));
+    strcpy(w->name, name);
+    tm_log_info("Publishing snapshots to shared memory %s (%zu KiB, %d rows)",
+                name, w->size / 1024, rows);
+    return TM_OK;
+}
+
+/* Gather @p s into the stage: the list walk stays outside the seqlock */
+static void stage_snapshot(TmShmWriter *w, const TmAppState *s, uint64_t ts_ms) {
+    TmShmHeader      *h = (TmShmHeader *)w->stage;
+    const TmPerfData *d = &s->perf;
+    int cores = (d->core_count < (int)h->core_cap) ? d->core_count : (int)h->core_cap;
+    h->ts_ms         = ts_ms;
+    h->mem_used_kb   = d->mem_used_kb;
+    h->mem_total_kb  = d->mem_total_kb;
+    h->mem_avail_kb  = d->mem_available_kb;
+    h->cpu_total     = d->cpu_percent;
+    h->core_count    = (uint32_t)cores;
+    h->process_count = (uint32_t)s->process_count;
+    memcpy(w->stage + h->off_cores, d->core_percent, (size_t)cores * sizeof(float));
+
+    uint32_t *pid  = (uint32_t *)(w->stage + h->off_pid);
+    float    *cpu  = (float *)(w->stage + h->off_cpu);
+    uint64_t *mem  = (uint64_t *)(w->stage + h->off_mem);
+    char     *name = (char *)(w->stage + h->off_name);
+    uint32_t  n    = 0;
+    for (const TmProcess *p = s->process_list; p && n < h->row_cap; p = p->next, n++) {
+        pid[n] = p->pid;
+        cpu[n] = p->cpu_interval;
+        mem[n] = p->memory_bytes / 1024;
+        strncpy(name + (size_t)n * h->name_len, p->name, h->name_len - 1);
+    }
+    h->row_count = n;
+}
+
+void tm_shm_publish(TmShmWriter *w, const TmAppState *s, uint64_t ts_ms) {
+    if (!w || !w->hdr || !s) return;
+    stage_snapshot(w, s, ts_ms);
+
+    /* Readers retry while seq is odd: copy only the used part of each column */
+    TmShmHeader       *h    = w->hdr;
+    const TmShmHeader *src  = (const TmShmHeader *)w->stage;
+    uint8_t           *base = (uint8_t *)h;
+    size_t             rows = src->row_count;
+    uint64_t           seq  = g_platform->atomic_load_u64(&h->seq);
+    g_platform->atomic_store_u64(&h->seq, seq + 1);
+    g_platform->memory_fence();             /* odd before any column write */
+
+    h->ts_ms         = src->ts_ms;
+    h->mem_used_kb   = src->mem_used_kb;
+    h->mem_total_kb  = src->mem_total_kb;
+    h->mem_avail_kb  = src->mem_avail_kb;
+    h->cpu_total     = src->cpu_total;
+    h->core_count    = src->core_count;
+    h->row_count     = src->row_count;
+    h->process_count = src->process_count;
+    memcpy(base + h->off_cores, w->stage + h->off_cores, src->core_count * sizeof(float));
+    memcpy(base + h->off_pid, w->stage + h->off_pid, rows * sizeof(uint32_t));
+    memcpy(base + h->off_cpu, w->stage + h->off_cpu, rows * sizeof(float));
+    memcpy(base + h->off_mem, w->stage + h->off_mem, rows * sizeof(uint64_t));
+    memcpy(base + h->off_name, w->stage + h->off_name, rows * h->name_len);
+
+    g_platform->atomic_store_u64(&h->seq, seq + 2);
+}
+
+void tm_shm_writer_close(TmShmWriter *w) {
+    if (!w || !w->hdr) return;
+    g_platform->unmap_file(w->hdr, w->size);
+    g_platform->shm_unlink(w->name);
+    free(w->stage);
+    w->hdr   = NULL;
+    w->stage = NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * Reader
+ * ---------------------------------------------------------------------- */
+
+/* Column @p off spanning @p bytes lies inside the mapping */
+static bool column_fits(const TmShmReader *r, uint64_t off, uint64_t bytes) {
+    return off % 8 == 0 && off <= r->size && bytes <= r->size - off;
+}
+
+tm_result_t tm_shm_reader_open(TmShmReader *r, const char *name) {
+    if (!r || !name) return TM_ERR_INVALID_ARG;
+    memset(r, 0, sizeof(*r));
+
+    size_t      size = 0;
+    const void *base = g_platform->shm_map(name, &size);
+    if (!base) return TM_ERR_IO;
+    r->hdr  = (const TmShmHeader *)base;
+    r->size = size;
+
+    const TmShmHeader *h = r->hdr;
+    bool ok = size >= sizeof(TmShmHeader) && memcmp(h->magic, "TMSH", 4) == 0
+              && h->version == TM_SHM_VERSION && h->size <= size && h->name_len > 0
+              && column_fits(r, h->off_cores, (uint64_t)h->core_cap * sizeof(float))
+              && column_fits(r, h->off_pid, (uint64_t)h->row_cap * sizeof(uint32_t))
+              && column_fits(r, h->off_cpu, (uint64_t)h->row_cap * sizeof(float))
+              && column_fits(r, h->off_mem, (uint64_t)h->row_cap * sizeof(uint64_t))
+              && column_fits(r, h->off_name, (uint64_t)h->row_cap * h->name_len);
+    if (!ok) {
+        tm_log_error("%s is not a snapshot segment (version %d)", name, TM_SHM_VERSION);
+        tm_shm_reader_close(r);
+        return TM_ERR_IO;
+    }
+
+    const uint8_t *b = (const uint8_t *)base;
+    r->cores  = (const float *)(b + h->off_cores);
+    r->pid    = (const uint32_t *)(b + h->off_pid);
+    r->cpu    = (const float *)(b + h->off_cpu);
+    r->mem_kb = (const uint64_t *)(b + h->off_mem);
+    r->names  = (const char *)(b + h->off_name);
+    return TM_OK;
+}
+
+void tm_shm_reader_close(TmShmReader *r) {
+    if (!r || !r->hdr) return;
+    g_platform->unmap_file(r->hdr, r->size);
+    memset(r, 0, sizeof(*r));
+}
+
+uint64_t tm_shm_read_begin(const TmShmReader *r) {
+    return g_platform->atomic_load_u64(&r->hdr->seq);
+}
+
+bool tm_shm_read_retry(const TmShmReader *r, uint64_t seq) {
+    g_platform->memory_fence();             /* every read done before seq is checked */
+    return (seq & 1) || g_platform->atomic_load_u64(&r->hdr->seq) != seq;
+}
+
+void tm_shm_read_scalars(const TmShmReader *r, TmShmSnapshot *out) {
+    const TmShmHeader *h = r->hdr;
+    /* Counts may be torn too: clamp before they size any copy */
+    uint32_t rows  = h->row_count;
+    uint32_t cores = h->core_count;
+    out->ts_ms         = h->ts_ms;
+    out->mem_used_kb   = h->mem_used_kb;
+    out->mem_total_kb  = h->mem_total_kb;
+    out->mem_avail_kb  = h->mem_avail_kb;
+    out->cpu_total     = h->cpu_total;
+    out->process_count = (int)h->process_count;
+    out->row_count     = (int)(rows < h->row_cap ? rows : h->row_cap);
+    out->core_count    = (int)(cores < h->core_cap ? cores : h->core_cap);
+    out->name_len      = (int)h->name_len;
+}
+
+tm_result_t tm_shm_snapshot_alloc(const TmShmReader *r, TmShmSnapshot *out) {
+    if (!r || !r->hdr || !out) return TM_ERR_INVALID_ARG;
+    const TmShmHeader *h = r->hdr;
+    memset(out, 0, sizeof(*out));
+    out->name_len = (int)h->name_len;
+    out->cores    = (float *)malloc((size_t)h->core_cap * sizeof(float));
+    out->pid      = (uint32_t *)malloc((size_t)h->row_cap * sizeof(uint32_t));
+    out->cpu      = (float *)malloc((size_t)h->row_cap * sizeof(float));
+    out->mem_kb   = (uint64_t *)malloc((size_t)h->row_cap * sizeof(uint64_t));
+    out->names    = (char *)malloc((size_t)h->row_cap * h->name_len);
+    if (!out->cores || !out->pid || !out->cpu || !out->mem_kb || !out->names) {
+        tm_shm_snapshot_free(out);
+        return TM_ERR_ALLOC;
+    }
+    return TM_OK;
+}
+
+void tm_shm_snapshot_free(TmShmSnapshot *snap) {
+    if (!snap) return;
+    free(snap->cores);
+    free(snap->pid);
+    free(snap->cpu);
+    free(snap->mem_kb);
+    free(snap->names);
+    memset(snap, 0, sizeof(*snap));
+}
+
+tm_result_t tm_shm_read(const TmShmReader *r, TmShmSnapshot *out) {
+    if (!r || !r->hdr || !out || !out->pid) return TM_ERR_INVALID_ARG;
+    const TmShmHeader *h = r->hdr;
+
+    long spins = 0;
+    for (int attempt = 0; attempt < TM_SHM_READ_RETRIES; attempt++) {
+        uint64_t seq = tm_shm_read_begin(r);
+        if (seq == 0) return TM_ERR_BUSY;           /* nothing published yet */
+
+        /* A publish is open: wait it out without spending a copy, but give
+         * up eventually in case the publisher died inside it */
+        while ((seq & 1) && ++spins < TM_SHM_SPIN_LIMIT) seq = tm_shm_read_begin(r);
+        if (seq & 1) return TM_ERR_BUSY;
+
+        tm_shm_read_scalars(r, out);
+        size_t rows  = (size_t)out->row_count;
+        size_t cores = (size_t)out->core_count;
+        memcpy(out->cores, r->cores, cores * sizeof(float));
+        memcpy(out->pid, r->pid, rows * sizeof(uint32_t));
+        memcpy(out->cpu, r->cpu, rows * sizeof(float));
+        memcpy(out->mem_kb, r->mem_kb, rows * sizeof(uint64_t));
+        memcpy(out->names, r->names, rows * h->name_len);
+
+        if (!tm_shm_read_retry(r, seq)) {
+            out->seq = seq;
+            return TM_OK;
+        }
+    }
+    out->row_count  = 0;
+    out->core_count = 0;
+    return TM_ERR_BUSY;
+}
+
+const char *tm_shm_snapshot_name(const TmShmSnapshot *snap, int i) {
+    if (!snap || i < 0 || i >= snap->row_count) return "";
+    return snap->names + (size_t)i * (size_t)snap->name_len;
+}
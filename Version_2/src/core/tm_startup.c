@@ -39,7 +39,20 @@ void tm_startup_list_free(TmAppState *s) {
         free(cur);
         cur = nxt;
     }
-    s->startup_list = NULL;
+    free(s->startup_index);
+    s->startup_list  = NULL;
+    s->startup_index = NULL;
+    s->startup_count = 0;
+}
+
+/* Positional index over the list so rows are reachable in O(1). */
+static tm_result_t build_startup_index(TmAppState *s, int count) {
+    s->startup_index = (TmStartupApp **)malloc((size_t)count * sizeof(TmStartupApp *));
+    if (!s->startup_index) return TM_ERR_ALLOC;
+    int i = 0;
+    for (TmStartupApp *a = s->startup_list; a; a = a->next) s->startup_index[i++] = a;
+    s->startup_count = count;
+    return TM_OK;
 }
 
 tm_result_t tm_startup_list_load(TmAppState *s) {
@@ -50,7 +63,10 @@ tm_result_t tm_startup_list_load(TmAppState *s) {
     int count = (int)(sizeof(k_app_names) / sizeof(k_app_names[0]));
     for (int i = 0; i < count; i++) {
         TmStartupApp *app = (TmStartupApp *)malloc(sizeof(TmStartupApp));
-        if (!app) return TM_ERR_ALLOC;
+        if (!app) {
+            tm_startup_list_free(s);
+            return TM_ERR_ALLOC;
+        }
 
         strncpy(app->name,      k_app_names[i], TM_NAME_MAX - 1);
         strncpy(app->publisher, k_publishers[i], TM_PUBLISHER_MAX - 1);
@@ -66,6 +82,10 @@ tm_result_t tm_startup_list_load(TmAppState *s) {
         app->next          = s->startup_list;
         s->startup_list    = app;
     }
+    if (build_startup_index(s, count) != TM_OK) {
+        tm_startup_list_free(s);
+        return TM_ERR_ALLOC;
+    }
 
     tm_log_info("Startup list loaded: %d entries", count);
     return TM_OK;
@@ -76,14 +96,8 @@ tm_result_t tm_startup_list_load(TmAppState *s) {
  * ---------------------------------------------------------------------- */
 
 TmStartupApp *tm_startup_get(const TmAppState *s, int index) {
-    if (!s || index < 0) return NULL;
-    TmStartupApp *cur = s->startup_list;
-    int           i   = 0;
-    while (cur && i < index) {
-        cur = cur->next;
-        i++;
-    }
-    return cur;
+    if (!s || index < 0 || index >= s->startup_count) return NULL;
+    return s->startup_index[index];
 }
 
 tm_result_t tm_startup_toggle(TmAppState *s, int index) {
@@ -0,0 +1,244 @@
+/**
+ * @file tm_warm.c
+ * @brief Warm-start snapshot file -- business logic, no Raylib.
+ *
+ * Layout: TmWarmHeader, one TmPerfData image, app_count TmWarmApp
+ * records, then proc_count TmWarmProc records in list order. Records are
+ * raw structs of the writing build; the header carries their sizes and a
+ * file whose sizes do not match is ignored rather than converted. Only
+ * values and rings are kept -- monotonic timestamps and cached details
+ * mean nothing in another run.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../include/tm_warm.h"
+#include "../../include/tm_process.h"
+#include "../../include/tm_app_history.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+#define PATH_CAP 512
+
+/** App-history entry as saved. */
+typedef struct {
+    char     name[TM_NAME_MAX];
+    float    cpu_time;
+    float    cpu_time_history[TM_HIST_SHORT];
+    uint64_t memory_kb;
+    uint64_t memory_history[TM_HIST_SHORT];
+    uint64_t network_kb;
+    uint64_t network_history[TM_HIST_SHORT];
+    int32_t  history_idx;
+    uint32_t sample_seq;
+} TmWarmApp;
+
+/** Process row as saved. */
+typedef struct {
+    char             name[TM_NAME_MAX];
+    uint32_t         pid;
+    float            cpu_percent;
+    uint64_t         memory_bytes;
+    TmProcessHistory history;
+} TmWarmProc;
+
+static const char k_magic[8] = "TMWARM";
+
+/* -------------------------------------------------------------------------
+ * Load
+ * ---------------------------------------------------------------------- */
+
+static bool header_ok(const TmWarmHeader *h, size_t size) {
+    if (memcmp(h->magic, k_magic, sizeof(k_magic)) != 0 || h->version != TM_WARM_VERSION
+        || h->perf_bytes != sizeof(TmPerfData) || h->app_bytes != sizeof(TmWarmApp)
+        || h->proc_bytes != sizeof(TmWarmProc))
+        return false;
+    uint64_t need = sizeof(*h) + (uint64_t)h->perf_bytes
+                  + (uint64_t)h->app_count * h->app_bytes
+                  + (uint64_t)h->proc_count * h->proc_bytes;
+    return need <= size;
+}
+
+static void restore_perf(TmPerfData *d, const uint8_t *at) {
+    TmPerfData saved;
+    memcpy(&saved, at, sizeof(saved));
+    if (saved.core_count != d->core_count) {
+        tm_log_info("Warm start: core count changed, system history not restored");
+        return;
+    }
+    saved.last_update = d->last_update;
+    saved.cpu_ticks   = d->cpu_ticks;
+    memcpy(saved.core_ticks, d->core_ticks, sizeof(saved.core_ticks));
+    *d = saved;
+}
+
+static void restore_apps(TmAppState *s, const uint8_t *at, uint32_t count) {
+    double now = g_platform->now_s();
+    for (uint32_t i = 0; i < count; i++) {
+        TmWarmApp w;
+        memcpy(&w, at + (size_t)i * sizeof(w), sizeof(w));
+        w.name[TM_NAME_MAX - 1] = '\0';
+        if (w.history_idx < 0 || w.history_idx >= TM_HIST_SHORT) continue;
+
+        for (TmAppHistory *a = s->history_list; a; a = a->next) {
+            if (strcmp(a->name, w.name) != 0) continue;
+            a->cpu_time    = w.cpu_time;
+            a->memory_kb   = w.memory_kb;
+            a->network_kb  = w.network_kb;
+            a->history_idx = w.history_idx;
+            a->sample_seq  = w.sample_seq;
+            a->last_update = now;
+            memcpy(a->cpu_time_history, w.cpu_time_history, sizeof(a->cpu_time_history));
+            memcpy(a->memory_history,   w.memory_history,   sizeof(a->memory_history));
+            memcpy(a->network_history,  w.network_history,  sizeof(a->network_history));
+            break;
+        }
+    }
+}
+
+/* Rebuild the saved rows as list nodes, in their saved order. */
+static tm_result_t restore_processes(TmAppState *s, const TmWarmHeader *h, const uint8_t *at) {
+    TmProcess  *head = NULL;
+    TmProcess **tail = &head;
+    for (uint32_t i = 0; i < h->proc_count; i++) {
+        TmWarmProc w;
+        memcpy(&w, at + (size_t)i * sizeof(w), sizeof(w));
+
+        TmProcess *p = (TmProcess *)calloc(1, sizeof(*p));
+        if (!p) {
+            tm_process_nodes_free(head);
+            return TM_ERR_ALLOC;
+        }
+        memcpy(p->name, w.name, sizeof(p->name));
+        p->name[TM_NAME_MAX - 1] = '\0';
+        p->pid          = w.pid;
+        p->cpu_percent  = w.cpu_percent;
+        p->memory_bytes = w.memory_bytes;
+        p->history      = w.history;
+        /* The newest ring slot is the interval value shown when saved */
+        p->cpu_interval = w.history.samples ? w.history.cpu[h->process_seq % TM_PROC_HIST_LEN]
+                                            : w.cpu_percent;
+        *tail = p;
+        tail  = &p->next;
+    }
+    return tm_process_list_restore(s, head, (int)h->proc_count, h->process_seq);
+}
+
+const char *tm_warm_file_arg(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--warm-file") == 0) return argv[i + 1];
+    }
+    return NULL;
+}
+
+tm_result_t tm_warm_load(TmAppState *s, const char *path) {
+    if (!s || !path) return TM_ERR_INVALID_ARG;
+
+    size_t         size = 0;
+    const uint8_t *base = (const uint8_t *)g_platform->map_file(path, &size);
+    if (!base) {
+        tm_log_info("No warm-start snapshot at %s", path);
+        return TM_ERR_IO;
+    }
+
+    TmWarmHeader h;
+    if (size < sizeof(h)) {
+        g_platform->unmap_file(base, size);
+        tm_log_warn("%s is not a warm-start snapshot", path);
+        return TM_ERR_IO;
+    }
+    memcpy(&h, base, sizeof(h));
+    if (!header_ok(&h, size)) {
+        g_platform->unmap_file(base, size);
+        tm_log_warn("%s is not a version %d warm-start snapshot from this build",
+                    path, TM_WARM_VERSION);
+        return TM_ERR_IO;
+    }
+
+    const uint8_t *at = base + sizeof(h);
+    restore_perf(&s->perf, at);
+    at += h.perf_bytes;
+    /* App history is loaded lazily; saved rings bring it in now */
+    if (h.app_count > 0 && !s->history_list && tm_history_init(s) != TM_OK)
+        tm_log_warn("Warm start: app history not restored");
+    restore_apps(s, at, h.app_count);
+    at += (size_t)h.app_count * h.app_bytes;
+    tm_result_t r = restore_processes(s, &h, at);
+    g_platform->unmap_file(base, size);
+    if (r != TM_OK) return r;
+
+    s->warm_ms = h.saved_ms ? h.saved_ms : 1;
+    tm_log_info("Warm start: %u processes from %s", h.proc_count, path);
+    return TM_OK;
+}
+
+/* -------------------------------------------------------------------------
+ * Save
+ * ---------------------------------------------------------------------- */
+
+static bool write_all(FILE *fp, const TmAppState *s) {
+    TmWarmHeader h = {0};
+    memcpy(h.magic, k_magic, sizeof(h.magic));
+    h.version     = TM_WARM_VERSION;
+    h.perf_bytes  = sizeof(TmPerfData);
+    h.app_bytes   = sizeof(TmWarmApp);
+    h.proc_bytes  = sizeof(TmWarmProc);
+    h.app_count   = (uint32_t)s->history_count;
+    h.proc_count  = (uint32_t)s->process_count;
+    h.process_seq = s->process_seq;
+    h.saved_ms    = (uint64_t)time(NULL) * 1000u;
+    if (fwrite(&h, sizeof(h), 1, fp) != 1) return false;
+    if (fwrite(&s->perf, sizeof(s->perf), 1, fp) != 1) return false;
+
+    for (const TmAppHistory *a = s->history_list; a; a = a->next) {
+        TmWarmApp w = {0};
+        memcpy(w.name, a->name, sizeof(w.name));
+        w.cpu_time    = a->cpu_time;
+        w.memory_kb   = a->memory_kb;
+        w.network_kb  = a->network_kb;
+        w.history_idx = a->history_idx;
+        w.sample_seq  = a->sample_seq;
+        memcpy(w.cpu_time_history, a->cpu_time_history, sizeof(w.cpu_time_history));
+        memcpy(w.memory_history,   a->memory_history,   sizeof(w.memory_history));
+        memcpy(w.network_history,  a->network_history,  sizeof(w.network_history));
+        if (fwrite(&w, sizeof(w), 1, fp) != 1) return false;
+    }
+    for (const TmProcess *p = s->process_list; p; p = p->next) {
+        TmWarmProc w = {0};
+        memcpy(w.name, p->name, sizeof(w.name));
+        w.pid          = p->pid;
+        w.cpu_percent  = p->cpu_percent;
+        w.memory_bytes = p->memory_bytes;
+        w.history      = p->history;
+        if (fwrite(&w, sizeof(w), 1, fp) != 1) return false;
+    }
+    return g_platform->sync_file(fp);
+}
+
+tm_result_t tm_warm_save(const TmAppState *s, const char *path) {
+    if (!s || !path) return TM_ERR_INVALID_ARG;
+    if (s->warm_ms || s->collector.is_priming) return TM_OK;   /* file is newer */
+
+    char tmp[PATH_CAP];
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) return TM_ERR_INVALID_ARG;
+    FILE *fp = fopen(tmp, "wb");
+    if (!fp) {
+        tm_log_warn("Cannot create warm-start snapshot %s", tmp);
+        return TM_ERR_IO;
+    }
+    bool ok = write_all(fp, s);
+    if (fclose(fp) != 0) ok = false;
+
+    /* rename() does not replace an existing file on every platform */
+    if (ok && rename(tmp, path) != 0)
+        ok = g_platform->remove_file(path) && rename(tmp, path) == 0;
+    if (!ok) {
+        g_platform->remove_file(tmp);
+        tm_log_warn("Cannot write warm-start snapshot %s", path);
+        return TM_ERR_IO;
+    }
+    tm_log_info("Saved warm-start snapshot: %d processes to %s", s->process_count, path);
+    return TM_OK;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file tm_watch.c
+ * @brief Pinned-process watch list -- business logic, no Raylib.
+ */
+
+#include <string.h>
+
+#include "../../include/tm_watch.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_event.h"
+#include "../../include/tm_log.h"
+
+/* -------------------------------------------------------------------------
+ * Helpers
+ * ---------------------------------------------------------------------- */
+
+/* Index of the entry following @p pid, or -1. Dead entries keep their old PID. */
+static int find_index(const TmWatchList *w, uint32_t pid, bool alive_only) {
+    for (int i = 0; i < w->count; i++) {
+        const TmWatchEntry *e = &w->entries[i];
+        if (e->pid == pid && (e->is_alive || !alive_only)) return i;
+    }
+    return -1;
+}
+
+/* Open a sampler for @p pid and take the reference sample. */
+static bool attach(TmWatchEntry *e, uint32_t pid) {
+    e->pid    = pid;
+    e->handle = g_platform->open_process_sampler(pid);
+    if (e->handle >= 0 && g_platform->read_process_sample(e->handle, &e->prev)) {
+        e->is_alive    = true;
+        e->last_sample = g_platform->now_s();
+        return true;
+    }
+    if (e->handle >= 0) g_platform->close_process_sampler(e->handle);
+    e->handle   = -1;
+    e->is_alive = false;
+    return false;
+}
+
+static void detach(TmWatchEntry *e) {
+    if (e->handle >= 0) g_platform->close_process_sampler(e->handle);
+    e->handle   = -1;
+    e->is_alive = false;
+}
+
+static void push_sample(TmWatchEntry *e, const TmProcSample *cur, double dt) {
+    double cpu_s = cur->cpu_time_s - e->prev.cpu_time_s;
+    double io_b  = (cur->io_bytes >= e->prev.io_bytes)
+                   ? (double)(cur->io_bytes - e->prev.io_bytes) : 0.0;
+
+    e->cpu[e->idx]     = (float)(cpu_s > 0.0 ? cpu_s / dt * 100.0 : 0.0);
+    e->rss_mb[e->idx]  = (float)((double)cur->rss_bytes / (1024.0 * 1024.0));
+    e->io_kbps[e->idx] = (float)(io_b / 1024.0 / dt);
+    e->idx = (e->idx + 1) % TM_WATCH_HIST_LEN;
+    if (e->count < TM_WATCH_HIST_LEN) e->count++;
+    e->prev = *cur;
+}
+
+/* -------------------------------------------------------------------------
+ * Pin management
+ * ---------------------------------------------------------------------- */
+
+tm_result_t tm_watch_pin(TmAppState *s, const TmProcess *proc) {
+    if (!s || !proc) return TM_ERR_INVALID_ARG;
+    TmWatchList *w = &s->watch;
+    if (w->count >= TM_MAX_WATCH || find_index(w, proc->pid, false) >= 0)
+        return TM_ERR_INVALID_ARG;
+
+    TmWatchEntry *e = &w->entries[w->count];
+    memset(e, 0, sizeof(*e));
+    memcpy(e->name, proc->name, sizeof(e->name));
+    e->name[TM_NAME_MAX - 1] = '\0';
+    e->interval_s = TM_WATCH_INTERVAL_S;
+
+    TmProcessDetail d = proc->detail;
+    if (!d.is_valid) g_platform->query_process_detail(proc->pid, &d);
+    memcpy(e->cmdline, d.cmdline, sizeof(e->cmdline));
+    e->cmdline[TM_CMD_MAX - 1] = '\0';
+
+    if (!attach(e, proc->pid)) {
+        tm_log_warn("Cannot sample pid %u; not pinned", proc->pid);
+        return TM_ERR_PLATFORM;
+    }
+    w->count++;
+    tm_log_info("Pinned '%s' (pid %u)", e->name, e->pid);
+    return TM_OK;
+}
+
+tm_result_t tm_watch_unpin(TmAppState *s, uint32_t pid) {
+    if (!s) return TM_ERR_INVALID_ARG;
+    TmWatchList *w = &s->watch;
+    int          i = find_index(w, pid, false);
+    if (i < 0) return TM_ERR_INVALID_ARG;
+
+    detach(&w->entries[i]);
+    memmove(&w->entries[i], &w->entries[i + 1],
+            (size_t)(w->count - i - 1) * sizeof(w->entries[0]));
+    w->count--;
+    return TM_OK;
+}
+
+bool tm_watch_is_pinned(const TmAppState *s, uint32_t pid) {
+    return s && find_index(&s->watch, pid, false) >= 0;
+}
+
+tm_result_t tm_watch_set_interval(TmAppState *s, uint32_t pid, float interval_s) {
+    if (!s) return TM_ERR_INVALID_ARG;
+    int i = find_index(&s->watch, pid, false);
+    if (i < 0) return TM_ERR_INVALID_ARG;
+    TmWatchEntry *e = &s->watch.entries[i];
+    e->interval_s = (interval_s < TM_WATCH_INTERVAL_S) ? TM_WATCH_INTERVAL_S : interval_s;
+    return TM_OK;
+}
+
+/* -------------------------------------------------------------------------
+ * Re-matching after a restart
+ * ---------------------------------------------------------------------- */
+
+bool tm_watch_needs_rescan(const TmAppState *s) {
+    for (int i = 0; s && i < s->watch.count; i++) {
+        if (!s->watch.entries[i].is_alive) return true;
+    }
+    return false;
+}
+
+/* Same executable name and, when known, the same command line. */
+static bool matches(const TmWatchEntry *e, const TmProcess *p) {
+    if (strcmp(e->name, p->name) != 0) return false;
+    if (e->cmdline[0] == '\0') return true;
+
+    TmProcessDetail d = p->detail;
+    if (!d.is_valid && !g_platform->query_process_detail(p->pid, &d)) return false;
+    return strcmp(e->cmdline, d.cmdline) == 0;
+}
+
+void tm_watch_rematch(TmAppState *s) {
+    if (!s) return;
+    for (int i = 0; i < s->watch.count; i++) {
+        TmWatchEntry *e = &s->watch.entries[i];
+        if (e->is_alive) continue;
+
+        for (const TmProcess *p = s->process_list; p; p = p->next) {
+            if (find_index(&s->watch, p->pid, true) >= 0 || !matches(e, p)) continue;
+            if (attach(e, p->pid)) {
+                tm_log_info("Watch '%s' re-attached to pid %u", e->name, e->pid);
+                break;
+            }
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Sampling
+ * ---------------------------------------------------------------------- */
+
+tm_result_t tm_watch_update(TmAppState *s) {
+    if (!s) return TM_ERR_INVALID_ARG;
+    double now     = g_platform->now_s();
+    bool   changed = false;
+
+    for (int i = 0; i < s->watch.count; i++) {
+        TmWatchEntry *e  = &s->watch.entries[i];
+        double        dt = now - e->last_sample;
+        if (!e->is_alive || dt < e->interval_s) continue;
+
+        TmProcSample cur;
+        if (!g_platform->read_process_sample(e->handle, &cur)) {
+            tm_log_info("Watched '%s' (pid %u) exited; waiting to re-match",
+                        e->name, e->pid);
+            detach(e);
+            changed = true;
+            continue;
+        }
+        push_sample(e, &cur, dt);
+        e->last_sample = now;
+        changed        = true;
+    }
+    if (changed) tm_event_publish(TM_EVENT_WATCH_SAMPLED);
+    return TM_OK;
+}
+
+void tm_watch_free(TmAppState *s) {
+    if (!s) return;
+    for (int i = 0; i < s->watch.count; i++) detach(&s->watch.entries[i]);
+    s->watch.count = 0;
+}
@@ -2,8 +2,9 @@
  * @file main.c
  * @brief Application entry point -- wires platform, inits subsystems, runs loop.
  *
- * This file contains ~30 lines of executable code.  All logic lives in
- * src/core/, src/ui/, src/platform/, and src/utils/.
+ * Besides the frame loop, main.c only owns startup and shutdown order and
+ * the hand-off of sampling passes to the live exporters. All logic lives
+ * in src/core/, src/ui/, src/platform/, and src/utils/.
  */
 
 #include <stdlib.h>
@@ -14,8 +15,18 @@
 #include "../include/tm_platform.h"
 #include "../include/tm_process.h"
 #include "../include/tm_perf.h"
+#include "../include/tm_collector.h"
+#include "../include/tm_burst.h"
+#include "../include/tm_watch.h"
+#include "../include/tm_event.h"
 #include "../include/tm_app_history.h"
 #include "../include/tm_startup.h"
+#include "../include/tm_headless.h"
+#include "../include/tm_metrics.h"
+#include "../include/tm_shm.h"
+#include "../include/tm_query.h"
+#include "../include/tm_histlog.h"
+#include "../include/tm_warm.h"
 #include "../include/tm_ui.h"
 #include "../include/tm_log.h"
 
@@ -23,36 +34,166 @@
 /* Platform pointer definition (declared extern in tm_platform.h) */
 const TmPlatform *g_platform = NULL;
 
-/* Observer: fired after each process list refresh */
-static void on_process_changed(const TmAppState *s, void *user) {
+static TmShmWriter s_shm;
+static const char *s_warm_path;
+static double      s_mono0;      /* now_s() when the exporters started */
+static uint64_t    s_epoch_ms;   /* wall clock at s_mono0 */
+
+/* Hand-off to the exporter worker. Rows are copied only when the table
+ * changed, into three reused views: the UI thread fills stage and swaps
+ * it with ready, the worker swaps ready with work. Perf is small and goes
+ * by value. Only the swaps and the perf copy take s_export_lock. */
+static TmProcessView  s_views[3];
+static TmProcessView *s_stage = &s_views[0];
+static TmProcessView *s_ready = &s_views[1];
+static TmProcessView *s_work  = &s_views[2];
+static bool           s_rows_fresh;
+static TmPerfData     s_export_perf;
+static uint64_t       s_export_ms;
+static TmAppState     s_export_state;   /* worker-owned; large: keep off the stack */
+static TmMutex       *s_export_lock;
+static int            s_export_sub;
+
+/* UI subscriber: at most once per frame, however many refreshes ran */
+static void on_process_changed(const TmEvent *ev, void *user) {
+    (void)user;
+    /* Scroll extents follow the row count */
+    ui_layout_invalidate((TmAppState *)ev->state, TM_LAYOUT_DIRTY_CONTENT);
+}
+
+/* UI subscriber: hand each sampling pass to the exporter worker */
+static void on_sampled(const TmEvent *ev, void *user) {
     (void)user;
-    /* Recompute scrollbar sizes after list changes */
-    ui_layout_update((TmAppState *)s);
+    tm_query_fetch_details();           /* adapter calls stay on this thread */
+    bool rows = (ev->types & TM_EVENT_PROCESSES_CHANGED) != 0;
+    if (rows && tm_process_view_copy(s_stage, ev->state) != TM_OK) {
+        tm_log_warn("Export copy allocation failed; keeping the previous rows");
+        rows = false;
+    }
+    /* Millisecond stamps from the monotonic clock, as in headless mode */
+    uint64_t ts_ms = s_epoch_ms + (uint64_t)((g_platform->now_s() - s_mono0) * 1000.0);
+
+    g_platform->mutex_lock(s_export_lock);
+    if (rows) {
+        TmProcessView *v = s_ready;
+        s_ready      = s_stage;
+        s_stage      = v;
+        s_rows_fresh = true;
+    }
+    s_export_perf = ev->state->perf;
+    s_export_ms   = ts_ms;
+    g_platform->mutex_unlock(s_export_lock);
+    tm_event_publish(TM_EVENT_EXPORT_READY);
+}
+
+/* Worker subscriber: format and publish the latest pass off the UI thread */
+static void on_export_ready(const TmEvent *ev, void *user) {
+    (void)ev;
+    (void)user;
+    TmAppState *s = &s_export_state;
+    g_platform->mutex_lock(s_export_lock);
+    if (s_rows_fresh) {
+        TmProcessView *v = s_work;
+        s_work       = s_ready;
+        s_ready      = v;
+        s_rows_fresh = false;
+    }
+    s->perf        = s_export_perf;
+    uint64_t ts_ms = s_export_ms;
+    g_platform->mutex_unlock(s_export_lock);
+
+    tm_process_view_attach(s_work, s);
+    tm_metrics_publish(s);
+    tm_shm_publish(&s_shm, s, ts_ms);
+    tm_query_publish(s);
+    tm_histlog_append(s, ts_ms);
+}
+
+/* Optional exporters (options checked in main()); while any runs its data
+ * sets stay fresh on every tab */
+static void exporters_init(TmAppState *s, int argc, char **argv) {
+    int         port       = tm_metrics_port_arg(argc, argv);
+    const char *query_path = tm_query_socket_arg(argc, argv);
+    const char *shm_name, *hist_dir;
+    int         shm_rows, hist_max_mb;
+    tm_shm_parse_args(argc, argv, &shm_name, &shm_rows);
+    tm_histlog_parse_args(argc, argv, &hist_dir, &hist_max_mb);
+
+    bool any = false;
+    if (port) {
+        if (tm_metrics_start(port) == TM_OK) any = true;
+        else tm_log_warn("Metrics endpoint disabled");
+    }
+    if (shm_name) {
+        if (tm_shm_writer_open(&s_shm, shm_name, shm_rows) == TM_OK) any = true;
+        else tm_log_warn("Shared-memory snapshot disabled");
+    }
+    if (query_path) {
+        if (tm_query_start(query_path) == TM_OK) any = true;
+        else tm_log_warn("Query socket disabled");
+    }
+    if (hist_dir) {
+        if (tm_histlog_open(hist_dir, hist_max_mb) == TM_OK) any = true;
+        else tm_log_warn("History log disabled");
+    }
+    if (!any) return;
+    s_export_lock = g_platform->mutex_create();
+    if (!s_export_lock || tm_event_subscribe(TM_EVENT_EXPORT_READY, TM_DISPATCH_THREAD,
+                                             on_export_ready, NULL, &s_export_sub) != TM_OK) {
+        tm_log_warn("Exporter worker failed to start; exporters idle");
+        return;
+    }
+    if (tm_process_view_copy(s_ready, s) == TM_OK) s_rows_fresh = true;  /* warm rows */
+    s_mono0    = g_platform->now_s();
+    s_epoch_ms = g_platform->epoch_ms();
+    tm_collector_pin(s, TM_DATA_EXPORTED);
+    tm_event_subscribe(TM_EVENT_SYSTEM_SAMPLED | TM_EVENT_PROCESSES_CHANGED,
+                       TM_DISPATCH_UI, on_sampled, NULL, NULL);
+}
+
+/* Join the exporter worker before the exporters it feeds are stopped */
+static void exporters_stop(void) {
+    if (s_export_sub) tm_event_unsubscribe(s_export_sub);
+    tm_metrics_stop();
+    tm_shm_writer_close(&s_shm);
+    tm_query_stop();
+    tm_histlog_close();
+    for (int i = 0; i < 3; i++) tm_process_view_free(&s_views[i]);
+    if (s_export_lock) g_platform->mutex_destroy(s_export_lock);
+    s_export_sub  = 0;
+    s_export_lock = NULL;
 }
 
 static void app_init(TmAppState *s) {
+    if (tm_event_init() != TM_OK)
+        tm_log_warn("Event bus init failed");
     tm_perf_data_init(&s->perf);
+    tm_collector_init(&s->collector);
+    tm_burst_init(&s->burst);
     s->screen_w = 1200;
     s->screen_h = 800;
 
+    /* Startup and App History data load with their tabs (k_tabs hooks) */
     ui_init(s);
 
-    if (tm_startup_list_load(s) != TM_OK)
-        tm_log_warn("Startup list load failed");
-
-    if (tm_history_init(s) != TM_OK)
-        tm_log_warn("History init failed");
+    /* Rows from the last run, shown stale until the first gather lands */
+    if (s_warm_path) tm_warm_load(s, s_warm_path);
+    ui_layout_invalidate(s, TM_LAYOUT_DIRTY_CONTENT);
 
-    tm_process_observer_add(on_process_changed, NULL);
+    tm_event_subscribe(TM_EVENT_PROCESSES_CHANGED, TM_DISPATCH_UI,
+                       on_process_changed, NULL, NULL);
 
-    if (tm_process_list_refresh(s) != TM_OK)
+    if (tm_collector_prime(s) != TM_OK)
         tm_log_warn("Initial process list refresh failed");
 }
 
 static void app_update(TmAppState *s) {
     ui_window_resize_handle(s);
+    /* Collect before input: sets queued by a tab switch are gathered on
+     * the next frame, so the switch itself renders cached data at once. */
+    tm_collector_update(s);
+    tm_event_dispatch(s);
     ui_input_update(s);
-    tm_perf_update(s);
     ui_toast_tick(s);
 }
 
@@ -72,20 +213,53 @@ static void app_draw(TmAppState *s) {
 }
 
 static void app_cleanup(TmAppState *s) {
+    if (s_warm_path) tm_warm_save(s, s_warm_path);
+    tm_collector_shutdown(s);
+    exporters_stop();
+    ui_graph_cache_free();
+    ui_heatmap_free();
+    tm_event_shutdown();
+    tm_watch_free(s);
     tm_process_list_free(s);
     tm_startup_list_free(s);
     tm_history_list_free(s);
 }
 
-int main(void) {
+int main(int argc, char **argv) {
     srand((unsigned int)time(NULL));
+    bool headless = tm_headless_requested(argc, argv);
+    if (headless) tm_log_use_stderr();     /* stdout carries records */
 
-    /* Select platform adapter -- the only #ifdef in the project */
+    /* Select platform adapter -- the only #ifdef outside platform/ (and its
+     * twin in main_headless.c) */
 #ifdef _WIN32
     g_platform = &k_platform_win32;
 #else
     g_platform = &k_platform_posix;
 #endif
+    g_platform = tm_platform_from_args(g_platform, argc, argv);
+    if (!g_platform) return 2;
+    double launched_at = g_platform->now_s();
+
+    if (headless) return tm_headless_run(argc, argv);
+    if (tm_histquery_requested(argc, argv)) return tm_histquery_run(argc, argv);
+
+    int         metrics_port = tm_metrics_port_arg(argc, argv);
+    const char *shm_name, *hist_dir;
+    int         shm_rows, hist_max_mb;
+    if (metrics_port < 0) {
+        tm_log_error("--metrics-port takes a port number, 1-65535");
+        return 2;
+    }
+    if (!tm_shm_parse_args(argc, argv, &shm_name, &shm_rows)) {
+        tm_log_error("--shm-rows takes a positive row count");
+        return 2;
+    }
+    if (!tm_histlog_parse_args(argc, argv, &hist_dir, &hist_max_mb)) {
+        tm_log_error("--history-max-mb takes a positive size");
+        return 2;
+    }
+    s_warm_path = tm_warm_file_arg(argc, argv);
 
     InitWindow(1200, 800, "Advanced Task Manager");
     SetWindowState(FLAG_WINDOW_RESIZABLE);
@@ -93,11 +267,20 @@ int main(void) {
 
     TmAppState app = {0};
     app_init(&app);
+    app.frame.launched_at = launched_at;
+    exporters_init(&app, argc, argv);
 
     while (!WindowShouldClose()) {
         app_update(&app);
-        app_draw(&app);
+        if (ui_frame_should_draw(&app)) {
+            app_draw(&app);
+            ui_frame_drawn(&app);
+        } else {
+            ui_frame_idle(&app);
+            ui_tabs_idle(&app);
+        }
     }
+    ui_frame_report(&app);
 
     app_cleanup(&app);
     CloseWindow();
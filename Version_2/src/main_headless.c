@@ -0,0 +1,35 @@
+/**
+ * @file main_headless.c
+ * @brief Entry point of task_manager_headless -- collector only, no Raylib.
+ *
+ * Same loop as `task_manager --headless`, for hosts without a display or
+ * GL stack. See tm_headless.h for the options. `query` reads the history
+ * log, as `task_manager query` does.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "../include/tm_platform.h"
+#include "../include/tm_headless.h"
+#include "../include/tm_histlog.h"
+#include "../include/tm_log.h"
+
+/* Platform pointer definition (declared extern in tm_platform.h) */
+const TmPlatform *g_platform = NULL;
+
+int main(int argc, char **argv) {
+    srand((unsigned int)time(NULL));
+    tm_log_use_stderr();        /* stdout carries records */
+
+#ifdef _WIN32
+    g_platform = &k_platform_win32;
+#else
+    g_platform = &k_platform_posix;
+#endif
+    g_platform = tm_platform_from_args(g_platform, argc, argv);
+    if (!g_platform) return 2;
+
+    if (tm_histquery_requested(argc, argv)) return tm_histquery_run(argc, argv);
+    return tm_headless_run(argc, argv);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file platform_args.c
+ * @brief Chooses the platform adapter from the command line.
+ *
+ * Without adapter options the live host adapter is used unchanged.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+static const char *const k_adapter_options[] = {
+    "--replay", "--speed",
+    "--synthetic", "--seed", "--spawn-rate", "--exit-rate", "--names",
+    "--cpu-mean", "--mem-mean",
+};
+
+/* Value of option @p name, or NULL if absent */
+static const char *arg_value(int argc, char **argv, const char *name) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], name) == 0) return argv[i + 1];
+    }
+    return NULL;
+}
+
+/* Integer option @p name, or @p def if absent */
+static long arg_long(int argc, char **argv, const char *name, long def) {
+    const char *v = arg_value(argc, argv, name);
+    return v ? atol(v) : def;
+}
+
+static const TmPlatform *open_replay(const TmPlatform *host, const char *path,
+                                     int argc, char **argv) {
+    const char *speed_arg = arg_value(argc, argv, "--speed");
+    double      speed     = 1.0;
+    if (speed_arg) speed = (strcmp(speed_arg, "max") == 0) ? 0.0 : atof(speed_arg);
+    if (speed_arg && speed <= 0.0 && strcmp(speed_arg, "max") != 0) {
+        tm_log_error("--speed takes a positive multiple or 'max'");
+        return NULL;
+    }
+    const TmPlatform *replay = NULL;
+    if (tm_platform_replay_open(host, path, speed, &replay) != TM_OK) return NULL;
+    return replay;
+}
+
+static const TmPlatform *open_synthetic(const TmPlatform *host, long processes,
+                                        int argc, char **argv) {
+    const char   *cpu_arg = arg_value(argc, argv, "--cpu-mean");
+    long          churn   = processes / 100;
+    TmSynthConfig cfg;
+    cfg.seed        = (uint64_t)arg_long(argc, argv, "--seed", 1);
+    cfg.processes   = (int)processes;
+    cfg.spawn_rate  = (int)arg_long(argc, argv, "--spawn-rate", churn);
+    cfg.exit_rate   = (int)arg_long(argc, argv, "--exit-rate", churn);
+    cfg.names       = (int)arg_long(argc, argv, "--names", 1000);
+    cfg.cpu_mean    = cpu_arg ? (float)atof(cpu_arg) : 0.5f;
+    cfg.mem_mean_kb = (uint64_t)arg_long(argc, argv, "--mem-mean", 32) * 1024;
+
+    const TmPlatform *synth = NULL;
+    tm_result_t r = (processes > 0 && processes <= TM_SYNTH_MAX_PROCS)
+                        ? tm_platform_synthetic_open(host, &cfg, &synth) : TM_ERR_INVALID_ARG;
+    if (r == TM_ERR_INVALID_ARG)
+        tm_log_error("Bad synthetic model: 1..%d processes, 1..%d names, "
+                     "rates >= 0, CPU mean 0..100", TM_SYNTH_MAX_PROCS, TM_SYNTH_MAX_NAMES);
+    return (r == TM_OK) ? synth : NULL;
+}
+
+const TmPlatform *tm_platform_from_args(const TmPlatform *host, int argc, char **argv) {
+    const char *replay    = arg_value(argc, argv, "--replay");
+    const char *synthetic = arg_value(argc, argv, "--synthetic");
+    if (replay && synthetic) {
+        tm_log_error("--replay and --synthetic are exclusive");
+        return NULL;
+    }
+    if (replay)    return open_replay(host, replay, argc, argv);
+    if (synthetic) return open_synthetic(host, atol(synthetic), argc, argv);
+    return host;
+}
+
+bool tm_platform_is_adapter_option(const char *opt) {
+    for (size_t i = 0; i < sizeof(k_adapter_options) / sizeof(k_adapter_options[0]); i++) {
+        if (strcmp(opt, k_adapter_options[i]) == 0) return true;
+    }
+    return false;
+}
@@ -12,32 +12,112 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/un.h>
+#include <time.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
 
 #include "../../include/tm_platform.h"
 #include "../../include/tm_log.h"
 
+static double posix_now_s(void);
+
+/* -------------------------------------------------------------------------
+ * /proc/<pid>/stat
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    unsigned long long cpu_ticks;     /* utime + stime */
+    unsigned long long start_ticks;   /* since boot */
+    long long          rss_pages;
+} TmPidStat;
+
+/* Parse a /proc/<pid>/stat image held in @p buf (NUL-terminated). */
+static bool parse_pid_stat(const char *buf, TmPidStat *out) {
+    /* comm may contain spaces and parentheses; fields resume after the last ')' */
+    const char *p = strrchr(buf, ')');
+    if (!p) return false;
+    unsigned long long utime = 0, stime = 0;
+    int m = sscanf(p + 2,
+                   "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu "
+                   "%*d %*d %*d %*d %*d %*d %llu %*u %lld",
+                   &utime, &stime, &out->start_ticks, &out->rss_pages);
+    if (m != 4) return false;
+    out->cpu_ticks = utime + stime;
+    return true;
+}
+
+/* Read and parse /proc/@p pid/stat; false once the process has exited. */
+static bool read_pid_stat(unsigned int pid, TmPidStat *out) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    char    buf[1024];
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) return false;
+    buf[n] = '\0';
+    return parse_pid_stat(buf, out);
+}
+
 /* -------------------------------------------------------------------------
  * Process list
  * ---------------------------------------------------------------------- */
 
-static FILE *posix_open_process_list(void) {
-    return popen("ps -eo pid,comm --no-headers", "r");
+/* The list handle is the popen() stream itself */
+static TmProcessList *posix_open_process_list(void) {
+    return (TmProcessList *)popen("ps -eo pid,pcpu,rss,comm --no-headers", "r");
 }
 
-static bool posix_parse_process_line(FILE *fp, TmProcess *out) {
+static void posix_close_process_list(TmProcessList *list) {
+    if (list) pclose((FILE *)list);
+}
+
+static bool posix_parse_process_line(TmProcessList *list, TmProcess *out) {
+    FILE *fp = (FILE *)list;
     if (!fp || !out) return false;
-    unsigned int pid = 0;
-    char name[TM_NAME_MAX] = {0};
-    int n = fscanf(fp, "%u %255s", &pid, name);
-    if (n != 2) return false;
+    char line[TM_NAME_MAX + 64];
+    if (!fgets(line, sizeof(line), fp)) return false;
+
+    unsigned int       pid     = 0;
+    float              cpu     = 0.0f;
+    unsigned long long rss_kb  = 0;
+    int                name_at = 0;
+    if (sscanf(line, "%u %f %llu %n", &pid, &cpu, &rss_kb, &name_at) != 3)
+        return false;
+
+    /* comm is the last column and may contain spaces */
+    char *name = line + name_at;
+    name[strcspn(name, "\n")] = '\0';
     out->pid = (uint32_t)pid;
     strncpy(out->name, name, TM_NAME_MAX - 1);
     out->name[TM_NAME_MAX - 1] = '\0';
-    /* Simulated metrics -- replace with /proc parsing for real data */
-    out->memory_bytes = (uint64_t)(1000 + rand() % 10000) * 1024;
-    out->cpu_percent  = (float)(rand() % 1000) / 10.0f;
+    out->memory_bytes = (uint64_t)rss_kb * 1024;
+    out->cpu_percent  = cpu;   /* ps reports a lifetime average */
+
+    /* Cumulative counters let the core work out CPU per refresh interval */
+    TmPidStat st;
+    if (read_pid_stat(pid, &st)) {
+        out->cpu_time_s  = (double)st.cpu_ticks / (double)sysconf(_SC_CLK_TCK);
+        out->start_ticks = st.start_ticks ? (uint64_t)st.start_ticks : 1u;
+    } else {
+        out->cpu_time_s  = 0.0;
+        out->start_ticks = 0;
+    }
     out->is_selected  = false;
     out->next         = NULL;
     return true;
@@ -49,26 +129,849 @@ static tm_result_t posix_kill_process(uint32_t pid) {
     return TM_ERR_PLATFORM;
 }
 
-static float posix_sample_cpu(void) {
-    /* Demo: return a plausible random value.
-     * Real impl: parse /proc/stat deltas between calls. */
-    return 5.0f + (float)(rand() % 60);
+/* -------------------------------------------------------------------------
+ * System CPU: one /proc/stat reading (Linux) serves the aggregate and the
+ * per-core values, so the graph and the core grid agree. Baselines belong
+ * to the callers; only the shared reading lives here, under s_stat_lock.
+ * ---------------------------------------------------------------------- */
+
+#define CPU_STAT_REUSE_S 0.02       /* calls this close share one reading */
+
+typedef struct {
+    unsigned long long busy;
+    unsigned long long total;
+} TmJiffies;
+
+static pthread_mutex_t s_stat_lock = PTHREAD_MUTEX_INITIALIZER;
+static TmJiffies       s_stat_all;              /* latest reading */
+static TmJiffies       s_stat_core[TM_MAX_CORES];
+static int             s_stat_cores;
+static double          s_stat_at;
+
+/* "cpu[N] user nice system idle iowait irq softirq steal" */
+static TmJiffies parse_jiffies(const char *fields) {
+    unsigned long long v[8] = { 0 };
+    sscanf(fields, "%llu %llu %llu %llu %llu %llu %llu %llu",
+           &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]);
+    TmJiffies j = { 0, 0 };
+    for (int i = 0; i < 8; i++) j.total += v[i];
+    j.busy = j.total - v[3] - v[4];             /* minus idle, iowait */
+    return j;
+}
+
+/* Caller holds s_stat_lock */
+static void read_cpu_stat(void) {
+    double now = posix_now_s();
+    if (s_stat_at > 0.0 && now - s_stat_at < CPU_STAT_REUSE_S) return;
+
+    FILE *fp = fopen("/proc/stat", "r");
+    if (!fp) return;
+    char line[512];
+    int  n = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, "cpu", 3) != 0) {
+            if (n > 0) break;       /* per-core lines are contiguous */
+            continue;
+        }
+        if (line[3] == ' ') {
+            s_stat_all = parse_jiffies(line + 4);
+        } else if (n < TM_MAX_CORES) {
+            const char *f = strchr(line, ' ');
+            if (f) s_stat_core[n++] = parse_jiffies(f + 1);
+        }
+    }
+    fclose(fp);
+    s_stat_cores = n;
+    s_stat_at    = now;
 }
 
+/*
+ * Busy share of the jiffies since @p prev, which then moves up to @p now.
+ * A caller back within one shared reading gets its previous figure again;
+ * a first call gets the average since boot, and counters that went
+ * backwards only reset the baseline.
+ */
+static float busy_percent(TmJiffies now, TmCpuTicks *prev) {
+    if (prev->total > 0 && now.total == prev->total) return prev->percent;
+
+    TmCpuTicks base = (prev->total == 0) ? (TmCpuTicks){0} : *prev;
+    float      pct  = 0.0f;
+    if (now.total > base.total && now.busy >= base.busy)
+        pct = (float)(100.0 * (double)(now.busy - base.busy)
+                      / (double)(now.total - base.total));
+    prev->busy    = now.busy;
+    prev->total   = now.total;
+    prev->percent = pct;
+    return pct;
+}
+
+static float posix_sample_cpu(TmCpuTicks *prev) {
+    pthread_mutex_lock(&s_stat_lock);
+    read_cpu_stat();
+    TmJiffies all = s_stat_all;
+    pthread_mutex_unlock(&s_stat_lock);
+    return busy_percent(all, prev);
+}
+
+static int posix_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1)            return 1;
+    if (n > TM_MAX_CORES) return TM_MAX_CORES;
+    return (int)n;
+}
+
+static int posix_sample_cpu_cores(TmCpuTicks *prev, float *out, int max) {
+    TmJiffies cores[TM_MAX_CORES];
+    pthread_mutex_lock(&s_stat_lock);
+    read_cpu_stat();
+    int n = (s_stat_cores < max) ? s_stat_cores : max;
+    memcpy(cores, s_stat_core, (size_t)n * sizeof(cores[0]));
+    pthread_mutex_unlock(&s_stat_lock);
+    for (int i = 0; i < n; i++) out[i] = busy_percent(cores[i], &prev[i]);
+    return n;
+}
+
+/* "In use" is what /proc/meminfo does not count as available, as free(1) does */
 static void posix_query_memory(uint64_t *used_kb, uint64_t *total_kb) {
-    /* Demo values; replace with sysinfo() or /proc/meminfo parsing. */
-    *total_kb = (uint64_t)16 * 1024 * 1024;
-    *used_kb  = (uint64_t)(4000 + rand() % 4000) * 1024;
+    *used_kb  = 0;
+    *total_kb = 0;
+    FILE *fp = fopen("/proc/meminfo", "r");
+    if (!fp) return;
+
+    unsigned long long total = 0, avail = 0, free_kb = 0, buffers = 0, cached = 0;
+    bool               has_avail = false;
+    char               line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        if      (sscanf(line, "MemTotal: %llu", &total) == 1)   continue;
+        else if (sscanf(line, "MemAvailable: %llu", &avail) == 1) has_avail = true;
+        else if (sscanf(line, "MemFree: %llu", &free_kb) == 1)  continue;
+        else if (sscanf(line, "Buffers: %llu", &buffers) == 1)  continue;
+        else if (sscanf(line, "Cached: %llu", &cached) == 1)    continue;
+    }
+    fclose(fp);
+    if (!has_avail) avail = free_kb + buffers + cached;     /* kernels before 3.14 */
+    if (total == 0) return;
+    *total_kb = (uint64_t)total;
+    *used_kb  = (avail < total) ? (uint64_t)(total - avail) : 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Per-process detail (Linux /proc; other POSIX systems report unsupported)
+ * ---------------------------------------------------------------------- */
+
+/* Sum the values of every "<key> <value>" line in /proc/<pid>/<file>. */
+static bool read_proc_keyed(uint32_t pid, const char *file, const char *key,
+                            uint64_t *out) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/%s", pid, file);
+    FILE *fp = fopen(path, "r");
+    if (!fp) return false;
+
+    size_t             key_len = strlen(key);
+    char               line[256];
+    bool               found   = false;
+    unsigned long long sum     = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, key, key_len) != 0) continue;
+        sum  += strtoull(line + key_len, NULL, 10);
+        found = true;
+    }
+    fclose(fp);
+    *out = (uint64_t)sum;
+    return found;
+}
+
+static int count_open_fds(uint32_t pid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/fd", pid);
+    DIR *dir = opendir(path);
+    if (!dir) return -1;
+
+    int            n = 0;
+    struct dirent *e;
+    while ((e = readdir(dir)) != NULL) {
+        if (e->d_name[0] != '.') n++;
+    }
+    closedir(dir);
+    return n;
+}
+
+static void read_cmdline(uint32_t pid, char *out, size_t cap) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/cmdline", pid);
+    out[0] = '\0';
+    FILE *fp = fopen(path, "r");
+    if (!fp) return;
+
+    size_t n = fread(out, 1, cap - 1, fp);
+    fclose(fp);
+    /* Arguments are NUL-separated; join them with spaces */
+    for (size_t i = 0; i + 1 < n; i++) {
+        if (out[i] == '\0') out[i] = ' ';
+    }
+    out[n] = '\0';
+}
+
+static bool posix_query_process_detail(uint32_t pid, TmProcessDetail *out) {
+    if (!out) return false;
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%u", pid);
+    if (access(path, F_OK) != 0) return false;
+
+    /* Kernel threads have no smaps and /proc/<pid>/io needs ptrace access;
+     * unreadable fields stay zero rather than failing the whole row. */
+    uint64_t pss = 0, io_read = 0, io_write = 0;
+    read_proc_keyed(pid, "smaps_rollup", "Pss:", &pss);
+    read_proc_keyed(pid, "io", "rchar:", &io_read);
+    read_proc_keyed(pid, "io", "wchar:", &io_write);
+
+    out->pss_kb   = pss;
+    out->io_bytes = io_read + io_write;
+    out->fd_count = count_open_fds(pid);
+    read_cmdline(pid, out->cmdline, sizeof(out->cmdline));
+    out->is_valid = true;
+    return true;
+}
+
+static bool posix_query_process_rss(uint32_t pid, uint64_t *rss_bytes) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/statm", pid);
+    FILE *fp = fopen(path, "r");
+    if (!fp) return false;
+
+    unsigned long long size = 0, resident = 0;
+    int n = fscanf(fp, "%llu %llu", &size, &resident);
+    fclose(fp);
+    if (n != 2) return false;
+    *rss_bytes = (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE);
+    return true;
+}
+
+/* -------------------------------------------------------------------------
+ * Per-PID samplers: /proc/<pid>/stat and io stay open, re-read with pread().
+ * s_sampler_lock covers the table and each read, so a handle cannot be
+ * closed and its fds reused in the middle of one.
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    int  stat_fd;
+    int  io_fd;          /* -1 if not permitted */
+    bool in_use;
+} TmPosixSampler;
+
+static pthread_mutex_t s_sampler_lock = PTHREAD_MUTEX_INITIALIZER;
+static TmPosixSampler  s_samplers[TM_MAX_WATCH * 2];
+
+static int posix_open_process_sampler(uint32_t pid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+    int stat_fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (stat_fd < 0) return -1;
+    snprintf(path, sizeof(path), "/proc/%u/io", pid);
+    int io_fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    int cap  = (int)(sizeof(s_samplers) / sizeof(s_samplers[0]));
+    int slot = 0;
+    pthread_mutex_lock(&s_sampler_lock);
+    while (slot < cap && s_samplers[slot].in_use) slot++;
+    if (slot < cap) s_samplers[slot] = (TmPosixSampler){ stat_fd, io_fd, true };
+    pthread_mutex_unlock(&s_sampler_lock);
+    if (slot == cap) {
+        close(stat_fd);
+        if (io_fd >= 0) close(io_fd);
+        return -1;
+    }
+    return slot;
+}
+
+static uint64_t parse_io_bytes(int fd) {
+    char buf[512];
+    ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return 0;
+    buf[n] = '\0';
+
+    unsigned long long rchar = 0, wchar = 0;
+    const char *r = strstr(buf, "rchar:");
+    const char *w = strstr(buf, "wchar:");
+    if (r) rchar = strtoull(r + 6, NULL, 10);
+    if (w) wchar = strtoull(w + 6, NULL, 10);
+    return (uint64_t)(rchar + wchar);
+}
+
+static bool posix_read_process_sample(int handle, TmProcSample *out) {
+    int cap = (int)(sizeof(s_samplers) / sizeof(s_samplers[0]));
+    if (handle < 0 || handle >= cap || !out) return false;
+
+    pthread_mutex_lock(&s_sampler_lock);
+    TmPosixSampler sp = s_samplers[handle];
+    char    buf[1024];
+    ssize_t n  = sp.in_use ? pread(sp.stat_fd, buf, sizeof(buf) - 1, 0) : -1;
+    uint64_t io = (n > 0 && sp.io_fd >= 0) ? parse_io_bytes(sp.io_fd) : 0;
+    pthread_mutex_unlock(&s_sampler_lock);
+    if (n <= 0) return false;   /* ESRCH once the process has exited */
+    buf[n] = '\0';
+
+    TmPidStat st;
+    if (!parse_pid_stat(buf, &st)) return false;
+
+    double tick = (double)sysconf(_SC_CLK_TCK);
+    out->cpu_time_s = (double)st.cpu_ticks / tick;
+    out->rss_bytes  = (uint64_t)st.rss_pages * (uint64_t)sysconf(_SC_PAGESIZE);
+    out->io_bytes   = io;
+    return true;
+}
+
+static void posix_close_process_sampler(int handle) {
+    int cap = (int)(sizeof(s_samplers) / sizeof(s_samplers[0]));
+    if (handle < 0 || handle >= cap) return;
+    pthread_mutex_lock(&s_sampler_lock);
+    TmPosixSampler sp = s_samplers[handle];
+    s_samplers[handle].in_use = false;
+    pthread_mutex_unlock(&s_sampler_lock);
+    if (!sp.in_use) return;
+    close(sp.stat_fd);
+    if (sp.io_fd >= 0) close(sp.io_fd);
 }
 
+/* -------------------------------------------------------------------------
+ * File mapping
+ * ---------------------------------------------------------------------- */
+
+static const void *posix_map_file(const char *path, size_t *size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void       *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);                  /* the mapping keeps the file referenced */
+    if (base == MAP_FAILED) return NULL;
+    *size = (size_t)st.st_size;
+    return base;
+}
+
+static void posix_unmap_file(const void *base, size_t size) {
+    if (base) munmap((void *)base, size);
+}
+
+static bool posix_make_dir(const char *path) {
+    return mkdir(path, 0700) == 0 || errno == EEXIST;
+}
+
+static int posix_list_dir(const char *path, TmDirEntryFn fn, void *user) {
+    DIR *d = opendir(path);
+    if (!d) return -1;
+    int            count = 0;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        struct stat st;
+        if (fstatat(dirfd(d), e->d_name, &st, 0) != 0 || !S_ISREG(st.st_mode)) continue;
+        fn(e->d_name, (uint64_t)st.st_size, user);
+        count++;
+    }
+    closedir(d);
+    return count;
+}
+
+static bool posix_sync_file(FILE *fp) {
+    return fflush(fp) == 0 && fsync(fileno(fp)) == 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Shared memory
+ * ---------------------------------------------------------------------- */
+
+static void *posix_shm_create(const char *name, size_t size) {
+    /* Never shrink a segment left over from a previous run: readers still
+     * mapping it would take SIGBUS. Unlink it -- their mappings stay
+     * valid -- and start a fresh, zero-filled one under the same name. */
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        tm_log_error("shm_open(%s) failed: %s", name, strerror(errno));
+        return NULL;
+    }
+    void *base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0)
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return (base == MAP_FAILED) ? NULL : base;
+}
+
+static const void *posix_shm_map(const char *name, size_t *size) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void       *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+    *size = (size_t)st.st_size;
+    return base;
+}
+
+static void posix_shm_unlink(const char *name) {
+    shm_unlink(name);
+}
+
+/* -------------------------------------------------------------------------
+ * Sockets (handles are file descriptors)
+ * ---------------------------------------------------------------------- */
+
+/* Wait for @p fd to become readable; false on timeout or error */
+static bool wait_readable(int fd, double timeout_s) {
+    struct pollfd pfd = { .fd = fd, .events = POLLIN, .revents = 0 };
+    int ms = (timeout_s > 0.0) ? (int)(timeout_s * 1000.0) : 0;
+    int n;
+    do {
+        n = poll(&pfd, 1, ms);
+    } while (n < 0 && errno == EINTR);
+    return n > 0;
+}
+
+static int posix_tcp_listen(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        tm_log_error("Cannot listen on 127.0.0.1:%d: %s", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int posix_sock_accept(int listener, double timeout_s) {
+    if (!wait_readable(listener, timeout_s)) return -1;
+    return accept(listener, NULL, NULL);
+}
+
+static long posix_sock_recv(int sock, void *buf, size_t n, double timeout_s) {
+    if (!wait_readable(sock, timeout_s)) return -1;
+    ssize_t got;
+    do {
+        got = recv(sock, buf, n, 0);
+    } while (got < 0 && errno == EINTR);
+    return (long)got;
+}
+
+static bool wait_writable(int fd, double timeout_s) {
+    struct pollfd pfd = { .fd = fd, .events = POLLOUT, .revents = 0 };
+    int ms = (timeout_s > 0.0) ? (int)(timeout_s * 1000.0) : 0;
+    int n;
+    do {
+        n = poll(&pfd, 1, ms);
+    } while (n < 0 && errno == EINTR);
+    return n > 0;
+}
+
+static bool posix_sock_send(int sock, const void *buf, size_t n, double timeout_s) {
+    const char *p        = (const char *)buf;
+    double      deadline = posix_now_s() + timeout_s;
+    while (n > 0) {
+        if (!wait_writable(sock, deadline - posix_now_s())) return false;
+        ssize_t sent = send(sock, p, n, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        n -= (size_t)sent;
+    }
+    return true;
+}
+
+static void posix_sock_close(int sock) {
+    if (sock >= 0) close(sock);
+}
+
+static int posix_uds_listen(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        tm_log_error("Socket path too long: %s", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    /* Replace a stale socket from a previous run, never anything else */
+    struct stat st;
+    if (lstat(path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            tm_log_error("%s exists and is not a socket; not replacing it", path);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    /* Owner-only from the moment it exists: bind honours the umask */
+    mode_t old_mask = umask(0077);
+    int    bound    = bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+    umask(old_mask);
+    if (bound != 0 || listen(fd, 64) != 0 ||
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0) {
+        tm_log_error("Cannot listen on %s: %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static long posix_sock_send_some(int sock, const void *buf, size_t n) {
+    ssize_t sent;
+    do {
+        sent = send(sock, buf, n, MSG_NOSIGNAL | MSG_DONTWAIT);
+    } while (sent < 0 && errno == EINTR);
+    if (sent < 0) return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    return (long)sent;
+}
+
+static bool posix_remove_file(const char *path) {
+    return unlink(path) == 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Readiness poller: epoll + eventfd on Linux, poll() + a pipe elsewhere
+ * ---------------------------------------------------------------------- */
+
+#ifdef __linux__
+
+struct TmPoller {
+    int epfd;
+    int wakefd;                 /* eventfd, registered with a NULL cookie */
+};
+
+static TmPoller *posix_poller_create(void) {
+    TmPoller *p = calloc(1, sizeof(*p));
+    if (!p) return NULL;
+    p->epfd   = epoll_create1(EPOLL_CLOEXEC);
+    p->wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event ev = { .events = EPOLLIN, .data.ptr = NULL };
+    if (p->epfd < 0 || p->wakefd < 0 ||
+        epoll_ctl(p->epfd, EPOLL_CTL_ADD, p->wakefd, &ev) != 0) {
+        if (p->epfd >= 0)   close(p->epfd);
+        if (p->wakefd >= 0) close(p->wakefd);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+static void posix_poller_destroy(TmPoller *p) {
+    if (!p) return;
+    close(p->epfd);
+    close(p->wakefd);
+    free(p);
+}
+
+static bool posix_poller_watch(TmPoller *p, int sock, uint32_t events, void *user) {
+    struct epoll_event ev = { .events = 0, .data.ptr = user };
+    if (events & TM_POLL_IN)  ev.events |= EPOLLIN;
+    if (events & TM_POLL_OUT) ev.events |= EPOLLOUT;
+    if (epoll_ctl(p->epfd, EPOLL_CTL_MOD, sock, &ev) == 0) return true;
+    return errno == ENOENT && epoll_ctl(p->epfd, EPOLL_CTL_ADD, sock, &ev) == 0;
+}
+
+static void posix_poller_forget(TmPoller *p, int sock) {
+    epoll_ctl(p->epfd, EPOLL_CTL_DEL, sock, NULL);
+}
+
+static int posix_poller_wait(TmPoller *p, TmPollEvent *out, int max, double timeout_s) {
+    struct epoll_event evs[64];
+    if (max > 64) max = 64;
+    int n = epoll_wait(p->epfd, evs, max, (int)(timeout_s * 1000.0));
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        if (!evs[i].data.ptr) {             /* wake-up: drain the counter */
+            uint64_t v;
+            if (read(p->wakefd, &v, sizeof(v)) < 0) { /* already drained */ }
+            continue;
+        }
+        uint32_t e = 0;
+        if (evs[i].events & EPOLLIN)                e |= TM_POLL_IN;
+        if (evs[i].events & EPOLLOUT)               e |= TM_POLL_OUT;
+        if (evs[i].events & (EPOLLHUP | EPOLLERR))  e |= TM_POLL_HUP;
+        out[k].user   = evs[i].data.ptr;
+        out[k].events = e;
+        k++;
+    }
+    return k;
+}
+
+static void posix_poller_wake(TmPoller *p) {
+    uint64_t one = 1;
+    if (write(p->wakefd, &one, sizeof(one)) < 0) { /* counter saturated: already woken */ }
+}
+
+#else  /* !__linux__ */
+
+typedef struct {
+    int       fd;
+    uint32_t  events;
+    void     *user;
+} TmPollSlot;
+
+struct TmPoller {
+    TmPollSlot *slots;
+    int         count;
+    int         cap;
+    int         wake[2];        /* self-pipe: [0] polled, [1] written */
+};
+
+static TmPoller *posix_poller_create(void) {
+    TmPoller *p = calloc(1, sizeof(*p));
+    if (!p) return NULL;
+    if (pipe(p->wake) != 0) {
+        free(p);
+        return NULL;
+    }
+    fcntl(p->wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(p->wake[1], F_SETFL, O_NONBLOCK);
+    return p;
+}
+
+static void posix_poller_destroy(TmPoller *p) {
+    if (!p) return;
+    close(p->wake[0]);
+    close(p->wake[1]);
+    free(p->slots);
+    free(p);
+}
+
+static bool posix_poller_watch(TmPoller *p, int sock, uint32_t events, void *user) {
+    for (int i = 0; i < p->count; i++) {
+        if (p->slots[i].fd != sock) continue;
+        p->slots[i].events = events;
+        p->slots[i].user   = user;
+        return true;
+    }
+    if (p->count == p->cap) {
+        int         cap   = p->cap ? p->cap * 2 : 16;
+        TmPollSlot *slots = realloc(p->slots, (size_t)cap * sizeof(*slots));
+        if (!slots) return false;
+        p->slots = slots;
+        p->cap   = cap;
+    }
+    p->slots[p->count++] = (TmPollSlot){ sock, events, user };
+    return true;
+}
+
+static void posix_poller_forget(TmPoller *p, int sock) {
+    for (int i = 0; i < p->count; i++) {
+        if (p->slots[i].fd != sock) continue;
+        p->slots[i] = p->slots[--p->count];
+        return;
+    }
+}
+
+static int posix_poller_wait(TmPoller *p, TmPollEvent *out, int max, double timeout_s) {
+    struct pollfd *pfd = malloc((size_t)(p->count + 1) * sizeof(*pfd));
+    if (!pfd) return 0;
+    pfd[0] = (struct pollfd){ .fd = p->wake[0], .events = POLLIN, .revents = 0 };
+    for (int i = 0; i < p->count; i++) {
+        short ev = 0;
+        if (p->slots[i].events & TM_POLL_IN)  ev |= POLLIN;
+        if (p->slots[i].events & TM_POLL_OUT) ev |= POLLOUT;
+        pfd[i + 1] = (struct pollfd){ .fd = p->slots[i].fd, .events = ev, .revents = 0 };
+    }
+    int n = poll(pfd, (nfds_t)(p->count + 1), (int)(timeout_s * 1000.0));
+    int k = 0;
+    if (n > 0) {
+        char drain[64];
+        if (pfd[0].revents)
+            while (read(p->wake[0], drain, sizeof(drain)) > 0) { }
+        for (int i = 0; i < p->count && k < max; i++) {
+            short r = pfd[i + 1].revents;
+            if (!r) continue;
+            uint32_t e = 0;
+            if (r & POLLIN)                      e |= TM_POLL_IN;
+            if (r & POLLOUT)                     e |= TM_POLL_OUT;
+            if (r & (POLLHUP | POLLERR | POLLNVAL)) e |= TM_POLL_HUP;
+            out[k].user   = p->slots[i].user;
+            out[k].events = e;
+            k++;
+        }
+    }
+    free(pfd);
+    return k;
+}
+
+static void posix_poller_wake(TmPoller *p) {
+    if (write(p->wake[1], "", 1) < 0) { /* pipe full: already woken */ }
+}
+
+#endif /* __linux__ */
+
+/* -------------------------------------------------------------------------
+ * Clock
+ * ---------------------------------------------------------------------- */
+
+static double posix_now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint64_t posix_epoch_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+static void posix_sleep_s(double seconds) {
+    if (seconds <= 0.0) return;
+    struct timespec ts;
+    ts.tv_sec  = (time_t)seconds;
+    ts.tv_nsec = (long)((seconds - (double)ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);       /* a signal ends the wait early */
+}
+
+static bool posix_is_exhausted(void) {
+    return false;               /* live data never runs out */
+}
+
+/* -------------------------------------------------------------------------
+ * Threads
+ * ---------------------------------------------------------------------- */
+
+struct TmThread { pthread_t id; TmThreadFn fn; void *arg; };
+struct TmMutex  { pthread_mutex_t m; };
+struct TmCond   { pthread_cond_t c; };
+
+static void *posix_thread_main(void *arg) {
+    TmThread *t = arg;
+    t->fn(t->arg);
+    return NULL;
+}
+
+static TmThread *posix_thread_start(TmThreadFn fn, void *arg) {
+    TmThread *t = malloc(sizeof(*t));
+    if (!t) return NULL;
+    t->fn  = fn;
+    t->arg = arg;
+    if (pthread_create(&t->id, NULL, posix_thread_main, t) != 0) {
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+static void posix_thread_join(TmThread *t) {
+    if (!t) return;
+    pthread_join(t->id, NULL);
+    free(t);
+}
+
+static TmMutex *posix_mutex_create(void) {
+    TmMutex *m = malloc(sizeof(*m));
+    if (m && pthread_mutex_init(&m->m, NULL) != 0) { free(m); m = NULL; }
+    return m;
+}
+
+static void posix_mutex_destroy(TmMutex *m) {
+    if (!m) return;
+    pthread_mutex_destroy(&m->m);
+    free(m);
+}
+
+static void posix_mutex_lock(TmMutex *m)   { pthread_mutex_lock(&m->m); }
+static void posix_mutex_unlock(TmMutex *m) { pthread_mutex_unlock(&m->m); }
+
+static TmCond *posix_cond_create(void) {
+    TmCond *c = malloc(sizeof(*c));
+    if (c && pthread_cond_init(&c->c, NULL) != 0) { free(c); c = NULL; }
+    return c;
+}
+
+static void posix_cond_destroy(TmCond *c) {
+    if (!c) return;
+    pthread_cond_destroy(&c->c);
+    free(c);
+}
+
+static void posix_cond_wait(TmCond *c, TmMutex *m) { pthread_cond_wait(&c->c, &m->m); }
+static void posix_cond_broadcast(TmCond *c)        { pthread_cond_broadcast(&c->c); }
+
+/* -------------------------------------------------------------------------
+ * Atomics (GCC / Clang builtins; no _Atomic types in shared structs)
+ * ---------------------------------------------------------------------- */
+
+static uint64_t posix_atomic_load_u64(const uint64_t *p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void posix_atomic_store_u64(uint64_t *p, uint64_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static void posix_memory_fence(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
 /* -------------------------------------------------------------------------
  * Exported adapter
  * ---------------------------------------------------------------------- */
 
 const TmPlatform k_platform_posix = {
-    .open_process_list  = posix_open_process_list,
-    .parse_process_line = posix_parse_process_line,
-    .kill_process       = posix_kill_process,
-    .sample_cpu         = posix_sample_cpu,
-    .query_memory       = posix_query_memory,
+    .open_process_list     = posix_open_process_list,
+    .parse_process_line    = posix_parse_process_line,
+    .close_process_list    = posix_close_process_list,
+    .kill_process          = posix_kill_process,
+    .sample_cpu            = posix_sample_cpu,
+    .cpu_count             = posix_cpu_count,
+    .sample_cpu_cores      = posix_sample_cpu_cores,
+    .query_memory          = posix_query_memory,
+    .query_process_detail  = posix_query_process_detail,
+    .query_process_rss     = posix_query_process_rss,
+    .now_s                 = posix_now_s,
+    .epoch_ms              = posix_epoch_ms,
+    .sleep_s               = posix_sleep_s,
+    .open_process_sampler  = posix_open_process_sampler,
+    .read_process_sample   = posix_read_process_sample,
+    .close_process_sampler = posix_close_process_sampler,
+    .map_file              = posix_map_file,
+    .unmap_file            = posix_unmap_file,
+    .make_dir              = posix_make_dir,
+    .list_dir              = posix_list_dir,
+    .sync_file             = posix_sync_file,
+    .shm_create            = posix_shm_create,
+    .shm_map               = posix_shm_map,
+    .shm_unlink            = posix_shm_unlink,
+    .tcp_listen            = posix_tcp_listen,
+    .sock_accept           = posix_sock_accept,
+    .sock_recv             = posix_sock_recv,
+    .sock_send             = posix_sock_send,
+    .sock_close            = posix_sock_close,
+    .uds_listen            = posix_uds_listen,
+    .sock_send_some        = posix_sock_send_some,
+    .remove_file           = posix_remove_file,
+    .poller_create         = posix_poller_create,
+    .poller_destroy        = posix_poller_destroy,
+    .poller_watch          = posix_poller_watch,
+    .poller_forget         = posix_poller_forget,
+    .poller_wait           = posix_poller_wait,
+    .poller_wake           = posix_poller_wake,
+    .is_exhausted          = posix_is_exhausted,
+    .thread_start          = posix_thread_start,
+    .thread_join           = posix_thread_join,
+    .mutex_create          = posix_mutex_create,
+    .mutex_destroy         = posix_mutex_destroy,
+    .mutex_lock            = posix_mutex_lock,
+    .mutex_unlock          = posix_mutex_unlock,
+    .cond_create           = posix_cond_create,
+    .cond_destroy          = posix_cond_destroy,
+    .cond_wait             = posix_cond_wait,
+    .cond_broadcast        = posix_cond_broadcast,
+    .atomic_load_u64       = posix_atomic_load_u64,
+    .atomic_store_u64      = posix_atomic_store_u64,
+    .memory_fence          = posix_memory_fence,
 };
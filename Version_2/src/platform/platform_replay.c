@@ -0,0 +1,256 @@
+/**
+ * @file platform_replay.c
+ * @brief Replay adapter: serves a tmrec recording through the TmPlatform vtable.
+ *
+ * Process lists, system CPU / memory and per-core CPU come from the frame
+ * at the current virtual time; threads, locks, sockets and mapping are
+ * the host adapter's own entries, copied into the vtable at open. The virtual clock starts at the first frame and runs at
+ * speed x real time. At speed 0 ("as fast as possible") it runs at real
+ * time, but sleep_s() jumps it forward and only yields for at most
+ * TM_REPLAY_YIELD_S, so any loop paced by sleep_s() -- the headless
+ * collector, the idle GUI frame -- races through the recording without
+ * pinning a core. After the last frame the recording holds still and
+ * sleep_s() blocks for real at every speed.
+ *
+ * The clock state is shared by every thread that calls the adapter (the
+ * first process gather runs on a worker), so it sits under s_clock_lock.
+ * The recording itself is read-only; the one list cursor is held under
+ * s_list_lock from open_process_list() to close_process_list().
+ */
+
+#include <string.h>
+
+#include "../../include/tm_platform.h"
+#include "../../include/tm_record.h"
+#include "../../include/tm_log.h"
+
+/* The adapter's process-list handle: a cursor over one frame */
+struct TmProcessList {
+    TmRecFrame frame;
+};
+
+static const TmPlatform *s_host;
+static TmPlatform        s_vtable;     /* *s_host with the data sources replaced */
+static TmRecReader       s_rec;
+static TmProcessList     s_list;
+static double            s_speed;      /* 0 = as fast as possible */
+static double            s_origin;     /* host clock when replay started */
+static TmMutex          *s_clock_lock;
+static TmMutex          *s_list_lock;
+static double            s_skipped;    /* virtual seconds jumped by sleep_s(); under s_clock_lock */
+static bool              s_served_last; /* under s_clock_lock */
+
+/* -------------------------------------------------------------------------
+ * Virtual clock
+ * ---------------------------------------------------------------------- */
+
+static double replay_now_s(void) {
+    double rate = (s_speed > 0.0) ? s_speed : 1.0;
+    s_host->mutex_lock(s_clock_lock);
+    double skipped = s_skipped;
+    s_host->mutex_unlock(s_clock_lock);
+    return (s_host->now_s() - s_origin) * rate + skipped;
+}
+
+/* The recording's own time at the virtual clock */
+static uint64_t replay_epoch_ms(void) {
+    return tm_rec_frame_ts(&s_rec, 0) + (uint64_t)(replay_now_s() * 1000.0);
+}
+
+static bool replay_is_exhausted(void) {
+    s_host->mutex_lock(s_clock_lock);
+    bool done = s_served_last;
+    s_host->mutex_unlock(s_clock_lock);
+    return done;
+}
+
+static void replay_sleep_s(double seconds) {
+    if (seconds <= 0.0) return;
+    if (replay_is_exhausted()) {
+        s_host->sleep_s(seconds);           /* nothing left to hurry towards */
+    } else if (s_speed > 0.0) {
+        s_host->sleep_s(seconds / s_speed);
+    } else {
+        s_host->mutex_lock(s_clock_lock);
+        s_skipped += seconds;
+        s_host->mutex_unlock(s_clock_lock);
+        s_host->sleep_s(seconds < TM_REPLAY_YIELD_S ? seconds : TM_REPLAY_YIELD_S);
+    }
+}
+
+/* Frame under the virtual clock; the last one once the clock passes it */
+static uint32_t current_index(void) {
+    uint32_t i = tm_rec_seek(&s_rec, replay_epoch_ms());
+    if (i + 1 == s_rec.frame_count) {
+        s_host->mutex_lock(s_clock_lock);
+        bool first = !s_served_last;
+        s_served_last = true;
+        s_host->mutex_unlock(s_clock_lock);
+        if (first) tm_log_info("Replay reached the last frame");
+    }
+    return i;
+}
+
+static bool current_frame(TmRecFrame *f) {
+    return tm_rec_frame(&s_rec, current_index(), f) == TM_OK;
+}
+
+/* -------------------------------------------------------------------------
+ * Process list
+ * ---------------------------------------------------------------------- */
+
+static TmProcessList *replay_open_process_list(void) {
+    s_host->mutex_lock(s_list_lock);    /* released by replay_close_process_list() */
+    if (tm_rec_frame(&s_rec, current_index(), &s_list.frame) != TM_OK) {
+        s_host->mutex_unlock(s_list_lock);
+        return NULL;
+    }
+    return &s_list;
+}
+
+static bool replay_parse_process_line(TmProcessList *list, TmProcess *out) {
+    TmRecRow row;
+    if (!list || !out || !tm_rec_next_row(&list->frame, &row)) return false;
+    out->pid = row.pid;
+    strncpy(out->name, row.name, TM_NAME_MAX - 1);
+    out->name[TM_NAME_MAX - 1] = '\0';
+    out->memory_bytes = row.mem_kb * 1024;
+    out->cpu_percent  = row.cpu_percent;
+    out->is_selected  = false;
+    out->next         = NULL;
+    return true;
+}
+
+static void replay_close_process_list(TmProcessList *list) {
+    if (list) s_host->mutex_unlock(s_list_lock);
+}
+
+static tm_result_t replay_kill_process(uint32_t pid) {
+    tm_log_warn("Replay is read-only; not killing PID %u", pid);
+    return TM_ERR_PLATFORM;
+}
+
+/* -------------------------------------------------------------------------
+ * System metrics
+ * ---------------------------------------------------------------------- */
+
+static float replay_sample_cpu(TmCpuTicks *prev) {
+    (void)prev;                 /* recorded values are already per-interval */
+    TmRecFrame f;
+    return current_frame(&f) ? f.cpu_total : 0.0f;
+}
+
+static int replay_cpu_count(void) {
+    TmRecFrame f;
+    if (tm_rec_frame(&s_rec, 0, &f) != TM_OK || f.core_count < 1) return 1;
+    return (f.core_count < TM_MAX_CORES) ? f.core_count : TM_MAX_CORES;
+}
+
+static int replay_sample_cpu_cores(TmCpuTicks *prev, float *out, int max) {
+    (void)prev;
+    TmRecFrame f;
+    return current_frame(&f) ? tm_rec_cores(&f, out, max) : 0;
+}
+
+static void replay_query_memory(uint64_t *used_kb, uint64_t *total_kb) {
+    TmRecFrame f;
+    bool ok   = current_frame(&f);
+    *used_kb  = ok ? f.mem_used_kb : 0;
+    *total_kb = ok ? f.mem_total_kb : 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Per-process queries (only RSS is recorded)
+ * ---------------------------------------------------------------------- */
+
+static bool replay_query_process_detail(uint32_t pid, TmProcessDetail *out) {
+    (void)pid;
+    (void)out;
+    return false;
+}
+
+static bool replay_query_process_rss(uint32_t pid, uint64_t *rss_bytes) {
+    TmRecFrame f;
+    TmRecRow   row;
+    if (!current_frame(&f)) return false;
+    while (tm_rec_next_row(&f, &row)) {
+        if (row.pid == pid) {
+            *rss_bytes = row.mem_kb * 1024;
+            return true;
+        }
+        if (row.pid > pid) break;           /* rows are in pid order */
+    }
+    return false;
+}
+
+static int replay_open_process_sampler(uint32_t pid) {
+    (void)pid;
+    return -1;
+}
+
+static bool replay_read_process_sample(int handle, TmProcSample *out) {
+    (void)handle;
+    (void)out;
+    return false;
+}
+
+static void replay_close_process_sampler(int handle) {
+    (void)handle;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+tm_result_t tm_platform_replay_open(const TmPlatform *host, const char *path,
+                                    double speed, const TmPlatform **out) {
+    if (!host || !path || speed < 0.0 || !out) return TM_ERR_INVALID_ARG;
+
+    /* Map through the host: g_platform may already point at this adapter */
+    const TmPlatform *prev = g_platform;
+    g_platform = host;
+    tm_result_t r = tm_rec_open(&s_rec, path);
+    g_platform = prev;
+    if (r != TM_OK) return r;
+    if (s_rec.frame_count == 0) {
+        tm_log_error("Recording %s has no frames", path);
+        return TM_ERR_IO;
+    }
+
+    if (!s_clock_lock) s_clock_lock = host->mutex_create();
+    if (!s_list_lock)  s_list_lock  = host->mutex_create();
+    if (!s_clock_lock || !s_list_lock) return TM_ERR_PLATFORM;
+    s_host        = host;
+    s_vtable      = *host;
+    s_vtable.open_process_list     = replay_open_process_list;
+    s_vtable.parse_process_line    = replay_parse_process_line;
+    s_vtable.close_process_list    = replay_close_process_list;
+    s_vtable.kill_process          = replay_kill_process;
+    s_vtable.sample_cpu            = replay_sample_cpu;
+    s_vtable.cpu_count             = replay_cpu_count;
+    s_vtable.sample_cpu_cores      = replay_sample_cpu_cores;
+    s_vtable.query_memory          = replay_query_memory;
+    s_vtable.query_process_detail  = replay_query_process_detail;
+    s_vtable.query_process_rss     = replay_query_process_rss;
+    s_vtable.now_s                 = replay_now_s;
+    s_vtable.epoch_ms              = replay_epoch_ms;
+    s_vtable.sleep_s               = replay_sleep_s;
+    s_vtable.open_process_sampler  = replay_open_process_sampler;
+    s_vtable.read_process_sample   = replay_read_process_sample;
+    s_vtable.close_process_sampler = replay_close_process_sampler;
+    s_vtable.is_exhausted          = replay_is_exhausted;
+    s_speed       = speed;
+    s_origin      = host->now_s();
+    s_skipped     = 0.0;
+    s_served_last = false;
+    double span_s = (double)(tm_rec_frame_ts(&s_rec, s_rec.frame_count - 1)
+                             - tm_rec_frame_ts(&s_rec, 0)) / 1000.0;
+    if (speed > 0.0)
+        tm_log_info("Replaying %u frames (%.1f s) from %s at %.1fx",
+                    s_rec.frame_count, span_s, path, speed);
+    else
+        tm_log_info("Replaying %u frames (%.1f s) from %s at full speed",
+                    s_rec.frame_count, span_s, path);
+    *out = &s_vtable;
+    return TM_OK;
+}
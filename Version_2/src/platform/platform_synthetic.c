@@ -0,0 +1,382 @@
+/**
+ * @file platform_synthetic.c
+ * @brief Synthetic adapter: a seeded, generated process table for scale tests.
+ *
+ * Builds a population of up to TM_SYNTH_MAX_PROCS processes and evolves it
+ * one step per process-list refresh: exit_rate random processes end,
+ * spawn_rate new ones start with fresh PIDs, and every CPU figure is
+ * redrawn. Steps are counted in refreshes, not seconds, so a seed yields
+ * the same sequence of lists however long each refresh takes. System CPU
+ * and memory are aggregates of the population; the clock, threads, locks,
+ * sockets and mapping are the host adapter's own entries, copied into the
+ * vtable at open.
+ *
+ * The population is shared by every thread that calls the adapter (the
+ * first process gather runs on a worker), so each data call takes
+ * s_lock. An open process list holds it until close_process_list(): a
+ * kill from another thread must not compact the table under the cursor.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+typedef struct {
+    uint32_t pid;               /* 0 = marked for exit */
+    uint32_t name;              /* index into s_names */
+    float    cpu_mean;
+    float    cpu;               /* this refresh */
+    uint64_t mem_kb;
+} TmSynthProc;
+
+/* The adapter's process-list handle: a cursor over the population */
+struct TmProcessList {
+    int next;
+};
+
+static const TmPlatform *s_host;
+static TmPlatform        s_vtable;      /* *s_host with the data sources replaced */
+static TmMutex          *s_lock;        /* guards everything below */
+static TmSynthConfig     s_cfg;
+static TmSynthProc      *s_procs;       /* ascending pid order */
+static int               s_count;
+static int               s_cap;         /* entries allocated in s_procs */
+static char            (*s_names)[TM_SYNTH_NAME_LEN];
+static TmProcessList     s_list;
+static uint64_t          s_rng;
+static uint64_t          s_step;        /* refreshes served */
+static uint32_t          s_next_pid;
+static double            s_cpu_sum;
+static uint64_t          s_mem_sum_kb;
+
+/* -------------------------------------------------------------------------
+ * Random numbers
+ * ---------------------------------------------------------------------- */
+
+/* splitmix64 finaliser: a well-mixed hash of @p x */
+static uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x  = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/* Uniform in [0, 1) from the top 24 bits of @p h */
+static float unit(uint64_t h) {
+    return (float)(h >> 40) * (1.0f / 16777216.0f);
+}
+
+/* xorshift64* step of the population stream */
+static uint64_t next_rand(void) {
+    s_rng ^= s_rng >> 12;
+    s_rng ^= s_rng << 25;
+    s_rng ^= s_rng >> 27;
+    return s_rng * 0x2545F4914F6CDD1Dull;
+}
+
+/* -------------------------------------------------------------------------
+ * Population
+ * ---------------------------------------------------------------------- */
+
+static const char *const k_words[] = {
+    "systemd", "kworker", "bash",    "sshd",       "python3", "java",
+    "node",    "postgres", "nginx",  "chrome",     "containerd", "redis-server",
+    "dockerd", "php-fpm", "ruby",    "worker",
+};
+#define WORD_COUNT ((int)(sizeof(k_words) / sizeof(k_words[0])))
+
+static void build_names(void) {
+    for (int i = 0; i < s_cfg.names; i++) {
+        if (i < WORD_COUNT)
+            snprintf(s_names[i], TM_SYNTH_NAME_LEN, "%s", k_words[i]);
+        else
+            snprintf(s_names[i], TM_SYNTH_NAME_LEN, "%s-%d",
+                     k_words[i % WORD_COUNT], i / WORD_COUNT);
+    }
+}
+
+/*
+ * Heavy tails without libm: u^3 has mean 1/4, so 4 * mean * u^3 keeps the
+ * configured mean while most processes sit near zero and a few run hot.
+ * Low name indices are drawn most often, like real hosts full of workers.
+ */
+static void spawn(TmSynthProc *p) {
+    float u_cpu  = unit(next_rand());
+    float u_mem  = unit(next_rand());
+    float u_name = unit(next_rand());
+    p->pid      = s_next_pid++;
+    p->name     = (uint32_t)((float)s_cfg.names * u_name * u_name);
+    p->cpu_mean = 4.0f * s_cfg.cpu_mean * u_cpu * u_cpu * u_cpu;
+    p->cpu      = 0.0f;
+    p->mem_kb   = 64 + (uint64_t)(4.0f * (float)s_cfg.mem_mean_kb * u_mem * u_mem * u_mem);
+    s_mem_sum_kb += p->mem_kb;
+}
+
+/* Mark up to @p n random live processes for exit, keeping at least one. */
+static void mark_exits(int n) {
+    if (n > s_count - 1) n = s_count - 1;
+    for (int k = 0; k < n; k++) {
+        int i = (int)(next_rand() % (uint64_t)s_count);
+        while (s_procs[i].pid == 0) i = (i + 1) % s_count;
+        s_mem_sum_kb -= s_procs[i].mem_kb;
+        s_procs[i].pid = 0;
+    }
+}
+
+/* Drop marked entries in place; pid order is preserved. */
+static void compact(void) {
+    int out = 0;
+    for (int i = 0; i < s_count; i++) {
+        if (s_procs[i].pid != 0) s_procs[out++] = s_procs[i];
+    }
+    s_count = out;
+}
+
+static void redraw_cpu(void) {
+    s_cpu_sum = 0.0;
+    for (int i = 0; i < s_count; i++) {
+        float cpu = 2.0f * s_procs[i].cpu_mean * unit(next_rand());
+        s_procs[i].cpu = (cpu < 100.0f) ? cpu : 100.0f;
+        s_cpu_sum += s_procs[i].cpu;
+    }
+}
+
+/* Grow s_procs to hold @p need entries (at most TM_SYNTH_MAX_PROCS); false
+ * if that fails. Only a population that outgrows its start pays for more. */
+static bool reserve(int need) {
+    if (need > TM_SYNTH_MAX_PROCS) need = TM_SYNTH_MAX_PROCS;
+    if (need <= s_cap) return true;
+    int cap = (s_cap > need / 2) ? 2 * s_cap : need;
+    if (cap > TM_SYNTH_MAX_PROCS) cap = TM_SYNTH_MAX_PROCS;
+    TmSynthProc *procs = (TmSynthProc *)realloc(s_procs, (size_t)cap * sizeof(*procs));
+    if (!procs) return false;
+    s_procs = procs;
+    s_cap   = cap;
+    return true;
+}
+
+/* One refresh worth of churn. */
+static void step(void) {
+    mark_exits(s_cfg.exit_rate);
+    compact();
+    if (!reserve(s_count + s_cfg.spawn_rate))
+        tm_log_warn("Synthetic table cannot grow past %d processes", s_cap);
+    int room   = s_cap - s_count;
+    int spawns = (s_cfg.spawn_rate < room) ? s_cfg.spawn_rate : room;
+    for (int k = 0; k < spawns; k++) spawn(&s_procs[s_count++]);
+    redraw_cpu();
+    s_step++;
+}
+
+static TmSynthProc *find(uint32_t pid) {
+    int lo = 0, hi = s_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (s_procs[mid].pid < pid) lo = mid + 1;
+        else                        hi = mid;
+    }
+    return (lo < s_count && s_procs[lo].pid == pid) ? &s_procs[lo] : NULL;
+}
+
+/* -------------------------------------------------------------------------
+ * Process list
+ * ---------------------------------------------------------------------- */
+
+static TmProcessList *synth_open_process_list(void) {
+    s_host->mutex_lock(s_lock);         /* released by synth_close_process_list() */
+    if (s_list.next >= 0) step();       /* the first refresh shows generation 0 */
+    s_list.next = 0;
+    return &s_list;
+}
+
+static bool synth_parse_process_line(TmProcessList *list, TmProcess *out) {
+    if (!list || !out || list->next >= s_count) return false;
+    const TmSynthProc *p = &s_procs[list->next++];
+    memcpy(out->name, s_names[p->name], TM_SYNTH_NAME_LEN);
+    out->pid          = p->pid;
+    out->memory_bytes = p->mem_kb * 1024;
+    out->cpu_percent  = p->cpu;
+    out->is_selected  = false;
+    out->next         = NULL;
+    return true;
+}
+
+static void synth_close_process_list(TmProcessList *list) {
+    if (list) s_host->mutex_unlock(s_lock);
+}
+
+static tm_result_t synth_kill_process(uint32_t pid) {
+    s_host->mutex_lock(s_lock);
+    TmSynthProc *p = find(pid);
+    if (p) {
+        s_mem_sum_kb -= p->mem_kb;
+        s_cpu_sum    -= p->cpu;
+        p->pid = 0;
+        compact();
+    }
+    s_host->mutex_unlock(s_lock);
+    if (!p) return TM_ERR_PLATFORM;
+    tm_log_info("Synthetic process %u removed", pid);
+    return TM_OK;
+}
+
+/* -------------------------------------------------------------------------
+ * System metrics
+ * ---------------------------------------------------------------------- */
+
+static int synth_cpu_count(void) {
+    return s_host->cpu_count();
+}
+
+/* Caller holds s_lock */
+static float cpu_total(void) {
+    float total = (float)(s_cpu_sum / (double)synth_cpu_count());
+    return (total < 100.0f) ? total : 100.0f;
+}
+
+static float synth_sample_cpu(TmCpuTicks *prev) {
+    (void)prev;
+    s_host->mutex_lock(s_lock);
+    float total = cpu_total();
+    s_host->mutex_unlock(s_lock);
+    return total;
+}
+
+/* Cores scatter around the total; hashed per step so no draw is consumed */
+static int synth_sample_cpu_cores(TmCpuTicks *prev, float *out, int max) {
+    (void)prev;
+    int n = (synth_cpu_count() < max) ? synth_cpu_count() : max;
+    s_host->mutex_lock(s_lock);
+    float total = cpu_total();
+    for (int c = 0; c < n; c++) {
+        float v = total * (0.5f + unit(mix64(s_cfg.seed ^ (s_step << 16) ^ (uint64_t)c)));
+        out[c] = (v < 100.0f) ? v : 100.0f;
+    }
+    s_host->mutex_unlock(s_lock);
+    return n;
+}
+
+/* Installed memory: the population plus a quarter, in whole GiB */
+static void synth_query_memory(uint64_t *used_kb, uint64_t *total_kb) {
+    const uint64_t gib_kb = 1024 * 1024;
+    s_host->mutex_lock(s_lock);
+    uint64_t used = s_mem_sum_kb;
+    s_host->mutex_unlock(s_lock);
+    *used_kb  = used;
+    *total_kb = (used + used / 4 + gib_kb - 1) / gib_kb * gib_kb;
+}
+
+/* -------------------------------------------------------------------------
+ * Per-process queries
+ * ---------------------------------------------------------------------- */
+
+/* Costly columns derived from the pid, so they stay put between refreshes */
+static bool synth_query_process_detail(uint32_t pid, TmProcessDetail *out) {
+    s_host->mutex_lock(s_lock);
+    const TmSynthProc *p = find(pid);
+    if (p) {
+        uint64_t h = mix64(s_cfg.seed ^ pid);
+        out->pss_kb   = p->mem_kb * 3 / 4;
+        out->fd_count = 3 + (int)(h % 64);
+        out->io_bytes = (h >> 8) % (1024 * 1024) * (s_step + 1);
+        snprintf(out->cmdline, TM_CMD_MAX, "/usr/bin/%s --synthetic", s_names[p->name]);
+        out->is_valid = true;
+    }
+    s_host->mutex_unlock(s_lock);
+    return p != NULL;
+}
+
+static bool synth_query_process_rss(uint32_t pid, uint64_t *rss_bytes) {
+    s_host->mutex_lock(s_lock);
+    const TmSynthProc *p = find(pid);
+    if (p) *rss_bytes = p->mem_kb * 1024;
+    s_host->mutex_unlock(s_lock);
+    return p != NULL;
+}
+
+static int synth_open_process_sampler(uint32_t pid) {
+    (void)pid;
+    return -1;
+}
+
+static bool synth_read_process_sample(int handle, TmProcSample *out) {
+    (void)handle;
+    (void)out;
+    return false;
+}
+
+static void synth_close_process_sampler(int handle) {
+    (void)handle;
+}
+
+static bool synth_is_exhausted(void) {
+    return false;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+tm_result_t tm_platform_synthetic_open(const TmPlatform *host, const TmSynthConfig *cfg,
+                                       const TmPlatform **out) {
+    if (!host || !cfg || !out) return TM_ERR_INVALID_ARG;
+    if (cfg->processes < 1 || cfg->processes > TM_SYNTH_MAX_PROCS ||
+        cfg->spawn_rate < 0 || cfg->exit_rate < 0 ||
+        cfg->names < 1 || cfg->names > TM_SYNTH_MAX_NAMES ||
+        cfg->cpu_mean < 0.0f || cfg->cpu_mean > 100.0f)
+        return TM_ERR_INVALID_ARG;
+
+    if (!s_lock) s_lock = host->mutex_create();
+    if (!s_lock) return TM_ERR_PLATFORM;
+    /* Room for the start population and one refresh of spawns; a model
+     * that spawns more than it exits grows the table as it goes */
+    free(s_procs);
+    free(s_names);
+    s_procs = NULL;
+    s_cap   = 0;
+    s_names = malloc((size_t)cfg->names * sizeof(*s_names));
+    if (!s_names || !reserve(cfg->processes + cfg->spawn_rate)) {
+        free(s_procs);
+        free(s_names);
+        s_procs = NULL;
+        s_names = NULL;
+        s_cap   = 0;
+        return TM_ERR_ALLOC;
+    }
+
+    s_host       = host;
+    s_vtable     = *host;
+    s_vtable.open_process_list     = synth_open_process_list;
+    s_vtable.parse_process_line    = synth_parse_process_line;
+    s_vtable.close_process_list    = synth_close_process_list;
+    s_vtable.kill_process          = synth_kill_process;
+    s_vtable.sample_cpu            = synth_sample_cpu;
+    s_vtable.cpu_count             = synth_cpu_count;
+    s_vtable.sample_cpu_cores      = synth_sample_cpu_cores;
+    s_vtable.query_memory          = synth_query_memory;
+    s_vtable.query_process_detail  = synth_query_process_detail;
+    s_vtable.query_process_rss     = synth_query_process_rss;
+    s_vtable.open_process_sampler  = synth_open_process_sampler;
+    s_vtable.read_process_sample   = synth_read_process_sample;
+    s_vtable.close_process_sampler = synth_close_process_sampler;
+    s_vtable.is_exhausted          = synth_is_exhausted;
+    s_cfg        = *cfg;
+    s_rng        = mix64(cfg->seed) | 1;    /* xorshift state must be non-zero */
+    s_step       = 0;
+    s_next_pid   = 1;
+    s_count      = 0;
+    s_mem_sum_kb = 0;
+    s_list.next  = -1;
+    build_names();
+    while (s_count < cfg->processes) spawn(&s_procs[s_count++]);
+    redraw_cpu();
+
+    tm_log_info("Synthetic: %d processes, %d names, seed %llu, +%d / -%d per refresh",
+                cfg->processes, cfg->names, (unsigned long long)cfg->seed,
+                cfg->spawn_rate, cfg->exit_rate);
+    *out = &s_vtable;
+    return TM_OK;
+}
@@ -8,9 +8,12 @@
 
 #ifdef _WIN32
 
+#include <io.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <winsock2.h>           /* before windows.h */
+#include <windows.h>
 
 #include "../../include/tm_platform.h"
 #include "../../include/tm_log.h"
@@ -19,11 +22,17 @@
  * Process list
  * ---------------------------------------------------------------------- */
 
-static FILE *win32_open_process_list(void) {
-    return popen("tasklist /fo csv /nh", "r");
+/* The list handle is the popen() stream itself */
+static TmProcessList *win32_open_process_list(void) {
+    return (TmProcessList *)popen("tasklist /fo csv /nh", "r");
 }
 
-static bool win32_parse_process_line(FILE *fp, TmProcess *out) {
+static void win32_close_process_list(TmProcessList *list) {
+    if (list) pclose((FILE *)list);
+}
+
+static bool win32_parse_process_line(TmProcessList *list, TmProcess *out) {
+    FILE *fp = (FILE *)list;
     if (!fp || !out) return false;
 
     char line[1024];
@@ -63,27 +72,425 @@ static tm_result_t win32_kill_process(uint32_t pid) {
     return TM_ERR_PLATFORM;
 }
 
-static float win32_sample_cpu(void) {
+static float win32_sample_cpu(TmCpuTicks *prev) {
+    (void)prev;
     /* Demo: replace with PdhCollectQueryData / GetSystemTimes. */
     return 5.0f + (float)(rand() % 60);
 }
 
+static int win32_cpu_count(void) {
+    DWORD n = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    if (n < 1)            return 1;
+    if (n > TM_MAX_CORES) return TM_MAX_CORES;
+    return (int)n;
+}
+
+static int win32_sample_cpu_cores(TmCpuTicks *prev, float *out, int max) {
+    (void)prev;
+    /* Demo: replace with NtQuerySystemInformation(SystemProcessorPerformanceInformation). */
+    int n = win32_cpu_count();
+    if (n > max) n = max;
+    for (int i = 0; i < n; i++) out[i] = (float)(rand() % 100);
+    return n;
+}
+
 static void win32_query_memory(uint64_t *used_kb, uint64_t *total_kb) {
-    /* Demo values; replace with GlobalMemoryStatusEx(). */
-    *total_kb = (uint64_t)16 * 1024 * 1024;
-    *used_kb  = (uint64_t)(4000 + rand() % 4000) * 1024;
+    MEMORYSTATUSEX ms;
+    ms.dwLength = sizeof(ms);
+    if (!GlobalMemoryStatusEx(&ms)) {
+        *used_kb  = 0;
+        *total_kb = 0;
+        return;
+    }
+    *total_kb = (uint64_t)(ms.ullTotalPhys / 1024);
+    *used_kb  = (uint64_t)((ms.ullTotalPhys - ms.ullAvailPhys) / 1024);
+}
+
+static bool win32_query_process_detail(uint32_t pid, TmProcessDetail *out) {
+    /* Not yet implemented: needs OpenProcess + GetProcessMemoryInfo /
+     * GetProcessIoCounters / GetProcessHandleCount. */
+    (void)pid;
+    (void)out;
+    return false;
+}
+
+static bool win32_query_process_rss(uint32_t pid, uint64_t *rss_bytes) {
+    /* Not yet implemented: needs OpenProcess + GetProcessMemoryInfo. */
+    (void)pid;
+    (void)rss_bytes;
+    return false;
+}
+
+/* Not yet implemented: needs OpenProcess + GetProcessTimes /
+ * GetProcessMemoryInfo / GetProcessIoCounters on a kept handle. */
+static int win32_open_process_sampler(uint32_t pid) {
+    (void)pid;
+    return -1;
+}
+
+static bool win32_read_process_sample(int handle, TmProcSample *out) {
+    (void)handle;
+    (void)out;
+    return false;
+}
+
+static void win32_close_process_sampler(int handle) {
+    (void)handle;
+}
+
+/* -------------------------------------------------------------------------
+ * File mapping
+ * ---------------------------------------------------------------------- */
+
+static const void *win32_map_file(const char *path, size_t *size) {
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER len;
+    const void   *base    = NULL;
+    HANDLE        mapping = NULL;
+    if (GetFileSizeEx(file, &len) && len.QuadPart > 0)
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping) {
+        base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);   /* the view keeps the mapping alive */
+    }
+    CloseHandle(file);
+    if (base) *size = (size_t)len.QuadPart;
+    return base;
+}
+
+static void win32_unmap_file(const void *base, size_t size) {
+    (void)size;
+    if (base) UnmapViewOfFile(base);
+}
+
+static bool win32_make_dir(const char *path) {
+    return CreateDirectoryA(path, NULL) || GetLastError() == ERROR_ALREADY_EXISTS;
+}
+
+static int win32_list_dir(const char *path, TmDirEntryFn fn, void *user) {
+    char pattern[MAX_PATH];
+    snprintf(pattern, sizeof(pattern), "%s\\*", path);
+    WIN32_FIND_DATAA fd;
+    HANDLE           h = FindFirstFileA(pattern, &fd);
+    if (h == INVALID_HANDLE_VALUE) return -1;
+    int count = 0;
+    do {
+        if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+        fn(fd.cFileName, ((uint64_t)fd.nFileSizeHigh << 32) | fd.nFileSizeLow, user);
+        count++;
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+    return count;
 }
 
+static bool win32_sync_file(FILE *fp) {
+    return fflush(fp) == 0 && _commit(_fileno(fp)) == 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Shared memory (pagefile-backed sections; "/tm_x" becomes "Local\tm_x")
+ * ---------------------------------------------------------------------- */
+
+static void section_name(const char *name, char *out, size_t cap) {
+    snprintf(out, cap, "Local\\%s", (name[0] == '/') ? name + 1 : name);
+}
+
+/* The creator keeps one handle open for the life of the process, since a
+ * section disappears with its last handle. */
+static void *win32_shm_create(const char *name, size_t size) {
+    char full[96];
+    section_name(name, full, sizeof(full));
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                  (DWORD)((uint64_t)size >> 32), (DWORD)size, full);
+    if (!h) return NULL;
+    void *base = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!base) CloseHandle(h);
+    else       memset(base, 0, size);
+    return base;
+}
+
+static const void *win32_shm_map(const char *name, size_t *size) {
+    char full[96];
+    section_name(name, full, sizeof(full));
+    HANDLE h = OpenFileMappingA(FILE_MAP_READ, FALSE, full);
+    if (!h) return NULL;
+    const void *base = MapViewOfFile(h, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(h);             /* the view keeps the section alive */
+
+    MEMORY_BASIC_INFORMATION mbi;
+    if (base && VirtualQuery(base, &mbi, sizeof(mbi))) *size = mbi.RegionSize;
+    return base;
+}
+
+static void win32_shm_unlink(const char *name) {
+    (void)name;                 /* sections are reclaimed with their last handle */
+}
+
+/* -------------------------------------------------------------------------
+ * Sockets (handles are SOCKETs narrowed to int, as the CRT does for fds)
+ * ---------------------------------------------------------------------- */
+
+static bool wait_readable(SOCKET s, double timeout_s) {
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(s, &set);
+    struct timeval tv;
+    tv.tv_sec  = (long)timeout_s;
+    tv.tv_usec = (long)((timeout_s - (double)tv.tv_sec) * 1e6);
+    return select(0, &set, NULL, NULL, &tv) > 0;
+}
+
+static int win32_tcp_listen(int port) {
+    static bool s_wsa_ready = false;
+    WSADATA     wsa;
+    if (!s_wsa_ready && WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return -1;
+    s_wsa_ready = true;
+
+    SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == INVALID_SOCKET) return -1;
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons((u_short)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(s, 16) != 0) {
+        tm_log_error("Cannot listen on 127.0.0.1:%d (error %d)", port, WSAGetLastError());
+        closesocket(s);
+        return -1;
+    }
+    return (int)s;
+}
+
+static int win32_sock_accept(int listener, double timeout_s) {
+    if (!wait_readable((SOCKET)listener, timeout_s)) return -1;
+    SOCKET c = accept((SOCKET)listener, NULL, NULL);
+    return (c == INVALID_SOCKET) ? -1 : (int)c;
+}
+
+static long win32_sock_recv(int sock, void *buf, size_t n, double timeout_s) {
+    if (!wait_readable((SOCKET)sock, timeout_s)) return -1;
+    return (long)recv((SOCKET)sock, (char *)buf, (int)n, 0);
+}
+
+static double win32_now_s(void);
+
+static bool win32_sock_send(int sock, const void *buf, size_t n, double timeout_s) {
+    const char *p        = (const char *)buf;
+    double      deadline = win32_now_s() + timeout_s;
+    while (n > 0) {
+        /* SO_SNDTIMEO bounds each blocking send by what is left */
+        double left = deadline - win32_now_s();
+        if (left <= 0.0) return false;
+        DWORD ms = (DWORD)(left * 1000.0) + 1;
+        setsockopt((SOCKET)sock, SOL_SOCKET, SO_SNDTIMEO, (const char *)&ms, sizeof(ms));
+        int sent = send((SOCKET)sock, p, (int)n, 0);
+        if (sent <= 0) return false;
+        p += sent;
+        n -= (size_t)sent;
+    }
+    return true;
+}
+
+static void win32_sock_close(int sock) {
+    if (sock >= 0) closesocket((SOCKET)sock);
+}
+
+/* The query socket is a Unix-domain endpoint served from a readiness loop;
+ * neither is wired up here yet, so tm_query_start() reports it unsupported. */
+static int win32_uds_listen(const char *path) {
+    tm_log_warn("Unix domain sockets are not supported on this platform (%s)", path);
+    return -1;
+}
+
+static long win32_sock_send_some(int sock, const void *buf, size_t n) {
+    int sent = send((SOCKET)sock, (const char *)buf, (int)n, 0);
+    if (sent == SOCKET_ERROR) return (WSAGetLastError() == WSAEWOULDBLOCK) ? 0 : -1;
+    return (long)sent;
+}
+
+static bool win32_remove_file(const char *path) {
+    return DeleteFileA(path) != 0;
+}
+
+static TmPoller *win32_poller_create(void) { return NULL; }
+static void win32_poller_destroy(TmPoller *p) { (void)p; }
+
+static bool win32_poller_watch(TmPoller *p, int sock, uint32_t events, void *user) {
+    (void)p; (void)sock; (void)events; (void)user;
+    return false;
+}
+
+static void win32_poller_forget(TmPoller *p, int sock) { (void)p; (void)sock; }
+
+static int win32_poller_wait(TmPoller *p, TmPollEvent *out, int max, double timeout_s) {
+    (void)p; (void)out; (void)max; (void)timeout_s;
+    return 0;
+}
+
+static void win32_poller_wake(TmPoller *p) { (void)p; }
+
+/* -------------------------------------------------------------------------
+ * Clock
+ * ---------------------------------------------------------------------- */
+
+static double win32_now_s(void) {
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+}
+
+static uint64_t win32_epoch_ms(void) {
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    uint64_t t = ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    return (t - 116444736000000000ULL) / 10000u;   /* 100 ns since 1601 */
+}
+
+static void win32_sleep_s(double seconds) {
+    if (seconds > 0.0) Sleep((DWORD)(seconds * 1000.0));
+}
+
+static bool win32_is_exhausted(void) {
+    return false;               /* live data never runs out */
+}
+
+/* -------------------------------------------------------------------------
+ * Threads
+ * ---------------------------------------------------------------------- */
+
+struct TmThread { HANDLE h; TmThreadFn fn; void *arg; };
+struct TmMutex  { SRWLOCK lock; };
+struct TmCond   { CONDITION_VARIABLE cv; };
+
+static DWORD WINAPI win32_thread_main(LPVOID arg) {
+    TmThread *t = arg;
+    t->fn(t->arg);
+    return 0;
+}
+
+static TmThread *win32_thread_start(TmThreadFn fn, void *arg) {
+    TmThread *t = malloc(sizeof(*t));
+    if (!t) return NULL;
+    t->fn  = fn;
+    t->arg = arg;
+    t->h   = CreateThread(NULL, 0, win32_thread_main, t, 0, NULL);
+    if (!t->h) {
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+static void win32_thread_join(TmThread *t) {
+    if (!t) return;
+    WaitForSingleObject(t->h, INFINITE);
+    CloseHandle(t->h);
+    free(t);
+}
+
+static TmMutex *win32_mutex_create(void) {
+    TmMutex *m = malloc(sizeof(*m));
+    if (m) InitializeSRWLock(&m->lock);
+    return m;
+}
+
+static void win32_mutex_destroy(TmMutex *m)  { free(m); }
+static void win32_mutex_lock(TmMutex *m)     { AcquireSRWLockExclusive(&m->lock); }
+static void win32_mutex_unlock(TmMutex *m)   { ReleaseSRWLockExclusive(&m->lock); }
+
+static TmCond *win32_cond_create(void) {
+    TmCond *c = malloc(sizeof(*c));
+    if (c) InitializeConditionVariable(&c->cv);
+    return c;
+}
+
+static void win32_cond_destroy(TmCond *c) { free(c); }
+
+static void win32_cond_wait(TmCond *c, TmMutex *m) {
+    SleepConditionVariableSRW(&c->cv, &m->lock, INFINITE, 0);
+}
+
+static void win32_cond_broadcast(TmCond *c) { WakeAllConditionVariable(&c->cv); }
+
+/* -------------------------------------------------------------------------
+ * Atomics
+ * ---------------------------------------------------------------------- */
+
+/* Aligned 64-bit accesses are single-copy atomic on x64 and ARM64; the
+ * barriers supply the ordering. No interlocked read: it would write. */
+static uint64_t win32_atomic_load_u64(const uint64_t *p) {
+    uint64_t v = *(const volatile uint64_t *)p;
+    MemoryBarrier();
+    return v;
+}
+
+static void win32_atomic_store_u64(uint64_t *p, uint64_t v) {
+    InterlockedExchange64((volatile LONG64 *)p, (LONG64)v);
+}
+
+static void win32_memory_fence(void) { MemoryBarrier(); }
+
 /* -------------------------------------------------------------------------
  * Exported adapter
  * ---------------------------------------------------------------------- */
 
 const TmPlatform k_platform_win32 = {
-    .open_process_list  = win32_open_process_list,
-    .parse_process_line = win32_parse_process_line,
-    .kill_process       = win32_kill_process,
-    .sample_cpu         = win32_sample_cpu,
-    .query_memory       = win32_query_memory,
+    .open_process_list     = win32_open_process_list,
+    .parse_process_line    = win32_parse_process_line,
+    .close_process_list    = win32_close_process_list,
+    .kill_process          = win32_kill_process,
+    .sample_cpu            = win32_sample_cpu,
+    .cpu_count             = win32_cpu_count,
+    .sample_cpu_cores      = win32_sample_cpu_cores,
+    .query_memory          = win32_query_memory,
+    .query_process_detail  = win32_query_process_detail,
+    .query_process_rss     = win32_query_process_rss,
+    .now_s                 = win32_now_s,
+    .epoch_ms              = win32_epoch_ms,
+    .sleep_s               = win32_sleep_s,
+    .open_process_sampler  = win32_open_process_sampler,
+    .read_process_sample   = win32_read_process_sample,
+    .close_process_sampler = win32_close_process_sampler,
+    .map_file              = win32_map_file,
+    .unmap_file            = win32_unmap_file,
+    .make_dir              = win32_make_dir,
+    .list_dir              = win32_list_dir,
+    .sync_file             = win32_sync_file,
+    .shm_create            = win32_shm_create,
+    .shm_map               = win32_shm_map,
+    .shm_unlink            = win32_shm_unlink,
+    .tcp_listen            = win32_tcp_listen,
+    .sock_accept           = win32_sock_accept,
+    .sock_recv             = win32_sock_recv,
+    .sock_send             = win32_sock_send,
+    .sock_close            = win32_sock_close,
+    .uds_listen            = win32_uds_listen,
+    .sock_send_some        = win32_sock_send_some,
+    .remove_file           = win32_remove_file,
+    .poller_create         = win32_poller_create,
+    .poller_destroy        = win32_poller_destroy,
+    .poller_watch          = win32_poller_watch,
+    .poller_forget         = win32_poller_forget,
+    .poller_wait           = win32_poller_wait,
+    .poller_wake           = win32_poller_wake,
+    .is_exhausted          = win32_is_exhausted,
+    .thread_start          = win32_thread_start,
+    .thread_join           = win32_thread_join,
+    .mutex_create          = win32_mutex_create,
+    .mutex_destroy         = win32_mutex_destroy,
+    .mutex_lock            = win32_mutex_lock,
+    .mutex_unlock          = win32_mutex_unlock,
+    .cond_create           = win32_cond_create,
+    .cond_destroy          = win32_cond_destroy,
+    .cond_wait             = win32_cond_wait,
+    .cond_broadcast        = win32_cond_broadcast,
+    .atomic_load_u64       = win32_atomic_load_u64,
+    .atomic_store_u64      = win32_atomic_store_u64,
+    .memory_fence          = win32_memory_fence,
 };
 
 #endif /* _WIN32 */
@@ -20,10 +20,10 @@ static void draw_button_background(const TmButton *btn) {
 }
 
 static void draw_button_label(const TmButton *btn) {
-    int text_w = MeasureText(btn->text, 14);
+    int text_w = ui_text_width(btn->text, 14);
     int text_x = (int)(btn->bounds.x + (btn->bounds.width - text_w) / 2.0f);
     int text_y = (int)(btn->bounds.y + 7.0f);
-    DrawText(btn->text, text_x, text_y, 14, TM_COLOR_TEXT);
+    ui_text_draw(btn->text, text_x, text_y, 14, TM_COLOR_TEXT);
 }
 
 static bool is_clicked(const TmButton *btn, Vector2 mouse) {
@@ -8,26 +8,41 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
 
 #include "../../include/tm_ui.h"
 #include "../../include/tm_platform.h"
 #include "../../include/tm_process.h"
 #include "../../include/tm_startup.h"
-#include "../../include/tm_perf.h"
+#include "../../include/tm_app_history.h"
+#include "../../include/tm_collector.h"
+#include "../../include/tm_watch.h"
 #include "../../include/tm_log.h"
 
-/* forward declaration of internal helper used before definition */
-static void update_scrollbar_content(TmAppState *s);
-
 /* -------------------------------------------------------------------------
  * Strategy table -- tab renderers
  * ---------------------------------------------------------------------- */
 
+/* Warm start may already have built the history list */
+static tm_result_t load_app_history(TmAppState *s) {
+    return s->history_list ? TM_OK : tm_history_init(s);
+}
+
+/*
+ * Nothing here is released: App History rings keep sampling in the
+ * baseline while the tab is hidden, and Startup toggles live only in
+ * that list.
+ */
 static const TmTabDescriptor k_tabs[TM_TAB_COUNT] = {
-    { TM_TAB_PROCESSES,   "Processes",   ui_tab_process_draw  },
-    { TM_TAB_PERFORMANCE, "Performance", ui_tab_perf_draw     },
-    { TM_TAB_APP_HISTORY, "App History", ui_tab_history_draw  },
-    { TM_TAB_STARTUP,     "Startup",     ui_tab_startup_draw  },
+    { TM_TAB_PROCESSES,   "Processes",   ui_tab_process_draw,
+      TM_DATA_PROCESSES | TM_DATA_PROC_DETAIL, NULL, NULL },
+    { TM_TAB_PERFORMANCE, "Performance", ui_tab_perf_draw,    TM_DATA_PERF_DETAIL, NULL, NULL },
+    { TM_TAB_APP_HISTORY, "App History", ui_tab_history_draw, TM_DATA_APP_HISTORY,
+      load_app_history, NULL },
+    { TM_TAB_STARTUP,     "Startup",     ui_tab_startup_draw, TM_DATA_NONE,
+      tm_startup_list_load, NULL },
+    { TM_TAB_WATCH,       "Watch",       ui_tab_watch_draw,   TM_DATA_NONE,        NULL, NULL },
+    { TM_TAB_HEATMAP,     "Heatmap",     ui_tab_heatmap_draw, TM_DATA_PROCESSES,   NULL, NULL },
 };
 
 /* -------------------------------------------------------------------------
@@ -36,8 +51,7 @@ static const TmTabDescriptor k_tabs[TM_TAB_COUNT] = {
 
 static tm_result_t cmd_refresh(TmAppState *s, void *param) {
     (void)param;
-    TM_CHECK(tm_process_list_refresh(s));
-    TM_CHECK(tm_perf_update(s));
+    TM_CHECK(tm_collector_collect(s, s->collector.needs | TM_DATA_PROCESSES));
     ui_toast_show(s, "Refreshed", GREEN, TM_MSG_SHORT_FRAMES);
     return TM_OK;
 }
@@ -50,13 +64,33 @@ static tm_result_t cmd_end_task(TmAppState *s, void *param) {
     tm_result_t r = tm_process_kill(sel->pid);
     if (r == TM_OK) {
         ui_toast_show(s, "Process terminated", GREEN, TM_MSG_DISPLAY_FRAMES);
-        tm_process_list_refresh(s);
+        tm_collector_collect(s, TM_DATA_PROCESSES);
     } else {
         ui_toast_show(s, "Failed to terminate process", RED, TM_MSG_DISPLAY_FRAMES);
     }
     return r;
 }
 
+static tm_result_t cmd_toggle_pin(TmAppState *s, void *param) {
+    (void)param;
+    TmProcess *sel = tm_process_get_selected(s);
+    if (!sel) return TM_ERR_INVALID_ARG;
+
+    if (tm_watch_is_pinned(s, sel->pid)) {
+        TM_CHECK(tm_watch_unpin(s, sel->pid));
+        ui_toast_show(s, "Unpinned from watch list", ORANGE, TM_MSG_SHORT_FRAMES);
+        return TM_OK;
+    }
+    tm_result_t r = tm_watch_pin(s, sel);
+    if (r == TM_OK) {
+        ui_toast_show(s, "Pinned to watch list", GREEN, TM_MSG_SHORT_FRAMES);
+    } else {
+        ui_toast_show(s, "Cannot pin process (watch list full?)", RED,
+                      TM_MSG_DISPLAY_FRAMES);
+    }
+    return r;
+}
+
 static tm_result_t cmd_enable_startup(TmAppState *s, void *param) {
     (void)param;
     if (s->selected_startup_idx < 0) return TM_ERR_INVALID_ARG;
@@ -92,42 +126,37 @@ static tm_result_t cmd_disable_startup(TmAppState *s, void *param) {
 }
 
 /* -------------------------------------------------------------------------
- * Scrollbar layout
+ * Tab lifecycle -- descriptor load / release hooks
  * ---------------------------------------------------------------------- */
 
-static void layout_scrollbars(TmAppState *s) {
-    int x = s->screen_w - TM_SCROLLBAR_WIDTH_PX - 3;
-
-    s->process_scroll.bounds = (Rectangle){
-        (float)x, 120.0f,
-        TM_SCROLLBAR_WIDTH_PX, (float)(s->screen_h - 200) };
-    s->process_scroll.visible_height = s->screen_h - 200;
-
-    s->startup_scroll.bounds = (Rectangle){
-        (float)x, 220.0f,
-        TM_SCROLLBAR_WIDTH_PX, (float)(s->screen_h - 300) };
-    s->startup_scroll.visible_height = s->screen_h - 300;
-
-    s->history_scroll.bounds = (Rectangle){
-        (float)x, 230.0f,
-        TM_SCROLLBAR_WIDTH_PX, (float)(s->screen_h - 310) };
-    s->history_scroll.visible_height = s->screen_h - 310;
+/* Show tab @p i: run its load hook unless its data is already there. */
+static void tab_load(TmAppState *s, int i) {
+    TmTab *t = &s->tabs[i];
+    t->last_seen = g_platform->now_s();
+    if (t->is_loaded) return;
+    if (k_tabs[i].load && k_tabs[i].load(s) != TM_OK) {
+        tm_log_warn("%s tab failed to load its data", k_tabs[i].label);
+        return;                 /* retried on the next activation */
+    }
+    t->is_loaded = true;
+    ui_layout_invalidate(s, TM_LAYOUT_DIRTY_CONTENT);
 }
 
-static void layout_buttons(TmAppState *s) {
-    s->refresh_btn.bounds = (Rectangle){
-        (float)(s->screen_w - 180), 10.0f, 120.0f, TM_BUTTON_HEIGHT_PX };
-    s->end_task_btn.bounds = (Rectangle){
-        (float)(s->screen_w - 310), 10.0f, 120.0f, TM_BUTTON_HEIGHT_PX };
-    s->enable_startup_btn.bounds = (Rectangle){
-        (float)(s->screen_w - 320), 10.0f, 140.0f, TM_BUTTON_HEIGHT_PX };
-    s->disable_startup_btn.bounds = (Rectangle){
-        (float)(s->screen_w - 470), 10.0f, 140.0f, TM_BUTTON_HEIGHT_PX };
+static void tab_release(TmAppState *s, int i) {
+    k_tabs[i].release(s);
+    s->tabs[i].is_loaded = false;
+    ui_layout_invalidate(s, TM_LAYOUT_DIRTY_CONTENT);
+    tm_log_info("%s tab unused for %.0f s; released its data",
+                k_tabs[i].label, TM_TAB_RELEASE_S);
 }
 
+/* -------------------------------------------------------------------------
+ * Tab strip layout (fixed; independent of the window size)
+ * ---------------------------------------------------------------------- */
+
 static void layout_tabs(TmAppState *s) {
     int tab_x = 10;
-    int tab_w[] = { 100, 100, 100, 80 };
+    int tab_w[] = { 100, 100, 100, 80, 80, 80 };
     for (int i = 0; i < TM_TAB_COUNT; i++) {
         s->tabs[i].bounds = (Rectangle){
             (float)tab_x, 50.0f, (float)tab_w[i], TM_TAB_HEIGHT_PX };
@@ -157,6 +186,10 @@ static void init_buttons(TmAppState *s) {
         {0}, "End Task", false,
         { 200, 60, 60, 255 }, { 220, 80, 80, 255 }, false
     };
+    s->pin_btn = (TmButton){
+        {0}, "Pin / Unpin", false,
+        { 180, 150, 40, 255 }, { 200, 170, 60, 255 }, false
+    };
     s->enable_startup_btn = (TmButton){
         {0}, "Enable Startup", false,
         { 60, 160, 60, 255 }, { 80, 180, 80, 255 }, false
@@ -171,43 +204,17 @@ void ui_init(TmAppState *s) {
     if (!s) return;
     init_tabs(s);
     init_buttons(s);
+    ui_text_init();
+    ui_text_cache_init();
+    ui_frame_init(s);
     s->selected_process_idx = -1;
     s->selected_startup_idx = -1;
     s->active_tab           = TM_TAB_PROCESSES;
-    ui_layout_update(s);
-}
-
-void ui_layout_update(TmAppState *s) {
-    if (!s) return;
+    tm_collector_set_needs(s, k_tabs[TM_TAB_PROCESSES].data_needs);
+    tab_load(s, TM_TAB_PROCESSES);
     layout_tabs(s);
-    layout_buttons(s);
-    layout_scrollbars(s);
-    update_scrollbar_content(s);
-}
-
-/* -------------------------------------------------------------------------
- * Scrollbar content size updates
- * ---------------------------------------------------------------------- */
-
-static void update_scrollbar_content(TmAppState *s) {
-    /* Process */
-    s->process_scroll.content_height = s->process_count * TM_ROW_HEIGHT_PX;
-    int excess = s->process_scroll.content_height - s->process_scroll.visible_height;
-    s->process_scroll.max_scroll = (excess > 0) ? excess : 0;
-
-    /* Startup */
-    int startup_cnt = 0;
-    for (TmStartupApp *a = s->startup_list; a; a = a->next) startup_cnt++;
-    s->startup_scroll.content_height = startup_cnt * TM_STARTUP_ROW_PX;
-    excess = s->startup_scroll.content_height - s->startup_scroll.visible_height;
-    s->startup_scroll.max_scroll = (excess > 0) ? excess : 0;
-
-    /* History */
-    int hist_cnt = 0;
-    for (TmAppHistory *a = s->history_list; a; a = a->next) hist_cnt++;
-    s->history_scroll.content_height = hist_cnt * TM_HISTORY_ROW_PX;
-    excess = s->history_scroll.content_height - s->history_scroll.visible_height;
-    s->history_scroll.max_scroll = (excess > 0) ? excess : 0;
+    ui_layout_invalidate(s, TM_LAYOUT_DIRTY_SIZE | TM_LAYOUT_DIRTY_CONTENT);
+    ui_layout_sync(s);
 }
 
 /* -------------------------------------------------------------------------
@@ -219,11 +226,17 @@ static void handle_tab_clicks(TmAppState *s, Vector2 mouse) {
 
     for (int i = 0; i < TM_TAB_COUNT; i++) {
         if (!CheckCollisionPointRec(mouse, s->tabs[i].bounds)) continue;
+        s->tabs[s->active_tab].last_seen = g_platform->now_s();  /* disuse starts */
         for (int j = 0; j < TM_TAB_COUNT; j++) s->tabs[j].is_active = (j == i);
         s->active_tab              = (TmTabId)i;
+        tab_load(s, i);
+        tm_collector_set_needs(s, k_tabs[i].data_needs);
+        TmProcess *sel = tm_process_at(s, s->selected_process_idx);
+        if (sel) sel->is_selected = false;
         s->selected_process_idx    = -1;
         s->selected_startup_idx    = -1;
         s->end_task_btn.is_enabled      = false;
+        s->pin_btn.is_enabled           = false;
         s->enable_startup_btn.is_enabled  = false;
         s->disable_startup_btn.is_enabled = false;
         break;
@@ -238,37 +251,26 @@ static void handle_process_selection(TmAppState *s, Vector2 mouse) {
     if (!s->tabs[TM_TAB_PROCESSES].is_active) return;
     if (!IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) return;
 
-    Rectangle area = { 10, 120, (float)(s->screen_w - 30),
-                        (float)(s->screen_h - 200) };
-    if (!CheckCollisionPointRec(mouse, area)) return;
+    TmVList rows    = ui_process_vlist(s);
+    int     new_idx = ui_vlist_row_at(&rows, mouse);
+    if (new_idx < 0) return;
 
-    int click_y  = (int)(mouse.y - 120) + s->process_scroll.scroll_pos;
-    int new_idx  = click_y / TM_ROW_HEIGHT_PX;
-    if (new_idx < 0 || new_idx >= s->process_count) return;
+    TmProcess *prev = tm_process_at(s, s->selected_process_idx);
+    if (prev) prev->is_selected = false;
+    tm_process_at(s, new_idx)->is_selected = true;
 
     s->selected_process_idx = new_idx;
     s->end_task_btn.is_enabled = true;
-
-    TmProcess *cur = s->process_list;
-    int         i   = 0;
-    while (cur) {
-        cur->is_selected = (i == new_idx);
-        cur = cur->next;
-        i++;
-    }
+    s->pin_btn.is_enabled      = true;
 }
 
 static void handle_startup_selection(TmAppState *s, Vector2 mouse) {
     if (!s->tabs[TM_TAB_STARTUP].is_active) return;
     if (!IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) return;
 
-    Rectangle area = { 30, 220, (float)(s->screen_w - 60),
-                        (float)(s->screen_h - 300) };
-    if (!CheckCollisionPointRec(mouse, area)) return;
-
-    int click_y = (int)(mouse.y - 220) + s->startup_scroll.scroll_pos;
-    int new_idx = click_y / TM_STARTUP_ROW_PX;
-    TmStartupApp *app = tm_startup_get(s, new_idx);
+    TmVList       rows    = ui_startup_vlist(s);
+    int           new_idx = ui_vlist_row_at(&rows, mouse);
+    TmStartupApp *app     = tm_startup_get(s, new_idx);
     if (!app) return;
 
     s->selected_startup_idx           = new_idx;
@@ -280,6 +282,16 @@ static void handle_startup_selection(TmAppState *s, Vector2 mouse) {
  * Input: keyboard shortcuts
  * ---------------------------------------------------------------------- */
 
+/* Every key handle_keyboard() reacts to */
+static const int k_bound_keys[] = { KEY_F5, KEY_DELETE, KEY_P, KEY_E, KEY_D };
+
+bool ui_input_key_pending(void) {
+    for (size_t i = 0; i < sizeof(k_bound_keys) / sizeof(k_bound_keys[0]); i++) {
+        if (IsKeyPressed(k_bound_keys[i]) || IsKeyDown(k_bound_keys[i])) return true;
+    }
+    return false;
+}
+
 static void handle_keyboard(TmAppState *s) {
     if (IsKeyPressed(KEY_F5)) {
         cmd_refresh(s, NULL);
@@ -287,6 +299,9 @@ static void handle_keyboard(TmAppState *s) {
     if (IsKeyPressed(KEY_DELETE) && s->selected_process_idx >= 0) {
         cmd_end_task(s, NULL);
     }
+    if (IsKeyPressed(KEY_P) && s->selected_process_idx >= 0) {
+        cmd_toggle_pin(s, NULL);
+    }
     if (s->selected_startup_idx >= 0) {
         if (IsKeyPressed(KEY_E)) cmd_enable_startup(s, NULL);
         if (IsKeyPressed(KEY_D)) cmd_disable_startup(s, NULL);
@@ -299,17 +314,14 @@ static void handle_keyboard(TmAppState *s) {
 
 static void handle_scrollbars(TmAppState *s, Vector2 mouse, float wheel) {
     if (s->active_tab == TM_TAB_PROCESSES) {
-        Rectangle area = { 10, 120, (float)(s->screen_w - 30),
-                           (float)(s->screen_h - 200) };
-        ui_scrollbar_update(&s->process_scroll, mouse, wheel, area);
+        ui_scrollbar_update(&s->process_scroll, mouse, wheel,
+                            ui_layout_rect(s, TM_NODE_PROC_LIST));
     } else if (s->active_tab == TM_TAB_STARTUP) {
-        Rectangle area = { 20, 120, (float)(s->screen_w - 30),
-                           (float)(s->screen_h - 170) };
-        ui_scrollbar_update(&s->startup_scroll, mouse, wheel, area);
+        ui_scrollbar_update(&s->startup_scroll, mouse, wheel,
+                            ui_layout_rect(s, TM_NODE_STARTUP_PANEL));
     } else if (s->active_tab == TM_TAB_APP_HISTORY) {
-        Rectangle area = { 20, 120, (float)(s->screen_w - 30),
-                           (float)(s->screen_h - 170) };
-        ui_scrollbar_update(&s->history_scroll, mouse, wheel, area);
+        ui_scrollbar_update(&s->history_scroll, mouse, wheel,
+                            ui_layout_rect(s, TM_NODE_HISTORY_PANEL));
     }
 }
 
@@ -319,6 +331,7 @@ static void handle_scrollbars(TmAppState *s, Vector2 mouse, float wheel) {
 
 void ui_input_update(TmAppState *s) {
     if (!s) return;
+    ui_layout_sync(s);
 
     Vector2 mouse = GetMousePosition();
     float   wheel = GetMouseWheelMove();
@@ -333,7 +346,12 @@ void ui_input_update(TmAppState *s) {
     handle_startup_selection(s, mouse);
     handle_keyboard(s);
     handle_scrollbars(s, mouse, wheel);
-    update_scrollbar_content(s);
+
+    if (s->active_tab == TM_TAB_PROCESSES) {
+        int first, count;
+        ui_process_visible_range(s, &first, &count);
+        tm_collector_set_viewport(s, first, count);
+    }
 }
 
 /* -------------------------------------------------------------------------
@@ -341,12 +359,7 @@ void ui_input_update(TmAppState *s) {
  * ---------------------------------------------------------------------- */
 
 static bool is_mouse_over_resize_handle(const TmAppState *s, Vector2 mouse) {
-    Rectangle handle = {
-        (float)(s->screen_w - TM_RESIZE_BORDER_PX),
-        (float)(s->screen_h - TM_RESIZE_BORDER_PX),
-        TM_RESIZE_BORDER_PX, TM_RESIZE_BORDER_PX
-    };
-    return CheckCollisionPointRec(mouse, handle);
+    return CheckCollisionPointRec(mouse, ui_layout_rect(s, TM_NODE_RESIZE_GRIP));
 }
 
 void ui_window_resize_handle(TmAppState *s) {
@@ -368,7 +381,7 @@ void ui_window_resize_handle(TmAppState *s) {
             SetWindowSize(new_w, new_h);
             s->screen_w = new_w;
             s->screen_h = new_h;
-            ui_layout_update(s);
+            ui_layout_invalidate(s, TM_LAYOUT_DIRTY_SIZE);
         } else {
             s->is_resizing = false;
         }
@@ -377,7 +390,31 @@ void ui_window_resize_handle(TmAppState *s) {
     if (IsWindowResized() && !s->is_resizing) {
         s->screen_w = GetScreenWidth();
         s->screen_h = GetScreenHeight();
-        ui_layout_update(s);
+        ui_layout_invalidate(s, TM_LAYOUT_DIRTY_SIZE);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Idle maintenance
+ * ---------------------------------------------------------------------- */
+
+void ui_tabs_idle(TmAppState *s) {
+    if (!s) return;
+    double now = g_platform->now_s();
+    for (int i = 0; i < TM_TAB_COUNT; i++) {
+        const TmTab *t = &s->tabs[i];
+        if (t->is_active || !t->is_loaded || !k_tabs[i].release) continue;
+        if (now - t->last_seen >= TM_TAB_RELEASE_S) tab_release(s, i);
+    }
+
+    /* One never-loaded tab per pass, once the first gather is in and
+     * nothing has been drawn for a while */
+    if (s->collector.is_priming || now - s->frame.drawn_at < TM_TAB_PRELOAD_IDLE_S) return;
+    for (int i = 0; i < TM_TAB_COUNT; i++) {
+        if (s->tabs[i].last_seen != 0.0 || !k_tabs[i].load) continue;
+        tab_load(s, i);
+        tm_log_debug("Preloaded the %s tab while idle", k_tabs[i].label);
+        return;
     }
 }
 
@@ -386,8 +423,20 @@ void ui_window_resize_handle(TmAppState *s) {
  * ---------------------------------------------------------------------- */
 
 void ui_titlebar_draw(const TmAppState *s) {
-    DrawRectangle(0, 0, s->screen_w, 40, TM_COLOR_ACCENT);
-    DrawText("Advanced Task Manager", 10, 10, 20, WHITE);
+    Rectangle bar = ui_layout_rect(s, TM_NODE_TITLE_BAR);
+    DrawRectangleRec(bar, TM_COLOR_ACCENT);
+    ui_text_draw("Advanced Task Manager", 10, 10, 20, WHITE);
+    if (!s->collector.is_priming) return;
+
+    /* Rows on screen are a warm-start snapshot, or nothing yet */
+    char note[64] = "Collecting...";
+    if (s->warm_ms) {
+        time_t     t  = (time_t)(s->warm_ms / 1000u);
+        struct tm *lt = localtime(&t);
+        if (lt) strftime(note, sizeof(note), "Snapshot from %H:%M:%S - collecting...", lt);
+    }
+    int w = ui_text_width(note, 16);
+    ui_text_draw(note, (int)(bar.x + bar.width) - w - 10, 12, 16, ORANGE);
 }
 
 void ui_tabs_draw(const TmAppState *s) {
@@ -400,10 +449,10 @@ void ui_tabs_draw(const TmAppState *s) {
         DrawRectangleLines((int)tab->bounds.x, (int)tab->bounds.y,
                            (int)tab->bounds.width, (int)tab->bounds.height, border_col);
 
-        int text_w = MeasureText(tab->text, 16);
+        int text_w = ui_text_width(tab->text, 16);
         int text_x = (int)(tab->bounds.x + (tab->bounds.width - text_w) / 2.0f);
-        DrawText(tab->text, text_x, (int)(tab->bounds.y + 8),
-                 16, tab->is_active ? WHITE : TM_COLOR_SUBTLE);
+        ui_text_draw(tab->text, text_x, (int)(tab->bounds.y + 8),
+                     16, tab->is_active ? WHITE : TM_COLOR_SUBTLE);
     }
 }
 
@@ -417,6 +466,9 @@ void ui_buttons_draw(const TmAppState *s) {
         ui_button_draw_and_handle(
             (TmButton *)&s->end_task_btn,
             (TmAppState *)s, cmd_end_task, NULL);
+        ui_button_draw_and_handle(
+            (TmButton *)&s->pin_btn,
+            (TmAppState *)s, cmd_toggle_pin, NULL);
     }
     if (s->active_tab == TM_TAB_STARTUP) {
         ui_button_draw_and_handle(
@@ -429,15 +481,19 @@ void ui_buttons_draw(const TmAppState *s) {
 }
 
 void ui_statusbar_draw(const TmAppState *s) {
-    DrawRectangle(0, s->screen_h - 80, s->screen_w, 80, TM_COLOR_HEADER);
-    DrawText("F5: Refresh   |   Delete: End Task   |   E/D: Enable/Disable Startup",
-             15, s->screen_h - 35, 14, TM_COLOR_SUBTLE);
+    Rectangle bar = ui_layout_rect(s, TM_NODE_STATUS_BAR);
+    DrawRectangleRec(bar, TM_COLOR_HEADER);
+    ui_text_draw("F5: Refresh   |   Delete: End Task   |   P: Pin/Unpin   |   E/D: Enable/Disable Startup",
+                 15, (int)bar.y + 45, 14, TM_COLOR_SUBTLE);
 }
 
 void ui_resize_handle_draw(const TmAppState *s) {
+    Rectangle grip  = ui_layout_rect(s, TM_NODE_RESIZE_GRIP);
+    int       right = (int)(grip.x + grip.width);
+    int       bot   = (int)(grip.y + grip.height);
     for (int i = 0; i < 3; i++) {
-        DrawLine(s->screen_w - 12 + i * 4, s->screen_h - 4,
-                 s->screen_w - 4,          s->screen_h - 12 + i * 4,
+        DrawLine(right - 12 + i * 4, bot - 4,
+                 right - 4,          bot - 12 + i * 4,
                  TM_COLOR_SUBTLE);
     }
 }
@@ -470,11 +526,11 @@ void ui_toast_tick(TmAppState *s) {
 void ui_toast_draw(const TmAppState *s) {
     if (!s || s->message_timer <= 0) return;
 
-    int text_w = MeasureText(s->message, 16);
+    int text_w = ui_text_width(s->message, 16);
     int msg_x  = s->screen_w / 2 - text_w / 2;
 
     DrawRectangle(msg_x - 10, 10, text_w + 20, 30, s->message_color);
     DrawRectangleLines(msg_x - 10, 10, text_w + 20, 30,
                        (Color){ 100, 100, 100, 255 });
-    DrawText(s->message, msg_x, 15, 16, WHITE);
+    ui_text_draw(s->message, msg_x, 15, 16, WHITE);
 }
@@ -0,0 +1,129 @@
+/**
+ * @file ui_frame.c
+ * @brief Frame scheduler: draw only when something visible may change.
+ *
+ * A frame is drawn on input, when the event bus publishes a new sample,
+ * while a toast is counting down, and for TM_FRAME_SETTLE frames after
+ * each such trigger (commands run from button handlers inside the draw
+ * pass). Otherwise the loop sleeps for one poll period and polls input,
+ * so polling keeps the 60 Hz cadence and input latency is unchanged.
+ *
+ * Time to first frame is measured twice: to the first frame presented,
+ * which may show a warm-start snapshot, and to the first frame whose
+ * process rows come from a live gather.
+ */
+
+#include "../../include/tm_ui.h"
+#include "../../include/tm_event.h"
+#include "../../include/tm_platform.h"
+#include "../../include/tm_log.h"
+
+/* -------------------------------------------------------------------------
+ * Internal helpers
+ * ---------------------------------------------------------------------- */
+
+static void on_published(const TmEvent *ev, void *user) {
+    (void)ev;
+    ((TmFrameSched *)user)->is_dirty = true;
+}
+
+/* Any input that the UI reacts to since the last poll */
+static bool input_pending(void) {
+    Vector2 delta = GetMouseDelta();
+    if (delta.x != 0.0f || delta.y != 0.0f)   return true;
+    if (GetMouseWheelMove() != 0.0f)          return true;
+    if (ui_input_key_pending())               return true;   /* does not drain the queue */
+    if (IsWindowResized())                    return true;
+    for (int b = MOUSE_BUTTON_LEFT; b <= MOUSE_BUTTON_MIDDLE; b++) {
+        if (IsMouseButtonPressed(b) || IsMouseButtonReleased(b)
+            || IsMouseButtonDown(b))
+            return true;
+    }
+    return false;
+}
+
+static float ms_since_launch(const TmFrameSched *f, double now) {
+    return (float)((now - f->launched_at) * 1000.0);
+}
+
+/* Time the first frame and the first frame of live data */
+static void note_first_frames(const TmAppState *s, TmFrameSched *f, double now) {
+    if (f->frames_drawn == 0) {
+        f->first_frame_ms = ms_since_launch(f, now);
+        tm_log_info("First frame after %.1f ms (%s)", (double)f->first_frame_ms,
+                    s->warm_ms ? "warm snapshot"
+                    : s->collector.is_priming ? "no process data yet" : "live data");
+    }
+    if (f->first_live_ms == 0.0f && !s->collector.is_priming) {
+        f->first_live_ms = ms_since_launch(f, now);
+        if (f->frames_drawn > 0)
+            tm_log_info("First live frame after %.1f ms", (double)f->first_live_ms);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+void ui_frame_init(TmAppState *s) {
+    if (!s) return;
+    s->frame = (TmFrameSched){ 0 };
+    s->frame.redraw_frames = TM_FRAME_SETTLE;  /* first frame */
+    s->frame.polled_at     = g_platform->now_s();
+    s->frame.drawn_at      = s->frame.polled_at;
+    tm_event_subscribe(TM_EVENT_DATA_ALL, TM_DISPATCH_UI, on_published, &s->frame, NULL);
+}
+
+bool ui_frame_should_draw(TmAppState *s) {
+    if (!s) return true;
+    TmFrameSched *f = &s->frame;
+
+    if (input_pending()) {
+        if (f->input_at == 0.0) f->input_at = f->polled_at;
+        f->redraw_frames = TM_FRAME_SETTLE;
+    }
+    if (f->is_dirty || s->message_timer > 0 || s->is_resizing) {
+        f->is_dirty      = false;
+        f->redraw_frames = TM_FRAME_SETTLE;
+    }
+    if (f->redraw_frames <= 0) return false;
+    f->redraw_frames--;
+    return true;
+}
+
+void ui_frame_drawn(TmAppState *s) {
+    if (!s) return;
+    TmFrameSched *f   = &s->frame;
+    double        now = g_platform->now_s();
+
+    /* EndDrawing() polled input; the next frame sees it */
+    if (f->input_at > 0.0) {
+        float ms = (float)((now - f->input_at) * 1000.0);
+        f->latency_sum_ms += ms;
+        if (ms > f->latency_max_ms) f->latency_max_ms = ms;
+        f->latency_count++;
+        f->input_at = 0.0;
+    }
+    note_first_frames(s, f, now);
+    f->polled_at = now;
+    f->drawn_at  = now;
+    f->frames_drawn++;
+}
+
+void ui_frame_idle(TmAppState *s) {
+    if (!s) return;
+    g_platform->sleep_s(TM_FRAME_IDLE_WAIT_S);   /* replay may skip ahead */
+    PollInputEvents();
+    s->frame.polled_at = g_platform->now_s();
+    s->frame.frames_idle++;
+}
+
+void ui_frame_report(const TmAppState *s) {
+    if (!s) return;
+    const TmFrameSched *f = &s->frame;
+    double avg = f->latency_count ? f->latency_sum_ms / f->latency_count : 0.0;
+    tm_log_info("Frames drawn %u, idle %u; input latency avg %.1f ms, max %.1f ms",
+                f->frames_drawn, f->frames_idle, avg, (double)f->latency_max_ms);
+    tm_log_info("Time to first frame %.1f ms, to first live frame %.1f ms",
+                (double)f->first_frame_ms, (double)f->first_live_ms);
+}
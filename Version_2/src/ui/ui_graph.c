@@ -0,0 +1,218 @@
+/**
+ * @file ui_graph.c
+ * @brief Render-texture cache for graphs.
+ *
+ * Graph data changes once per sample, but a graph is dozens of draw
+ * calls. Each graph is painted into its own RenderTexture2D and repainted
+ * only when its sample sequence or size changes; other frames blit the
+ * texture. Series are decimated to at most two points per pixel column
+ * and submitted as one line strip, so long histories cost O(width) to draw.
+ * Sparklines are queued into one shared vertex buffer while rows draw and
+ * flushed back to back, so all of them share one line batch.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../include/tm_ui.h"
+
+/* -------------------------------------------------------------------------
+ * Cache storage (module-private)
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    const void     *key;      /* NULL marks a free slot */
+    uint32_t        gen;
+    uint32_t        last_use;
+    RenderTexture2D target;
+} TmGraphSlot;
+
+static TmGraphSlot s_graphs[TM_GRAPH_CACHE_MAX];
+static uint32_t    s_use_clock = 0;
+
+/* Scratch polyline shared by all series draws (UI thread only) */
+static Vector2 *s_points     = NULL;
+static int      s_points_cap = 0;
+
+static bool reserve_points(int n) {
+    if (n <= s_points_cap) return true;
+    Vector2 *p = realloc(s_points, (size_t)n * sizeof(*p));
+    if (!p) return false;
+    s_points     = p;
+    s_points_cap = n;
+    return true;
+}
+
+/* Queued sparklines: vertices back to back, plus each strip's length */
+static Vector2 *s_spark     = NULL;
+static int      s_spark_len = 0;
+static int      s_spark_cap = 0;
+static int     *s_strips    = NULL;
+static int      s_strip_len = 0;
+static int      s_strip_cap = 0;
+
+static bool grow(void **buf, int *cap, int need, size_t elem) {
+    if (need <= *cap) return true;
+    int   n = (*cap > 0) ? *cap : 256;
+    while (n < need) n *= 2;
+    void *p = realloc(*buf, (size_t)n * elem);
+    if (!p) return false;
+    *buf = p;
+    *cap = n;
+    return true;
+}
+
+/* Slot holding @p key, else a free slot, else the least recently used. */
+static TmGraphSlot *find_slot(const void *key) {
+    TmGraphSlot *victim = &s_graphs[0];
+    for (int i = 0; i < TM_GRAPH_CACHE_MAX; i++) {
+        TmGraphSlot *g = &s_graphs[i];
+        if (g->key == key) return g;
+        if (victim->key && (!g->key || g->last_use < victim->last_use)) victim = g;
+    }
+    return victim;
+}
+
+static bool ensure_target(TmGraphSlot *g, const void *key, int w, int h) {
+    bool fits = g->key == key && g->target.id != 0
+                && g->target.texture.width == w && g->target.texture.height == h;
+    if (fits) return true;
+
+    if (g->target.id != 0) UnloadRenderTexture(g->target);
+    g->key    = key;
+    g->target = LoadRenderTexture(w, h);
+    return false;
+}
+
+/* -------------------------------------------------------------------------
+ * Series decimation
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    int   count;
+    int   min_at, max_at;   /* sample positions, to keep their time order */
+    float min_v,  max_v;
+} TmColumn;
+
+/* Emit one column's extremes (in time order) into the polyline */
+static int flush_column(const TmColumn *c, float x, float y0, float scale, int n) {
+    float first  = (c->min_at <= c->max_at) ? c->min_v : c->max_v;
+    float second = (c->min_at <= c->max_at) ? c->max_v : c->min_v;
+    s_points[n++] = (Vector2){ x, y0 - first * scale };
+    if (c->count > 1 && second != first)
+        s_points[n++] = (Vector2){ x, y0 - second * scale };
+    return n;
+}
+
+void ui_graph_series_draw(const float *ring, int cap, int start, int len,
+                          float max_v, Rectangle area, Color col) {
+    if (!ring || cap < 2 || len < 2 || max_v <= 0.0f) return;
+    if (len > cap) len = cap;
+
+    int cols = (int)area.width + 1;
+    if (!reserve_points(2 * cols + 2)) return;
+
+    float    x_step = area.width / (float)(cap - 1);
+    float    y0     = area.y + area.height;
+    float    scale  = area.height / max_v;
+    TmColumn c      = { 0, 0, 0, 0.0f, 0.0f };
+    int      cur_x  = -1;
+    int      n      = 0;
+
+    for (int i = 0; i < len; i++) {
+        float v = ring[(start + i) % cap];
+        int   x = (int)((float)i * x_step);
+        if (x != cur_x) {
+            if (c.count) n = flush_column(&c, area.x + (float)cur_x, y0, scale, n);
+            c     = (TmColumn){ 0, i, i, v, v };
+            cur_x = x;
+        }
+        if (v < c.min_v) { c.min_v = v; c.min_at = i; }
+        if (v > c.max_v) { c.max_v = v; c.max_at = i; }
+        c.count++;
+    }
+    if (c.count) n = flush_column(&c, area.x + (float)cur_x, y0, scale, n);
+
+    if (n >= 2) DrawLineStrip(s_points, n, col);
+}
+
+/* -------------------------------------------------------------------------
+ * Sparkline batch
+ * ---------------------------------------------------------------------- */
+
+void ui_graph_spark_queue(const float *samples, int n, int slots, float max_v,
+                          Rectangle area) {
+    if (!samples || n < 2 || slots < 2 || max_v <= 0.0f) return;
+    if (n > slots) n = slots;
+    if (!grow((void **)&s_spark, &s_spark_cap, s_spark_len + n, sizeof(Vector2))
+        || !grow((void **)&s_strips, &s_strip_cap, s_strip_len + 1, sizeof(int)))
+        return;
+
+    /* Right-aligned: the newest sample sits on the right edge */
+    float step  = area.width / (float)(slots - 1);
+    float x0    = area.x + area.width - (float)(n - 1) * step;
+    float y0    = area.y + area.height;
+    float scale = area.height / max_v;
+    for (int i = 0; i < n; i++) {
+        float v = samples[i];
+        if (v < 0.0f)  v = 0.0f;
+        if (v > max_v) v = max_v;
+        s_spark[s_spark_len + i] = (Vector2){ x0 + (float)i * step, y0 - v * scale };
+    }
+    s_spark_len += n;
+    s_strips[s_strip_len++] = n;
+}
+
+void ui_graph_spark_flush(Color col) {
+    int off = 0;
+    for (int i = 0; i < s_strip_len; i++) {
+        DrawLineStrip(&s_spark[off], s_strips[i], col);
+        off += s_strips[i];
+    }
+    s_spark_len = 0;
+    s_strip_len = 0;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+void ui_graph_draw_cached(const void *key, uint32_t gen, Rectangle bounds,
+                          TmGraphPaintFn paint, const void *ctx) {
+    int w = (int)bounds.width;
+    int h = (int)bounds.height;
+    if (!key || !paint || w <= 0 || h <= 0) return;
+
+    TmGraphSlot *g = find_slot(key);
+    g->last_use = ++s_use_clock;
+
+    if (!ensure_target(g, key, w, h) || g->gen != gen) {
+        BeginTextureMode(g->target);
+        ClearBackground(BLANK);
+        paint(ctx, w, h);
+        EndTextureMode();
+        g->gen = gen;
+    }
+
+    /* Render textures are stored bottom-up: flip with a negative height */
+    DrawTextureRec(g->target.texture, (Rectangle){ 0, 0, (float)w, (float)-h },
+                   (Vector2){ bounds.x, bounds.y }, WHITE);
+}
+
+void ui_graph_cache_free(void) {
+    for (int i = 0; i < TM_GRAPH_CACHE_MAX; i++) {
+        if (s_graphs[i].target.id != 0) UnloadRenderTexture(s_graphs[i].target);
+    }
+    memset(s_graphs, 0, sizeof(s_graphs));
+
+    free(s_points);
+    s_points     = NULL;
+    s_points_cap = 0;
+
+    free(s_spark);
+    free(s_strips);
+    s_spark  = NULL;
+    s_strips = NULL;
+    s_spark_len = s_spark_cap = 0;
+    s_strip_len = s_strip_cap = 0;
+}
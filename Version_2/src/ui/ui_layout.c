@@ -0,0 +1,143 @@
+/**
+ * @file ui_layout.c
+ * @brief Retained layout tree with dirty flags.
+ *
+ * Every fixed region of the window is a node positioned by insets from
+ * its parent. Rectangles are computed once per resize and cached in
+ * TmAppState.layout; scroll extents are recomputed only when a row count
+ * changes. Input hit-testing and the tab renderers read the cached
+ * rectangles, so a clean frame does no layout work at all.
+ */
+
+#include "../../include/tm_ui.h"
+
+/* -------------------------------------------------------------------------
+ * Node specification (parents precede children)
+ * ---------------------------------------------------------------------- */
+
+enum {
+    ANCHOR_RIGHT  = 1u << 0,    /* x measured from the parent's right edge  */
+    ANCHOR_BOTTOM = 1u << 1,    /* y measured from the parent's bottom edge */
+};
+
+/* A zero width/height stretches between the two insets on that axis. */
+typedef struct {
+    TmLayoutNode node;
+    TmLayoutNode parent;
+    int          left, top, right, bottom;
+    int          width, height;
+    unsigned     anchor;
+} TmNodeSpec;
+
+#define BTN_H TM_BUTTON_HEIGHT_PX
+#define SB_W  TM_SCROLLBAR_WIDTH_PX
+
+static const TmNodeSpec k_nodes[] = {
+    /* node                    parent          l    t    r    b     w    h   anchor */
+    { TM_NODE_TITLE_BAR,      TM_NODE_ROOT,    0,   0,   0,   0,    0,  40, 0 },
+    { TM_NODE_STATUS_BAR,     TM_NODE_ROOT,    0,   0,   0,   0,    0,  80, ANCHOR_BOTTOM },
+    { TM_NODE_RESIZE_GRIP,    TM_NODE_ROOT,    0,   0,   0,   0,
+      TM_RESIZE_BORDER_PX, TM_RESIZE_BORDER_PX, ANCHOR_RIGHT | ANCHOR_BOTTOM },
+    { TM_NODE_BTN_REFRESH,    TM_NODE_ROOT,    0,  10,  60,   0,  120, BTN_H, ANCHOR_RIGHT },
+    { TM_NODE_BTN_END_TASK,   TM_NODE_ROOT,    0,  10, 190,   0,  120, BTN_H, ANCHOR_RIGHT },
+    { TM_NODE_BTN_PIN,        TM_NODE_ROOT,    0,  10, 320,   0,  120, BTN_H, ANCHOR_RIGHT },
+    { TM_NODE_BTN_ENABLE,     TM_NODE_ROOT,    0,  10, 180,   0,  140, BTN_H, ANCHOR_RIGHT },
+    { TM_NODE_BTN_DISABLE,    TM_NODE_ROOT,    0,  10, 330,   0,  140, BTN_H, ANCHOR_RIGHT },
+    { TM_NODE_PROC_HEADER,    TM_NODE_ROOT,   10,  90,  20,   0,    0, TM_HEADER_HEIGHT_PX, 0 },
+    { TM_NODE_PROC_LIST,      TM_NODE_ROOT,   10, 120,  20,  80,    0,   0, 0 },
+    { TM_NODE_PROC_SCROLL,    TM_NODE_ROOT,    0, 120,   3,  80, SB_W,   0, ANCHOR_RIGHT },
+    { TM_NODE_PERF_PANEL,     TM_NODE_ROOT,   20, 120,  20,  80,    0,   0, 0 },
+    { TM_NODE_PERF_CORES,     TM_NODE_ROOT,   20, 540,  20,  20,    0,   0, 0 },
+    { TM_NODE_HISTORY_PANEL,  TM_NODE_ROOT,   20, 120,  10,  50,    0,   0, 0 },
+    { TM_NODE_HISTORY_HEADER, TM_NODE_HISTORY_PANEL, 0, 0, 0, 0,    0,  85, 0 },
+    { TM_NODE_HISTORY_LIST,   TM_NODE_ROOT,   20, 230,  10,  80,    0,   0, 0 },
+    { TM_NODE_HISTORY_SCROLL, TM_NODE_ROOT,    0, 230,   3,  80, SB_W,   0, ANCHOR_RIGHT },
+    { TM_NODE_STARTUP_PANEL,  TM_NODE_ROOT,   20, 120,  10,  50,    0,   0, 0 },
+    { TM_NODE_STARTUP_LIST,   TM_NODE_ROOT,   30, 220,  20,  80,    0,   0, 0 },
+    { TM_NODE_STARTUP_SCROLL, TM_NODE_ROOT,    0, 220,   3,  80, SB_W,   0, ANCHOR_RIGHT },
+    { TM_NODE_WATCH_LIST,     TM_NODE_ROOT,   20, 100,  20,  80,    0,   0, 0 },
+    { TM_NODE_HEATMAP,        TM_NODE_ROOT,  230, 135,  20,  85,    0,   0, 0 },
+};
+
+/* One axis: position and extent inside [p0, p0 + plen) */
+static void place(float p0, float plen, int lo, int hi, int len, bool from_end,
+                  float *pos, float *out_len) {
+    if (len > 0) {
+        *out_len = (float)len;
+        *pos     = from_end ? p0 + plen - (float)hi - (float)len : p0 + (float)lo;
+    } else {
+        *out_len = plen - (float)lo - (float)hi;
+        *pos     = p0 + (float)lo;
+        if (*out_len < 0.0f) *out_len = 0.0f;
+    }
+}
+
+static void compute_rects(TmLayout *l, int w, int h) {
+    l->rect[TM_NODE_ROOT] = (Rectangle){ 0, 0, (float)w, (float)h };
+    for (size_t i = 0; i < sizeof(k_nodes) / sizeof(k_nodes[0]); i++) {
+        const TmNodeSpec *n = &k_nodes[i];
+        Rectangle         p = l->rect[n->parent];
+        Rectangle        *r = &l->rect[n->node];
+        place(p.x, p.width,  n->left, n->right,  n->width,  n->anchor & ANCHOR_RIGHT,
+              &r->x, &r->width);
+        place(p.y, p.height, n->top,  n->bottom, n->height, n->anchor & ANCHOR_BOTTOM,
+              &r->y, &r->height);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Applying node geometry to widgets
+ * ---------------------------------------------------------------------- */
+
+static void apply_scrollbar(TmScrollBar *sb, Rectangle r) {
+    sb->bounds         = r;
+    sb->visible_height = (int)r.height;
+}
+
+static void apply_geometry(TmAppState *s) {
+    const TmLayout *l = &s->layout;
+    s->refresh_btn.bounds         = l->rect[TM_NODE_BTN_REFRESH];
+    s->end_task_btn.bounds        = l->rect[TM_NODE_BTN_END_TASK];
+    s->pin_btn.bounds             = l->rect[TM_NODE_BTN_PIN];
+    s->enable_startup_btn.bounds  = l->rect[TM_NODE_BTN_ENABLE];
+    s->disable_startup_btn.bounds = l->rect[TM_NODE_BTN_DISABLE];
+    apply_scrollbar(&s->process_scroll, l->rect[TM_NODE_PROC_SCROLL]);
+    apply_scrollbar(&s->startup_scroll, l->rect[TM_NODE_STARTUP_SCROLL]);
+    apply_scrollbar(&s->history_scroll, l->rect[TM_NODE_HISTORY_SCROLL]);
+}
+
+static void apply_extent(TmScrollBar *sb, int rows, int row_h) {
+    sb->content_height = rows * row_h;
+    int excess = sb->content_height - sb->visible_height;
+    sb->max_scroll = (excess > 0) ? excess : 0;
+    if (sb->scroll_pos > sb->max_scroll) sb->scroll_pos = sb->max_scroll;
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+void ui_layout_invalidate(TmAppState *s, uint32_t flags) {
+    if (s) s->layout.dirty |= flags;
+}
+
+void ui_layout_sync(TmAppState *s) {
+    if (!s || !s->layout.dirty) return;
+    TmLayout *l = &s->layout;
+
+    if (l->dirty & TM_LAYOUT_DIRTY_SIZE) {
+        compute_rects(l, s->screen_w, s->screen_h);
+        apply_geometry(s);
+        l->dirty |= TM_LAYOUT_DIRTY_CONTENT;    /* visible heights moved */
+    }
+    if (l->dirty & TM_LAYOUT_DIRTY_CONTENT) {
+        apply_extent(&s->process_scroll, s->process_count, TM_ROW_HEIGHT_PX);
+        apply_extent(&s->startup_scroll, s->startup_count, TM_STARTUP_ROW_PX);
+        apply_extent(&s->history_scroll, s->history_count, TM_HISTORY_ROW_PX);
+    }
+    l->dirty = 0;
+}
+
+Rectangle ui_layout_rect(const TmAppState *s, TmLayoutNode node) {
+    return s->layout.rect[node];
+}
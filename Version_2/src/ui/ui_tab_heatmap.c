@@ -0,0 +1,215 @@
+/**
+ * @file ui_tab_heatmap.c
+ * @brief Renders the Heatmap tab: top-N processes by recent CPU over time.
+ *
+ * The heatmap lives in a TM_PROC_HIST_LEN x TM_HEATMAP_ROWS texture used
+ * as a ring in x: refresh number n is texel column n % TM_PROC_HIST_LEN.
+ * A new refresh uploads one column. Only rows whose process changed are
+ * re-uploaded whole, from that process's history ring. The ring is drawn
+ * as two texture segments, oldest on the left.
+ */
+
+#include <string.h>
+
+#include "../../include/tm_ui.h"
+#include "../../include/tm_process.h"
+
+/* -------------------------------------------------------------------------
+ * Heatmap state (module-private, UI thread only)
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t pid;                 /* 0 marks an empty row */
+    char     name[TM_NAME_MAX];
+    float    score;
+} TmHeatRow;
+
+static Texture2D s_tex;
+static TmHeatRow s_rows[TM_HEATMAP_ROWS];
+static uint32_t  s_seq;           /* process_seq last uploaded */
+static Color     s_texels[TM_PROC_HIST_LEN];
+static const Color k_no_data = { 20, 20, 26, 255 };
+
+/* Mean CPU over the last TM_HEATMAP_RANK_SAMPLES refreshes */
+static float recent_cpu(const TmAppState *s, const TmProcess *p) {
+    float sum = 0.0f, v;
+    int   n   = 0;
+    for (int i = 0; i < TM_HEATMAP_RANK_SAMPLES; i++) {
+        if (!tm_process_history_cpu(s, p, s->process_seq - (uint32_t)i, &v)) break;
+        sum += v;
+        n++;
+    }
+    return n ? sum / (float)n : 0.0f;
+}
+
+/* Top TM_HEATMAP_ROWS processes by recent CPU, highest first */
+static int rank_processes(const TmAppState *s, const TmProcess **top, float *score) {
+    int n = 0;
+    for (int i = 0; i < s->process_count; i++) {
+        const TmProcess *p = tm_process_at(s, i);
+        float            v = recent_cpu(s, p);
+        if (n == TM_HEATMAP_ROWS && v <= score[n - 1]) continue;
+        int j = (n < TM_HEATMAP_ROWS) ? n++ : n - 1;
+        for (; j > 0 && score[j - 1] < v; j--) {
+            top[j]   = top[j - 1];
+            score[j] = score[j - 1];
+        }
+        top[j]   = p;
+        score[j] = v;
+    }
+    return n;
+}
+
+static bool ensure_texture(void) {
+    if (s_tex.id != 0) return true;
+    Image img = GenImageColor(TM_PROC_HIST_LEN, TM_HEATMAP_ROWS, k_no_data);
+    s_tex = LoadTextureFromImage(img);
+    UnloadImage(img);
+    return s_tex.id != 0;
+}
+
+/* Re-upload a whole row from its process ring (or blank it) */
+static void upload_row(const TmAppState *s, int row, const TmProcess *p) {
+    for (int x = 0; x < TM_PROC_HIST_LEN; x++) s_texels[x] = k_no_data;
+    for (uint32_t age = 0; p && age < TM_PROC_HIST_LEN; age++) {
+        uint32_t seq = s->process_seq - age;
+        float    v;
+        if (!tm_process_history_cpu(s, p, seq, &v)) break;
+        s_texels[seq % TM_PROC_HIST_LEN] = ui_heat_color(v);
+    }
+    UpdateTextureRec(s_tex, (Rectangle){ 0, (float)row, TM_PROC_HIST_LEN, 1 }, s_texels);
+}
+
+/* Keep surviving processes on their rows; newcomers take the freed rows */
+static void assign_rows(const TmProcess **top, const float *score, int n,
+                        const TmProcess **row_proc, bool *changed) {
+    bool     taken[TM_HEATMAP_ROWS] = { false };
+    uint32_t prev[TM_HEATMAP_ROWS];
+    for (int r = 0; r < TM_HEATMAP_ROWS; r++) {
+        prev[r]     = s_rows[r].pid;
+        row_proc[r] = NULL;
+        for (int i = 0; i < n && s_rows[r].pid; i++) {
+            if (top[i] && top[i]->pid == s_rows[r].pid) {
+                row_proc[r]     = top[i];
+                s_rows[r].score = score[i];
+                taken[i]        = true;
+                break;
+            }
+        }
+    }
+    int next = 0;
+    for (int r = 0; r < TM_HEATMAP_ROWS; r++) {
+        if (row_proc[r]) continue;
+        while (next < n && taken[next]) next++;
+        TmHeatRow *row = &s_rows[r];
+        if (next < n) {
+            row_proc[r] = top[next];
+            row->pid    = top[next]->pid;
+            row->score  = score[next];
+            memcpy(row->name, top[next]->name, sizeof(row->name));
+            next++;
+        } else {
+            row->pid = 0;
+        }
+    }
+    for (int r = 0; r < TM_HEATMAP_ROWS; r++) changed[r] = (s_rows[r].pid != prev[r]);
+}
+
+static void update_heatmap(const TmAppState *s) {
+    if (s->process_seq == s_seq || !ensure_texture()) return;
+
+    const TmProcess *top[TM_HEATMAP_ROWS];
+    float            score[TM_HEATMAP_ROWS];
+    const TmProcess *row_proc[TM_HEATMAP_ROWS];
+    bool             changed[TM_HEATMAP_ROWS];
+    int n = rank_processes(s, top, score);
+    assign_rows(top, score, n, row_proc, changed);
+
+    /* Refreshes missed while another tab was active: rebuild every row */
+    bool gap = (s->process_seq - s_seq != 1);
+    int  kept = 0;
+    for (int r = 0; r < TM_HEATMAP_ROWS; r++) {
+        if (gap || changed[r]) upload_row(s, r, row_proc[r]);
+        else                   kept++;
+    }
+    if (kept > 0) {
+        for (int r = 0; r < TM_HEATMAP_ROWS; r++) {
+            float v;
+            s_texels[r] = (row_proc[r] && tm_process_history_cpu(s, row_proc[r],
+                                                                   s->process_seq, &v))
+                          ? ui_heat_color(v) : k_no_data;
+        }
+        float x = (float)(s->process_seq % TM_PROC_HIST_LEN);
+        UpdateTextureRec(s_tex, (Rectangle){ x, 0, 1, TM_HEATMAP_ROWS }, s_texels);
+    }
+    s_seq = s->process_seq;
+}
+
+/* -------------------------------------------------------------------------
+ * Drawing
+ * ---------------------------------------------------------------------- */
+
+static void draw_ring_texture(const TmAppState *s, Rectangle area) {
+    /* Oldest column sits just after the newest one in the ring */
+    int   head  = (int)((s->process_seq + 1) % TM_PROC_HIST_LEN);
+    float col_w = area.width / (float)TM_PROC_HIST_LEN;
+    float older = (float)(TM_PROC_HIST_LEN - head);
+
+    DrawTexturePro(s_tex, (Rectangle){ (float)head, 0, older, TM_HEATMAP_ROWS },
+                   (Rectangle){ area.x, area.y, older * col_w, area.height },
+                   (Vector2){ 0, 0 }, 0.0f, WHITE);
+    if (head > 0) {
+        DrawTexturePro(s_tex, (Rectangle){ 0, 0, (float)head, TM_HEATMAP_ROWS },
+                       (Rectangle){ area.x + older * col_w, area.y,
+                                    (float)head * col_w, area.height },
+                       (Vector2){ 0, 0 }, 0.0f, WHITE);
+    }
+}
+
+static void draw_row_labels(int x, int y, int row_h) {
+    for (int r = 0; r < TM_HEATMAP_ROWS; r++) {
+        if (!s_rows[r].pid) continue;
+        const TmCachedText *t = ui_text_cell(s_rows[r].pid, TM_COL_HEAT_SCORE,
+                                             ui_text_gen(TM_EVENT_PROCESSES_CHANGED), 12,
+                                             "%.1f%%", s_rows[r].score);
+        int ty = y + r * row_h + (row_h - 12) / 2;
+        ui_text_draw(ui_text_fit(s_rows[r].name, 12, 140), x, ty, 12, TM_COLOR_TEXT);
+        ui_text_draw(t->text, x + 190 - t->width, ty, 12, TM_COLOR_SUBTLE);
+    }
+}
+
+/* -------------------------------------------------------------------------
+ * Public renderer
+ * ---------------------------------------------------------------------- */
+
+void ui_tab_heatmap_draw(const TmAppState *s) {
+    ui_text_draw("CPU Heatmap", 20, 100, 20, TM_COLOR_TEXT);
+    const TmCachedText *t = ui_text_cell(0, TM_COL_HEAT_CAPTION, 0, 14,
+                                         "Top %d processes by recent CPU, last %.0f s",
+                                         TM_HEATMAP_ROWS,
+                                         TM_PROC_HIST_LEN * TM_PROCESS_REFRESH_INTERVAL_S);
+    ui_text_draw(t->text, 180, 104, 14, TM_COLOR_SUBTLE);
+
+    update_heatmap(s);
+    if (s_tex.id == 0) return;
+
+    Rectangle area  = ui_layout_rect(s, TM_NODE_HEATMAP);
+    int       row_h = (int)area.height / TM_HEATMAP_ROWS;
+    if (row_h > 28) row_h = 28;
+    if (row_h < 4)  return;
+    area.height = (float)(row_h * TM_HEATMAP_ROWS);
+
+    draw_row_labels(20, (int)area.y, row_h);
+    draw_ring_texture(s, area);
+    DrawRectangleLinesEx(area, 1.0f, (Color){ 60, 60, 70, 255 });
+    ui_text_draw("older", (int)area.x, (int)(area.y + area.height) + 6, 12, TM_COLOR_SUBTLE);
+    ui_text_draw("now", (int)(area.x + area.width) - ui_text_width("now", 12),
+                 (int)(area.y + area.height) + 6, 12, TM_COLOR_SUBTLE);
+}
+
+void ui_heatmap_free(void) {
+    if (s_tex.id != 0) UnloadTexture(s_tex);
+    memset(&s_tex, 0, sizeof(s_tex));
+    memset(s_rows, 0, sizeof(s_rows));
+    s_seq = 0;
+}
@@ -5,51 +5,90 @@
 
 #include <stdio.h>
 #include "../../include/tm_ui.h"
+#include "../../include/tm_burst.h"
 
 /* -------------------------------------------------------------------------
  * Line-graph helper
  * ---------------------------------------------------------------------- */
 
-static void draw_line_graph(const float *history, int hist_len, int start_idx,
-                             int x, int y, int w, int h, Color line_col) {
-    DrawRectangle(x, y, w, h, (Color){ 15, 15, 20, 255 });
+typedef struct {
+    const float *history;
+    int          hist_len;
+    int          start_idx;
+    Color        line_col;
+} TmLineGraph;
+
+/* Painted into the graph's cached texture, origin at (0, 0) */
+static void paint_line_graph(const void *ctx, int w, int h) {
+    const TmLineGraph *g = ctx;
+    DrawRectangle(0, 0, w, h, (Color){ 15, 15, 20, 255 });
     /* Grid lines */
     for (int i = 1; i < 4; i++) {
-        DrawLine(x, y + i * h / 4, x + w, y + i * h / 4,
-                 (Color){ 40, 40, 50, 255 });
-    }
-    float x_step = (float)w / (float)(hist_len - 1);
-    for (int i = 0; i < hist_len - 1; i++) {
-        int   idx1 = (start_idx + i)     % hist_len;
-        int   idx2 = (start_idx + i + 1) % hist_len;
-        float y1   = (float)(y + h) - history[idx1] * (float)h / 100.0f;
-        float y2   = (float)(y + h) - history[idx2] * (float)h / 100.0f;
-        DrawLine((int)(x + i * x_step), (int)y1,
-                 (int)(x + (i + 1) * x_step), (int)y2, line_col);
+        DrawLine(0, i * h / 4, w, i * h / 4, (Color){ 40, 40, 50, 255 });
     }
-    DrawRectangleLines(x, y, w, h, (Color){ 60, 60, 70, 255 });
+    ui_graph_series_draw(g->history, g->hist_len, g->start_idx, g->hist_len, 100.0f,
+                         (Rectangle){ 0, 0, (float)w, (float)h }, g->line_col);
+    DrawRectangleLines(0, 0, w, h, (Color){ 60, 60, 70, 255 });
+}
+
+/* Repainted only when @p seq (the ring's sample count) changes */
+static void draw_line_graph(const float *history, int hist_len, int start_idx,
+                             uint32_t seq, int x, int y, int w, int h,
+                             Color line_col) {
+    TmLineGraph g = { history, hist_len, start_idx, line_col };
+    ui_graph_draw_cached(history, seq,
+                         (Rectangle){ (float)x, (float)y, (float)w, (float)h },
+                         paint_line_graph, &g);
 }
 
 /* -------------------------------------------------------------------------
  * Section renderers (each ~15 lines)
  * ---------------------------------------------------------------------- */
 
-static void draw_cpu_section(const TmAppState *s, int x, int y, int w) {
+/* While a burst capture is live, the CPU graph shows its high-res ring */
+static void draw_burst_graph(const TmBurst *b, int x, int y, int w, int h) {
+    const TmBurstRing *r = &b->ring;
+    bool full  = (r->count == TM_BURST_RING_LEN);
+    int  len   = full ? TM_BURST_RING_LEN : r->count;
+    int  start = full ? r->idx : 0;
+    if (len < 2) return;
+    draw_line_graph(r->cpu, len, start, r->seq, x, y, w, h, TM_COLOR_GPU);
+
     char buf[64];
-    DrawText("CPU", x, y, 20, TM_COLOR_TEXT);
-    snprintf(buf, sizeof(buf), "%.1f%%", s->perf.cpu_percent);
-    DrawText(buf, x + w - MeasureText(buf, 24), y, 24, TM_COLOR_TEXT);
+    snprintf(buf, sizeof(buf), "Burst capture: %d samples @ %.0f ms%s",
+             r->count, b->interval_s * 1000.0f, b->is_active ? " (recording)" : "");
+    ui_text_draw(buf, x + 6, y + 4, 12, TM_COLOR_TEXT);
+
+    if (b->pid) {
+        int last = (r->idx + TM_BURST_RING_LEN - 1) % TM_BURST_RING_LEN;
+        snprintf(buf, sizeof(buf), "PID %u RSS: %.1f MB", b->pid,
+                 (double)r->proc_rss[last] / (1024.0 * 1024.0));
+        ui_text_draw(buf, x + 6, y + 18, 12, TM_COLOR_TEXT);
+    }
+}
+
+static void draw_cpu_section(const TmAppState *s, int x, int y, int w) {
+    ui_text_draw("CPU", x, y, 20, TM_COLOR_TEXT);
+    const TmCachedText *t = ui_text_cell(0, TM_COL_PERF_CPU,
+                                         ui_text_gen(TM_EVENT_SYSTEM_SAMPLED), 24,
+                                         "%.1f%%", s->perf.cpu_percent);
+    ui_text_draw(t->text, x + w - t->width, y, 24, TM_COLOR_TEXT);
+    if (tm_burst_has_capture(&s->burst)) {
+        draw_burst_graph(&s->burst, x, y + 30, w, 120);
+        return;
+    }
     draw_line_graph(s->perf.cpu_history, TM_HIST_LEN, s->perf.cpu_idx,
-                    x, y + 30, w, 120, TM_COLOR_CPU);
+                    s->perf.cpu_seq, x, y + 30, w, 120, TM_COLOR_CPU);
 }
 
 static void draw_gpu_section(const TmAppState *s, int x, int y, int w) {
-    char buf[64];
-    DrawText("GPU", x, y, 20, TM_COLOR_TEXT);
-    snprintf(buf, sizeof(buf), "%.1f%%", s->perf.gpu_percent);
-    DrawText(buf, x + w - MeasureText(buf, 24), y, 24, TM_COLOR_TEXT);
+    ui_text_draw("GPU", x, y, 20, TM_COLOR_TEXT);
+    const TmCachedText *t = ui_text_cell(0, TM_COL_PERF_GPU,
+                                         ui_text_gen(TM_EVENT_SYSTEM_SAMPLED), 24,
+                                         "%.1f%%", s->perf.gpu_percent);
+    ui_text_draw(t->text, x + w - t->width, y, 24, TM_COLOR_TEXT);
     draw_line_graph(s->perf.gpu_history, TM_HIST_LEN, s->perf.gpu_idx,
-                    x, y + 30, w, 80, TM_COLOR_GPU);
+                    s->perf.gpu_seq, x, y + 30, w, 80, TM_COLOR_GPU);
 }
 
 static void draw_memory_section(const TmAppState *s, int x, int y, int w) {
@@ -60,9 +99,12 @@ static void draw_memory_section(const TmAppState *s, int x, int y, int w) {
                    : 0.0f;
     char buf[100];
 
-    DrawText("Memory", x, y, 20, TM_COLOR_TEXT);
-    snprintf(buf, sizeof(buf), "%.1f/%.1f GB (%.1f%%)", used, total, pct * 100.0f);
-    DrawText(buf, x + w - MeasureText(buf, 18), y, 18, TM_COLOR_TEXT);
+    ui_text_draw("Memory", x, y, 20, TM_COLOR_TEXT);
+    const TmCachedText *t = ui_text_cell(0, TM_COL_PERF_MEM,
+                                         ui_text_gen(TM_EVENT_SYSTEM_SAMPLED), 18,
+                                         "%.1f/%.1f GB (%.1f%%)", used, total,
+                                         pct * 100.0f);
+    ui_text_draw(t->text, x + w - t->width, y, 18, TM_COLOR_TEXT);
 
     DrawRectangle(x, y + 30, w, 30, (Color){ 40, 40, 50, 255 });
     DrawRectangle(x, y + 30, (int)((float)w * pct), 30, TM_COLOR_MEMORY);
@@ -70,62 +112,107 @@ static void draw_memory_section(const TmAppState *s, int x, int y, int w) {
 
     snprintf(buf, sizeof(buf), "%.1f GB",
              (double)s->perf.mem_used_kb / (1024.0 * 1024.0));
-    DrawText("In use:", x, y + 70, 14, TM_COLOR_TEXT);
-    DrawText(buf, x + 80, y + 70, 14, TM_COLOR_TEXT);
+    ui_text_draw("In use:", x, y + 70, 14, TM_COLOR_TEXT);
+    ui_text_draw(buf, x + 80, y + 70, 14, TM_COLOR_TEXT);
 
     snprintf(buf, sizeof(buf), "%.1f GB",
              (double)s->perf.mem_available_kb / (1024.0 * 1024.0));
-    DrawText("Available:", x, y + 90, 14, TM_COLOR_TEXT);
-    DrawText(buf, x + 80, y + 90, 14, TM_COLOR_TEXT);
+    ui_text_draw("Available:", x, y + 90, 14, TM_COLOR_TEXT);
+    ui_text_draw(buf, x + 80, y + 90, 14, TM_COLOR_TEXT);
 }
 
 static void draw_disk_section(const TmAppState *s, int x, int y, int w) {
     float pct = (s->perf.disk_total_kb > 0)
                 ? (float)s->perf.disk_used_kb / (float)s->perf.disk_total_kb
                 : 0.0f;
-    char buf[100];
 
-    DrawText("Disk", x, y, 20, TM_COLOR_TEXT);
-    snprintf(buf, sizeof(buf), "%.1f/%.1f GB (%.1f%%)",
-             (double)s->perf.disk_used_kb  / (1024.0 * 1024.0),
-             (double)s->perf.disk_total_kb / (1024.0 * 1024.0),
-             pct * 100.0f);
-    DrawText(buf, x + w - MeasureText(buf, 18), y, 18, TM_COLOR_TEXT);
+    ui_text_draw("Disk", x, y, 20, TM_COLOR_TEXT);
+    const TmCachedText *t = ui_text_cell(0, TM_COL_PERF_DISK,
+                                         ui_text_gen(TM_EVENT_SYSTEM_SAMPLED), 18,
+                                         "%.1f/%.1f GB (%.1f%%)",
+                                         (double)s->perf.disk_used_kb  / (1024.0 * 1024.0),
+                                         (double)s->perf.disk_total_kb / (1024.0 * 1024.0),
+                                         pct * 100.0f);
+    ui_text_draw(t->text, x + w - t->width, y, 18, TM_COLOR_TEXT);
 
     DrawRectangle(x, y + 30, w, 30, (Color){ 40, 40, 50, 255 });
     DrawRectangle(x, y + 30, (int)((float)w * pct), 30, TM_COLOR_DISK);
     DrawRectangleLines(x, y + 30, w, 30, (Color){ 80, 80, 90, 255 });
 }
 
+/* Painted into the panel's cached texture: one cell per core, as a small
+ * history graph when cells are large enough, else a heatmap tile. */
+static void paint_core_grid(const void *ctx, int w, int h) {
+    const TmPerfData *d = ctx;
+    int n    = d->core_count;
+    int cols = 1;
+    while (cols * cols * h < n * w) cols++;    /* near-square cells */
+    if (cols > n) cols = n;
+    int rows   = (n + cols - 1) / cols;
+    int cell_w = w / cols;
+    int cell_h = h / rows;
+    if (cell_w < 1 || cell_h < 1) return;
+    bool graphs = cell_w >= TM_CORE_GRAPH_MIN_W && cell_h >= TM_CORE_GRAPH_MIN_H;
+
+    DrawRectangle(0, 0, w, h, (Color){ 15, 15, 20, 255 });
+    for (int i = 0; i < n; i++) {
+        int       x    = (i % cols) * cell_w;
+        int       y    = (i / cols) * cell_h;
+        Rectangle cell = { (float)x + 1, (float)y + 1, (float)cell_w - 2, (float)cell_h - 2 };
+        if (!graphs) {
+            DrawRectangleRec(cell, ui_heat_color(d->core_percent[i]));
+            continue;
+        }
+        int len = (d->core_seq < TM_CORE_HIST_LEN) ? (int)d->core_seq : TM_CORE_HIST_LEN;
+        int start = (len == TM_CORE_HIST_LEN) ? d->core_idx : 0;
+        DrawRectangleRec(cell, (Color){ 25, 25, 32, 255 });
+        ui_graph_series_draw(d->core_history[i], TM_CORE_HIST_LEN, start, len, 100.0f,
+                             cell, ui_heat_color(d->core_percent[i]));
+    }
+}
+
+static void draw_cores_section(const TmAppState *s, int x, int y, int w, int h) {
+    const TmCachedText *t = ui_text_cell(0, TM_COL_PERF_CORES,
+                                         ui_text_gen(TM_EVENT_SYSTEM_SAMPLED), 20,
+                                         "Logical processors: %d", s->perf.core_count);
+    ui_text_draw(t->text, x, y, 20, TM_COLOR_TEXT);
+    if (h < 40 || s->perf.core_count <= 0) return;
+
+    ui_graph_draw_cached(s->perf.core_percent, s->perf.core_seq,
+                         (Rectangle){ (float)x, (float)(y + 30), (float)w, (float)(h - 30) },
+                         paint_core_grid, &s->perf);
+}
+
 static void draw_sysinfo_section(const TmAppState *s, int x, int y) {
-    uint32_t h   = s->perf.uptime_s / 3600;
-    uint32_t m   = (s->perf.uptime_s % 3600) / 60;
-    uint32_t sec = s->perf.uptime_s % 60;
+    uint32_t up  = (uint32_t)s->perf.uptime_s;
+    uint32_t h   = up / 3600;
+    uint32_t m   = (up % 3600) / 60;
+    uint32_t sec = up % 60;
     char buf[100];
 
-    DrawText("System Information", x, y, 20, TM_COLOR_TEXT);
+    ui_text_draw("System Information", x, y, 20, TM_COLOR_TEXT);
     y += 40;
 
     snprintf(buf, sizeof(buf), "Up time: %u:%02u:%02u", h, m, sec);
-    DrawText(buf, x, y, 16, TM_COLOR_SUBTLE);
+    ui_text_draw(buf, x, y, 16, TM_COLOR_SUBTLE);
 
     snprintf(buf, sizeof(buf), "Processes: %d", s->perf.process_count);
-    DrawText(buf, x, y + 25, 16, TM_COLOR_SUBTLE);
+    ui_text_draw(buf, x, y + 25, 16, TM_COLOR_SUBTLE);
 
     snprintf(buf, sizeof(buf), "Threads: %d", s->perf.thread_count);
-    DrawText(buf, x, y + 50, 16, TM_COLOR_SUBTLE);
+    ui_text_draw(buf, x, y + 50, 16, TM_COLOR_SUBTLE);
 
     snprintf(buf, sizeof(buf), "Handles: %d",
              s->perf.process_count * 50 + 1234);
-    DrawText(buf, x + 230, y, 16, TM_COLOR_SUBTLE);
+    ui_text_draw(buf, x + 230, y, 16, TM_COLOR_SUBTLE);
 
     snprintf(buf, sizeof(buf), "Physical Memory: %.1f GB",
              (double)s->perf.mem_total_kb / (1024.0 * 1024.0));
-    DrawText(buf, x + 230, y + 25, 16, TM_COLOR_SUBTLE);
+    ui_text_draw(buf, x + 230, y + 25, 16, TM_COLOR_SUBTLE);
 
     snprintf(buf, sizeof(buf), "Disk Capacity: %.1f GB",
              (double)s->perf.disk_total_kb / (1024.0 * 1024.0));
-    DrawText(buf, x + 480, y, 16, TM_COLOR_SUBTLE);
+    ui_text_draw(buf, x + 480, y, 16, TM_COLOR_SUBTLE);
 }
 
 /* -------------------------------------------------------------------------
@@ -133,12 +220,15 @@ static void draw_sysinfo_section(const TmAppState *s, int x, int y) {
  * ---------------------------------------------------------------------- */
 
 void ui_tab_perf_draw(const TmAppState *s) {
-    int half_w      = (s->screen_w - 60) / 2;
-    int right_x     = 20 + half_w + 20;
+    Rectangle panel   = ui_layout_rect(s, TM_NODE_PERF_PANEL);
+    Rectangle cores   = ui_layout_rect(s, TM_NODE_PERF_CORES);
+    int       half_w  = ((int)panel.width - 20) / 2;
+    int       right_x = 20 + half_w + 20;
 
     draw_cpu_section(s,    20,      120, half_w);
     draw_memory_section(s, right_x, 120, half_w);
     draw_gpu_section(s,    20,      300, half_w);
     draw_disk_section(s,   right_x, 300, half_w);
     draw_sysinfo_section(s, 20,     430);
+    draw_cores_section(s, (int)cores.x, (int)cores.y, (int)cores.width, (int)cores.height);
 }
@@ -3,97 +3,144 @@
  * @brief Renders the Processes tab content.
  */
 
-#include <stdio.h>
 #include "../../include/tm_ui.h"
+#include "../../include/tm_process.h"
+#include "../../include/tm_watch.h"
 
 /* -------------------------------------------------------------------------
  * Internal helpers
  * ---------------------------------------------------------------------- */
 
-static void draw_column_headers(int content_w) {
-    DrawRectangle(10, 90, content_w, TM_HEADER_HEIGHT_PX, TM_COLOR_HEADER);
-    DrawText("Name",   20,  95, 16, TM_COLOR_TEXT);
-    DrawText("PID",   300,  95, 16, TM_COLOR_TEXT);
-    DrawText("CPU",   400,  95, 16, TM_COLOR_TEXT);
-    DrawText("Memory",500,  95, 16, TM_COLOR_TEXT);
+static void draw_column_headers(Rectangle header) {
+    DrawRectangleRec(header, TM_COLOR_HEADER);
+    ui_text_draw("Name",   20,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("PID",   300,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("CPU",   400,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("Trend", 460,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("Memory",540,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("PSS",   650,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("FDs",   750,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("I/O",   810,  95, 16, TM_COLOR_TEXT);
+    ui_text_draw("Command",910, 95, 16, TM_COLOR_TEXT);
 }
 
 static Color cpu_value_color(float cpu) {
     return (cpu > 50.0f) ? (Color){ 255, 100, 100, 255 } : TM_COLOR_SUBTLE;
 }
 
+/* Expensive columns: placeholder until the collector has fetched the row */
+static void draw_detail_columns(const TmProcess *proc, int y_pos) {
+    const TmProcessDetail *d = &proc->detail;
+    if (!d->is_valid) {
+        ui_text_draw("...", 650, y_pos + 8, 14, TM_COLOR_SUBTLE);
+        ui_text_draw("...", 750, y_pos + 8, 14, TM_COLOR_SUBTLE);
+        ui_text_draw("...", 810, y_pos + 8, 14, TM_COLOR_SUBTLE);
+        return;
+    }
+    uint32_t gen = ui_text_gen(TM_EVENT_PROCESSES_CHANGED | TM_EVENT_DETAILS_FETCHED);
+    const TmCachedText *t;
+
+    t = ui_text_cell(proc->pid, TM_COL_PROC_PSS, gen, 14, "%.1f MB",
+                     (double)d->pss_kb / 1024.0);
+    ui_text_draw(t->text, 650, y_pos + 8, 14, TM_COLOR_SUBTLE);
+
+    t = (d->fd_count >= 0)
+        ? ui_text_cell(proc->pid, TM_COL_PROC_FDS, gen, 14, "%d", d->fd_count)
+        : ui_text_cell(proc->pid, TM_COL_PROC_FDS, gen, 14, "-");
+    ui_text_draw(t->text, 750, y_pos + 8, 14, TM_COLOR_SUBTLE);
+
+    t = ui_text_cell(proc->pid, TM_COL_PROC_IO, gen, 14, "%.1f MB",
+                     (double)d->io_bytes / (1024.0 * 1024.0));
+    ui_text_draw(t->text, 810, y_pos + 8, 14, TM_COLOR_SUBTLE);
+
+    /* Long command lines are cut to keep clear of the scrollbar */
+    t = ui_text_cell(proc->pid, TM_COL_PROC_CMD, gen, 14, "%.36s", d->cmdline);
+    ui_text_draw(t->text, 910, y_pos + 8, 14, TM_COLOR_SUBTLE);
+}
+
+/* Queue the last TM_PROC_HIST_LEN interval CPU values; drawn in one batch after the rows */
+static void queue_sparkline(const TmAppState *s, const TmProcess *proc, int y_pos) {
+    float vals[TM_PROC_HIST_LEN];
+    int   n = 0;
+    for (int age = TM_PROC_HIST_LEN - 1; age >= 0; age--) {
+        if (tm_process_history_cpu(s, proc, s->process_seq - (uint32_t)age, &vals[n]))
+            n++;
+    }
+    ui_graph_spark_queue(vals, n, TM_PROC_HIST_LEN, 100.0f,
+                         (Rectangle){ 460, (float)(y_pos + 7), 64, 16 });
+}
+
 static void draw_process_row(const TmProcess *proc, int y_pos,
-                              int content_w, int row_index) {
+                              int content_w, int row_index, bool pinned) {
     Color row_col = proc->is_selected
                     ? TM_COLOR_SELECTED
                     : ((row_index % 2 == 0) ? TM_COLOR_ROW1 : TM_COLOR_ROW2);
 
     DrawRectangle(10, y_pos, content_w, TM_ROW_HEIGHT_PX, row_col);
-    DrawRectangle(20, y_pos + 8, 12, 12, TM_COLOR_ACCENT);
-    DrawText(proc->name, 37, y_pos + 8, 14, TM_COLOR_TEXT);
+    /* Pinned processes get a highlighted icon square */
+    DrawRectangle(20, y_pos + 8, 12, 12, pinned ? TM_COLOR_PINNED : TM_COLOR_ACCENT);
+    ui_text_draw(ui_text_fit(proc->name, 14, 255), 37, y_pos + 8, 14, TM_COLOR_TEXT);
 
-    char buf[32];
-    snprintf(buf, sizeof(buf), "%u", proc->pid);
-    DrawText(buf, 300, y_pos + 8, 14, TM_COLOR_SUBTLE);
+    uint32_t gen = ui_text_gen(TM_EVENT_PROCESSES_CHANGED);
+    const TmCachedText *t;
 
-    snprintf(buf, sizeof(buf), "%.1f%%", proc->cpu_percent);
-    DrawText(buf, 400, y_pos + 8, 14, cpu_value_color(proc->cpu_percent));
+    t = ui_text_cell(proc->pid, TM_COL_PROC_PID, 0, 14, "%u", proc->pid);
+    ui_text_draw(t->text, 300, y_pos + 8, 14, TM_COLOR_SUBTLE);
 
-    snprintf(buf, sizeof(buf), "%.1f MB",
-             (double)proc->memory_bytes / (1024.0 * 1024.0));
-    DrawText(buf, 500, y_pos + 8, 14, TM_COLOR_SUBTLE);
-}
+    /* Same per-interval value as the newest point of the Trend sparkline */
+    t = ui_text_cell(proc->pid, TM_COL_PROC_CPU, gen, 14, "%.1f%%", proc->cpu_interval);
+    ui_text_draw(t->text, 400, y_pos + 8, 14, cpu_value_color(proc->cpu_interval));
 
-static void draw_process_rows(const TmAppState *s, int start_y,
-                               int list_h, int content_w) {
-    int scroll_px = s->process_scroll.scroll_pos;
-    int skip      = scroll_px / TM_ROW_HEIGHT_PX;
-    int row_off   = scroll_px % TM_ROW_HEIGHT_PX;
-    int max_vis   = list_h / TM_ROW_HEIGHT_PX + 1;
-
-    const TmProcess *cur = s->process_list;
-    int abs_idx  = 0;
-    int vis_idx  = 0;
-
-    /* Skip rows above the viewport */
-    while (cur && abs_idx < skip) {
-        cur = cur->next;
-        abs_idx++;
-    }
+    t = ui_text_cell(proc->pid, TM_COL_PROC_MEM, gen, 14, "%.1f MB",
+                     (double)proc->memory_bytes / (1024.0 * 1024.0));
+    ui_text_draw(t->text, 540, y_pos + 8, 14, TM_COLOR_SUBTLE);
 
-    while (cur && vis_idx < max_vis) {
-        int y = start_y + vis_idx * TM_ROW_HEIGHT_PX - row_off;
-        if (y >= start_y && y < start_y + list_h) {
-            draw_process_row(cur, y, content_w, abs_idx);
-        }
-        cur = cur->next;
-        abs_idx++;
-        vis_idx++;
-    }
+    draw_detail_columns(proc, y_pos);
+}
+
+static void draw_process_list_row(const TmAppState *s, int index, int y, int width) {
+    const TmProcess *proc = tm_process_at(s, index);
+    if (!proc) return;
+    draw_process_row(proc, y, width, index, tm_watch_is_pinned(s, proc->pid));
+    queue_sparkline(s, proc, y);
 }
 
 static void draw_stats_bar(const TmAppState *s) {
-    DrawRectangle(0, s->screen_h - 80, s->screen_w, 80, TM_COLOR_HEADER);
-    char buf[256];
-    snprintf(buf, sizeof(buf),
-             "Processes: %d | CPU Usage: %.1f%% | Memory: %.1f/%.1f GB",
-             s->process_count, s->perf.cpu_percent,
-             (double)s->perf.mem_used_kb  / (1024.0 * 1024.0),
-             (double)s->perf.mem_total_kb / (1024.0 * 1024.0));
-    DrawText(buf, 15, s->screen_h - 65, 14, TM_COLOR_SUBTLE);
+    Rectangle bar = ui_layout_rect(s, TM_NODE_STATUS_BAR);
+    DrawRectangleRec(bar, TM_COLOR_HEADER);
+    const TmCachedText *t = ui_text_cell(
+        0, TM_COL_PROC_STATS,
+        ui_text_gen(TM_EVENT_PROCESSES_CHANGED | TM_EVENT_SYSTEM_SAMPLED), 14,
+        "Processes: %d | CPU Usage: %.1f%% | Memory: %.1f/%.1f GB",
+        s->process_count, s->perf.cpu_percent,
+        (double)s->perf.mem_used_kb  / (1024.0 * 1024.0),
+        (double)s->perf.mem_total_kb / (1024.0 * 1024.0));
+    ui_text_draw(t->text, 15, (int)bar.y + 15, 14, TM_COLOR_SUBTLE);
 }
 
 /* -------------------------------------------------------------------------
  * Public renderer
  * ---------------------------------------------------------------------- */
 
-void ui_tab_process_draw(const TmAppState *s) {
-    int start_y    = 120;
-    int content_w  = s->screen_w - 30;
-    int list_h     = s->screen_h - 200;
+TmVList ui_process_vlist(const TmAppState *s) {
+    return ui_vlist_make(ui_layout_rect(s, TM_NODE_PROC_LIST), &s->process_scroll,
+                         TM_ROW_HEIGHT_PX, s->process_count);
+}
 
-    draw_column_headers(content_w);
-    draw_process_rows(s, start_y, list_h, content_w);
+void ui_process_visible_range(const TmAppState *s, int *first, int *count) {
+    TmVList v = ui_process_vlist(s);
+    ui_vlist_range(&v, first, count);
+}
+
+void ui_tab_process_draw(const TmAppState *s) {
+    TmVList rows = ui_process_vlist(s);
+
+    draw_column_headers(ui_layout_rect(s, TM_NODE_PROC_HEADER));
+    ui_vlist_draw(&rows, s, draw_process_list_row);
+    BeginScissorMode((int)rows.area.x, (int)rows.area.y,
+                     (int)rows.area.width, (int)rows.area.height);
+    ui_graph_spark_flush(TM_COLOR_CPU);
+    EndScissorMode();
     ui_scrollbar_draw(&s->process_scroll);
     draw_stats_bar(s);
 }
@@ -0,0 +1,77 @@
+/**
+ * @file ui_tab_watch.c
+ * @brief Renders the Watch tab: one panel per pinned process.
+ */
+
+#include <stdio.h>
+#include "../../include/tm_ui.h"
+
+/* -------------------------------------------------------------------------
+ * Internal helpers
+ * ---------------------------------------------------------------------- */
+
+/* Auto-scaled ring graph; the label shows the latest value and the scale */
+static void draw_ring_graph(const TmWatchEntry *e, const float *ring,
+                             const char *label, const char *unit,
+                             int x, int y, int w, int h, Color col) {
+    DrawRectangle(x, y, w, h, (Color){ 15, 15, 20, 255 });
+
+    int   start = (e->count == TM_WATCH_HIST_LEN) ? e->idx : 0;
+    float max_v = 1.0f;
+    for (int i = 0; i < e->count; i++) {
+        if (ring[i] > max_v) max_v = ring[i];
+    }
+
+    ui_graph_series_draw(ring, TM_WATCH_HIST_LEN, start, e->count, max_v,
+                         (Rectangle){ (float)x, (float)y, (float)w, (float)h }, col);
+    DrawRectangleLines(x, y, w, h, (Color){ 60, 60, 70, 255 });
+
+    char  buf[64];
+    float last = e->count ? ring[(e->idx + TM_WATCH_HIST_LEN - 1) % TM_WATCH_HIST_LEN]
+                          : 0.0f;
+    snprintf(buf, sizeof(buf), "%s %.1f %s (max %.1f)", label, last, unit, max_v);
+    ui_text_draw(buf, x + 4, y + 3, 12, TM_COLOR_TEXT);
+}
+
+static void draw_watch_panel(const TmWatchEntry *e, int x, int y, int w) {
+    int h = TM_WATCH_PANEL_PX - 10;
+    DrawRectangle(x, y, w, h, TM_COLOR_HEADER);
+
+    char buf[96];
+    snprintf(buf, sizeof(buf), "%s  (PID %u)", e->name, e->pid);
+    ui_text_draw(buf, x + 10, y + 6, 16, TM_COLOR_TEXT);
+    ui_text_draw(e->is_alive ? "running" : "exited - waiting for restart",
+                 x + 10, y + 26, 12,
+                 e->is_alive ? TM_COLOR_ENABLED : TM_COLOR_DISABLED);
+    snprintf(buf, sizeof(buf), "every %.0f ms", e->interval_s * 1000.0f);
+    ui_text_draw(buf, x + 10, y + 42, 12, TM_COLOR_SUBTLE);
+
+    int gx = x + 220;
+    int gw = (w - 230 - 20) / 3;
+    int gh = h - 12;
+    draw_ring_graph(e, e->cpu,     "CPU", "%",    gx,                y + 6, gw, gh,
+                    TM_COLOR_CPU);
+    draw_ring_graph(e, e->rss_mb,  "RSS", "MB",   gx + gw + 10,      y + 6, gw, gh,
+                    TM_COLOR_MEMORY);
+    draw_ring_graph(e, e->io_kbps, "I/O", "KB/s", gx + 2 * (gw + 10), y + 6, gw, gh,
+                    TM_COLOR_DISK);
+}
+
+/* -------------------------------------------------------------------------
+ * Public renderer
+ * ---------------------------------------------------------------------- */
+
+void ui_tab_watch_draw(const TmAppState *s) {
+    Rectangle list = ui_layout_rect(s, TM_NODE_WATCH_LIST);
+
+    if (s->watch.count == 0) {
+        ui_text_draw("No pinned processes", 20, 120, 20, TM_COLOR_TEXT);
+        ui_text_draw("Select a process on the Processes tab and press P to pin it",
+                     20, 150, 16, TM_COLOR_SUBTLE);
+        return;
+    }
+    for (int i = 0; i < s->watch.count; i++) {
+        draw_watch_panel(&s->watch.entries[i], (int)list.x,
+                         (int)list.y + i * TM_WATCH_PANEL_PX, (int)list.width);
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file ui_text.c
+ * @brief Text rendering from one glyph atlas, with cached measurements.
+ *
+ * All UI text uses the default font, whose glyphs share one atlas texture
+ * (as does raylib's shape texture), so rlgl merges every glyph quad and
+ * rectangle of a frame into one batch until a render-texture blit or a
+ * scissor change. Glyph metrics for printable ASCII are resolved once at
+ * init into a lookup table, replacing the per-glyph codepoint search done
+ * by DrawText/MeasureText. Widths of repeated labels and ellipsized names
+ * are cached, keyed by their content.
+ */
+
+#include <string.h>
+
+#include "../../include/tm_ui.h"
+
+#define TEXT_GLYPH_FIRST  32
+#define TEXT_GLYPH_COUNT  95     /* ' ' .. '~' */
+#define TEXT_BASE_SIZE    10     /* raylib's default font size */
+#define TEXT_ELLIPSIS     "..."
+
+/* -------------------------------------------------------------------------
+ * Atlas and caches (module-private, UI thread only)
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    Rectangle src;          /* atlas rectangle including padding */
+    float     offset_x;
+    float     offset_y;
+    float     advance;      /* base-size units */
+} TmGlyph;
+
+typedef struct {
+    int  size;              /* 0 marks an empty slot */
+    int  width;
+    char text[TM_TEXT_CELL_MAX];
+} TmWidthSlot;
+
+typedef struct {
+    int  size;
+    int  max_w;
+    char src[TM_NAME_MAX];
+    char out[TM_NAME_MAX];
+} TmFitSlot;
+
+static Font        s_font;
+static TmGlyph     s_glyphs[TEXT_GLYPH_COUNT];
+static float       s_pad;
+static TmWidthSlot s_widths[1u << TM_TEXT_WIDTH_BITS];
+static TmFitSlot   s_fits[1u << TM_TEXT_FIT_BITS];
+
+/* Unknown bytes (UTF-8 included) render as '?', like the default font */
+static const TmGlyph *glyph_for(unsigned char c) {
+    if (c < TEXT_GLYPH_FIRST || c >= TEXT_GLYPH_FIRST + TEXT_GLYPH_COUNT) c = '?';
+    return &s_glyphs[c - TEXT_GLYPH_FIRST];
+}
+
+/* DrawText() semantics: sizes below the base size are clamped */
+static int effective_size(int size) {
+    return (size < TEXT_BASE_SIZE) ? TEXT_BASE_SIZE : size;
+}
+
+static float spacing_for(int size) {
+    return (float)(size / TEXT_BASE_SIZE);
+}
+
+static uint32_t hash_text(const char *text, int size, int bits) {
+    uint32_t h = 2166136261u ^ (uint32_t)size;          /* FNV-1a */
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        h = (h ^ *p) * 16777619u;
+    }
+    return h >> (32 - bits);
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+void ui_text_init(void) {
+    s_font = GetFontDefault();
+    s_pad  = (float)s_font.glyphPadding;
+    for (int i = 0; i < TEXT_GLYPH_COUNT; i++) {
+        int       idx = GetGlyphIndex(s_font, TEXT_GLYPH_FIRST + i);
+        Rectangle r   = s_font.recs[idx];
+        GlyphInfo gi  = s_font.glyphs[idx];
+        s_glyphs[i] = (TmGlyph){
+            .src      = { r.x - s_pad, r.y - s_pad, r.width + 2 * s_pad, r.height + 2 * s_pad },
+            .offset_x = (float)gi.offsetX - s_pad,
+            .offset_y = (float)gi.offsetY - s_pad,
+            .advance  = gi.advanceX ? (float)gi.advanceX : r.width,
+        };
+    }
+    memset(s_widths, 0, sizeof(s_widths));
+    memset(s_fits,   0, sizeof(s_fits));
+}
+
+void ui_text_draw(const char *text, int x, int y, int size, Color col) {
+    if (!text || s_font.texture.id == 0) return;
+    size = effective_size(size);
+    float scale   = (float)size / (float)s_font.baseSize;
+    float spacing = spacing_for(size);
+    float pen     = (float)x;
+
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        const TmGlyph *g = glyph_for(*p);
+        if (*p != ' ') {
+            Rectangle dst = { pen + g->offset_x * scale, (float)y + g->offset_y * scale,
+                              g->src.width * scale, g->src.height * scale };
+            DrawTexturePro(s_font.texture, g->src, dst, (Vector2){ 0, 0 }, 0.0f, col);
+        }
+        pen += g->advance * scale + spacing;
+    }
+}
+
+int ui_text_measure(const char *text, int size) {
+    if (!text || !*text) return 0;
+    size = effective_size(size);
+    float scale = (float)size / (float)s_font.baseSize;
+    float w     = 0.0f;
+    int   n     = 0;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++, n++) {
+        w += glyph_for(*p)->advance;
+    }
+    return (int)(w * scale + (float)(n - 1) * spacing_for(size));
+}
+
+int ui_text_width(const char *label, int size) {
+    if (!label) return 0;
+    if (strlen(label) >= TM_TEXT_CELL_MAX) return ui_text_measure(label, size);
+
+    TmWidthSlot *slot = &s_widths[hash_text(label, size, TM_TEXT_WIDTH_BITS)];
+    if (slot->size == size && strcmp(slot->text, label) == 0) return slot->width;
+
+    strcpy(slot->text, label);
+    slot->size  = size;
+    slot->width = ui_text_measure(label, size);
+    return slot->width;
+}
+
+const char *ui_text_fit(const char *text, int size, int max_w) {
+    if (!text) return "";
+    if (strlen(text) >= TM_NAME_MAX) return text;
+
+    TmFitSlot *slot = &s_fits[hash_text(text, size ^ (max_w << 8), TM_TEXT_FIT_BITS)];
+    if (slot->size == size && slot->max_w == max_w && strcmp(slot->src, text) == 0)
+        return slot->out;
+
+    strcpy(slot->src, text);
+    slot->size  = size;
+    slot->max_w = max_w;
+
+    if (ui_text_measure(text, size) <= max_w) {
+        strcpy(slot->out, text);
+        return slot->out;
+    }
+
+    /* Longest prefix that still fits with the ellipsis appended */
+    int   fs      = effective_size(size);
+    float scale   = (float)fs / (float)s_font.baseSize;
+    float spacing = spacing_for(fs);
+    float budget  = (float)max_w - (float)ui_text_measure(TEXT_ELLIPSIS, size) - spacing;
+    float w       = 0.0f;
+    int   len     = 0;
+    while (text[len]) {
+        float adv = glyph_for((unsigned char)text[len])->advance * scale;
+        if (w + adv > budget) break;
+        w += adv + spacing;
+        len++;
+    }
+    memcpy(slot->out, text, (size_t)len);
+    memcpy(slot->out + len, TEXT_ELLIPSIS, sizeof(TEXT_ELLIPSIS));
+    return slot->out;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file ui_text_cache.c
+ * @brief Direct-mapped cache of formatted and measured cell text.
+ *
+ * Table values change at most once per sample, but rows are drawn 60
+ * times a second. Cells are keyed by (row id, column) and tagged with
+ * the generation of the data they show; generations advance only when
+ * the event bus reports a new sample, so steady-state frames skip every
+ * snprintf and measurement.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "../../include/tm_ui.h"
+#include "../../include/tm_event.h"
+
+#define TEXT_CACHE_SLOTS (1u << TM_TEXT_CACHE_BITS)
+
+/* -------------------------------------------------------------------------
+ * Cache storage (module-private)
+ * ---------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t     row_id;
+    uint32_t     column;     /* TM_COL_NONE marks an empty slot */
+    uint32_t     gen;
+    int          font_size;
+    TmCachedText cell;
+} TmTextSlot;
+
+static TmTextSlot s_slots[TEXT_CACHE_SLOTS];
+static uint32_t   s_gen[32];  /* one counter per TmEventType bit */
+
+static void on_sample_published(const TmEvent *ev, void *user) {
+    (void)user;
+    for (int b = 0; b < 32; b++) {
+        if (ev->types & (1u << b)) s_gen[b]++;
+    }
+}
+
+static uint32_t slot_index(uint32_t row_id, TmTextColumn col) {
+    uint32_t key = row_id * 64u + (uint32_t)col;
+    return (key * 2654435761u) >> (32 - TM_TEXT_CACHE_BITS);  /* Knuth */
+}
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+void ui_text_cache_init(void) {
+    tm_event_subscribe(TM_EVENT_DATA_ALL, TM_DISPATCH_UI, on_sample_published, NULL, NULL);
+}
+
+uint32_t ui_text_gen(uint32_t types) {
+    uint32_t gen = 0;
+    for (int b = 0; b < 32; b++) {
+        if (types & (1u << b)) gen += s_gen[b];
+    }
+    return gen;
+}
+
+const TmCachedText *ui_text_cell(uint32_t row_id, TmTextColumn col, uint32_t gen,
+                                 int font_size, const char *fmt, ...) {
+    TmTextSlot *slot = &s_slots[slot_index(row_id, col)];
+    if (slot->column == (uint32_t)col && slot->row_id == row_id
+        && slot->gen == gen && slot->font_size == font_size)
+        return &slot->cell;
+
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(slot->cell.text, sizeof(slot->cell.text), fmt, ap);
+    va_end(ap);
+
+    slot->row_id     = row_id;
+    slot->column     = (uint32_t)col;
+    slot->gen        = gen;
+    slot->font_size  = font_size;
+    slot->cell.width = ui_text_measure(slot->cell.text, font_size);
+    return &slot->cell;
+}
@@ -19,3 +19,17 @@ const Color TM_COLOR_DISK     = { 155,  89, 182,  255 };
 const Color TM_COLOR_GPU      = { 231,  76,  60,  255 };
 const Color TM_COLOR_ENABLED  = {  46, 204, 113,  255 };
 const Color TM_COLOR_DISABLED = { 231,  76,  60,  255 };
+const Color TM_COLOR_PINNED   = { 241, 196,  15,  255 };
+
+Color ui_heat_color(float pct) {
+    float t = pct / 100.0f;
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    /* CPU green through pinned yellow to GPU red */
+    Color a = (t < 0.5f) ? TM_COLOR_CPU    : TM_COLOR_PINNED;
+    Color b = (t < 0.5f) ? TM_COLOR_PINNED : TM_COLOR_GPU;
+    float u = (t < 0.5f) ? t * 2.0f : (t - 0.5f) * 2.0f;
+    return (Color){ (unsigned char)(a.r + (b.r - a.r) * u),
+                    (unsigned char)(a.g + (b.g - a.g) * u),
+                    (unsigned char)(a.b + (b.b - a.b) * u), 255 };
+}
@@ -0,0 +1,53 @@
+/**
+ * @file ui_vlist.c
+ * @brief Virtualized fixed-height lists.
+ *
+ * Row i sits at i * row_h, so the visible window is computed from the
+ * scroll offset alone and rows are fetched through the core index arrays.
+ * A frame costs O(visible rows) however long the list is.
+ */
+
+#include "../../include/tm_ui.h"
+
+/* -------------------------------------------------------------------------
+ * Public API
+ * ---------------------------------------------------------------------- */
+
+TmVList ui_vlist_make(Rectangle area, const TmScrollBar *sb, int row_h, int count) {
+    TmVList v;
+    v.area      = area;
+    v.row_h     = (row_h > 0) ? row_h : 1;
+    v.count     = count;
+    v.scroll_px = sb->scroll_pos;
+    return v;
+}
+
+void ui_vlist_range(const TmVList *v, int *first, int *count) {
+    int lo = v->scroll_px / v->row_h - TM_VLIST_OVERSCAN;
+    int hi = (v->scroll_px + (int)v->area.height) / v->row_h + 1 + TM_VLIST_OVERSCAN;
+    if (lo < 0)        lo = 0;
+    if (hi > v->count) hi = v->count;
+    *first = lo;
+    *count = (hi > lo) ? hi - lo : 0;
+}
+
+int ui_vlist_row_at(const TmVList *v, Vector2 point) {
+    if (!CheckCollisionPointRec(point, v->area)) return -1;
+    int idx = ((int)(point.y - v->area.y) + v->scroll_px) / v->row_h;
+    return (idx >= 0 && idx < v->count) ? idx : -1;
+}
+
+void ui_vlist_draw(const TmVList *v, const TmAppState *s, TmVListRowFn row) {
+    int first, n;
+    ui_vlist_range(v, &first, &n);
+    if (n == 0) return;
+
+    /* Partial rows at either edge are clipped rather than skipped */
+    BeginScissorMode((int)v->area.x, (int)v->area.y,
+                     (int)v->area.width, (int)v->area.height);
+    int top = (int)v->area.y - v->scroll_px;
+    for (int i = first; i < first + n; i++) {
+        row(s, i, top + i * v->row_h, (int)v->area.width);
+    }
+    EndScissorMode();
+}
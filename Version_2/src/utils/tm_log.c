@@ -4,11 +4,14 @@
  */
 
 #include <stdarg.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <time.h>
 
 #include "../../include/tm_log.h"
 
+static bool s_stderr_only = false;
+
 static const char *level_label(TmLogLevel level) {
     switch (level) {
         case TM_LOG_DEBUG: return "DEBUG";
@@ -27,7 +30,7 @@ void tm_log(TmLogLevel level, const char *fmt, ...) {
     char ts[20];
     strftime(ts, sizeof(ts), "%H:%M:%S", t);
 
-    FILE *sink = (level >= TM_LOG_WARN) ? stderr : stdout;
+    FILE *sink = (level >= TM_LOG_WARN || s_stderr_only) ? stderr : stdout;
     fprintf(sink, "[%s][%s] ", ts, level_label(level));
 
     va_list args;
@@ -37,3 +40,7 @@ void tm_log(TmLogLevel level, const char *fmt, ...) {
 
     fprintf(sink, "\n");
 }
+
+void tm_log_use_stderr(void) {
+    s_stderr_only = true;
+}